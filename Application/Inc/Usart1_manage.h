@@ -6,8 +6,8 @@
 #define SMARTCLOCK_USART1_TASK_H
 #include "main.h"
 #include "RingBuffer.h"
-#define DMA_BUFFER_SIZE 512
-#define RINGBUFFER_SIZE 2048
+/* DMA 循环接收缓冲，同时作为 g_rb_uart1 的存储区（2 的幂） */
+#define DMA_BUFFER_SIZE 2048
 bool MyUart_Init(void) ;
 void process_dma_data(void);
 
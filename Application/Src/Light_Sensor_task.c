@@ -23,8 +23,8 @@ void StartLightSensorTask(void *argument) {
        //char buffer[64];
         //sniprintf(buffer, sizeof(buffer), "当前光敏电阻值为 %u\r\n", (unsigned)LightSensor_Data);
        // HAL_UART_Transmit_DMA(&huart1, (uint8_t *)buffer, sizeof(LightSensor_Data));
-        LOG_D("光敏","当前光敏电阻值为 %u\r\n", (unsigned)LightSensor_Data);
-        LOG_HEX("哈哈",LOG_LEVEL_ERROR,"666@",6);
+        LOG_D(LIGHT, "当前光敏电阻值为 %u\r\n", (unsigned)LightSensor_Data);
+        LOG_HEX(LIGHT, LOG_LEVEL_ERROR,"666@",6);
         osDelay(1000); // 1s 读一次，完全够用
     }
 }
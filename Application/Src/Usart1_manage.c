@@ -17,11 +17,14 @@ RingBuffer g_rb_uart1;
 uint8_t DmaBuffer[DMA_BUFFER_SIZE];
 
 bool MyUart_Init(void) {
-    if (ret_is_err(CreateRingBuffer(&g_rb_uart1, "USART1 RingBuffer", RINGBUFFER_SIZE))) {
+    /* DMA 循环缓冲直接作为 RB 存储区：中断只发布写位置，不再拷贝；
+     * DMA 中断单生产者 + 处理任务单消费者：SPSC 无锁；处理任务阻塞等待数据 */
+    if (ret_is_err(CreateRingBufferStatic(&g_rb_uart1, "USART1 RingBuffer", DmaBuffer,
+                                          DMA_BUFFER_SIZE, RB_FLAG_SPSC | RB_FLAG_WAIT))) {
         printf("环形缓冲区初始化失败");
         return false;
     }
-    LOG_W("heap", "%uKB- %u空间还剩余 %u", MEMORY_POND_MAX_SIZE, RINGBUFFER_SIZE,
+    LOG_W(HEAP, "%uKB- %u空间还剩余 %u", MEMORY_POND_MAX_SIZE, DMA_BUFFER_SIZE,
           query_remain_size());
     HAL_UARTEx_ReceiveToIdle_DMA(&huart1, DmaBuffer, DMA_BUFFER_SIZE);
     printf("环形缓冲区初始化成功 %p\n", &g_rb_uart1);
@@ -29,28 +32,12 @@ bool MyUart_Init(void) {
 }
 
 void process_dma_data(void) {
-    static uint16_t last_pos = 0;
-    // 1、获取当前的位置
-    uint32_t curpos          = DMA_BUFFER_SIZE - __HAL_DMA_GET_COUNTER(&hdma_usart1_rx);
-
-    uint32_t write_size      = curpos - last_pos;           // 没有回返
-    uint32_t write_size2     = DMA_BUFFER_SIZE - last_pos;  // 数据回返需要写入得后面部分得长度
-    // 2、判断数据是否更新
-    if (last_pos == curpos) return;
-
-    // 3、搬运数据到环形缓冲区  //当前数据没有回返
-    if (curpos > last_pos) {
-        if (ret_is_err(WriteRingBuffer(&g_rb_uart1, &DmaBuffer[last_pos], &write_size, 0)))
-            printf("写入失败\n");
-    } else {
-        // 数据回返
-        if (ret_is_err(WriteRingBuffer(&g_rb_uart1, &DmaBuffer[last_pos], &write_size2, 0))) {
-            printf("Write Error of RingBuffer\n");
-        }
-
-        WriteRingBuffer(&g_rb_uart1, &DmaBuffer[0], &curpos, 0);
-    }
-
-    // 4、更新位置
-    last_pos = curpos;
+    // 1、获取当前的位置（DMA 下一次要写的偏移）
+    const uint32_t curpos =
+        (DMA_BUFFER_SIZE - __HAL_DMA_GET_COUNTER(&hdma_usart1_rx)) % DMA_BUFFER_SIZE;
+
+    // 2、数据已由 DMA 写进 RB 存储区，只发布写位置；
+    //    覆盖未读数据时 RB 自己计数，由处理任务 RingBuffer_CheckOverrun 报告并重同步
+    uint32_t delta = 0;
+    (void)RingBuffer_PublishWritePosFromISR(&g_rb_uart1, curpos, &delta);
 }
@@ -292,26 +292,33 @@ void StartTask02(void* argument) {
     char buffer[128];
     /* Infinite loop */
     uint8_t example[] = {0x01, 0x22, 0x33, 0x44, 0x55, 0x66, 0x77, 0x88, 0x99};
+    uint32_t beat    = HAL_GetTick();
     for (;;) {
-        uint32_t read_size = RingBuffer_GetUsedSize(&g_rb_uart1);
-        if (read_size > 0) {
-            if (read_size > 127) read_size = 127;
-            if (ReadRingBuffer(&g_rb_uart1, (uint8_t*)buffer, &read_size, 0)) {
-                buffer[read_size] = '\0';
-                // printf("%s\n", buffer);
-                // HAL_UART_Transmit(&huart3, (const uint8_t *) buffer, strlen((char *) buffer),
-                // HAL_MAX_DELAY);
-            } else {
-                printf("读取失败\n");
-            }
+        /* DMA 覆盖过未读数据：积压已不可信，丢弃后重新同步 */
+        if (RingBuffer_CheckOverrun(&g_rb_uart1)) printf("串口1接收溢出\n");
+
+        /* 阻塞等待串口数据（DMA 中断写入即唤醒），最长等到下一次心跳 */
+        const uint32_t elapsed = HAL_GetTick() - beat;
+        uint32_t read_size     = sizeof(buffer) - 1;
+        const ret_code_t rc    = RingBuffer_ReadWait(&g_rb_uart1, (uint8_t*)buffer, &read_size, 1,
+                                                     (elapsed >= 1000) ? 0 : (1000 - elapsed));
+        if (ret_is_ok(rc)) {
+            buffer[read_size] = '\0';
+            // printf("%s\n", buffer);
+            // HAL_UART_Transmit(&huart3, (const uint8_t *) buffer, strlen((char *) buffer),
+            // HAL_MAX_DELAY);
+        } else if (!ret_is_timeout(rc)) {
+            printf("读取失败\n");
         }
+        if (HAL_GetTick() - beat < 1000) continue;
+        beat = HAL_GetTick();
+
         uint16_t res = 0x00;
         crc16_cal_default_table(MODBUS, example, 1, &res);
         HAL_GPIO_TogglePin(LED0_GPIO_Port, LED0_Pin);
-        LOG_W("CRC16_MODBUS", "{0x01} =%X", res);
+        LOG_W(APP, "{0x01} =%X", res);
         const UBaseType_t watermark = uxTaskGetStackHighWaterMark(NULL);
-        LOG_E("Watermask", "lcdTask high watermark = %lu\r\n", (unsigned long)watermark);
-        osDelay(1000);
+        LOG_E(APP, "lcdTask high watermark = %lu\r\n", (unsigned long)watermark);
     }
     /* USER CODE END StartTask02 */
 }
@@ -329,8 +336,8 @@ void StartTask_LCD(void* argument) {
     char buffer[128];
     osDelay(2000);
     esp01s_Init(&huart3, 1024);
-    LOG_I("StartTask_LCD", "启动完成");
-    LOG_I("111", "启动完成");
+    LOG_I(APP, "启动完成");
+    LOG_I(APP, "启动完成");
     for (;;) {
         sniprintf(buffer, 128, "Time:%lu", HAL_GetTick());
         lcd_show_string(50, 300, 240, 32, 32, buffer, BLACK);
@@ -366,6 +373,8 @@ void HAL_UART_ErrorCallback(UART_HandleTypeDef* huart) {
         // 重启 UART 和 DMA
         HAL_UART_DMAStop(huart);
         MX_USART1_UART_Init();
+        // DMA 将从偏移 0 重新写入 RB 存储区，先同步 RB 写位置
+        (void)RingBuffer_PublishRestartFromISR(&g_rb_uart1);
         HAL_UART_Receive_DMA(huart, DmaBuffer, DMA_BUFFER_SIZE);
     }
 }
@@ -62,19 +62,19 @@
 void keyCallback(KEY_TypedefHandle* key, KEY_ActionType action) {
     switch (action) {
         case KEY_ACTION_SINGLE_CLICK:
-            LOG_I("key1", "单击回调函数触发");
+            LOG_I(KEY, "单击回调函数触发");
             break;
         case KEY_ACTION_DOUBLE_CLICK:
-            LOG_I("key1", "双击回调函数触发");
+            LOG_I(KEY, "双击回调函数触发");
             break;
         case KEY_ACTION_TRIPLE_CLICK:
-            LOG_I("key1", "三击回调函数触发");
+            LOG_I(KEY, "三击回调函数触发");
             break;
         case KEY_ACTION_LONG_PRESS:
-            LOG_I("key1", "长按回调函数触发");
+            LOG_I(KEY, "长按回调函数触发");
             break;
         case KEY_ACTION_LONG_PRESS_REPEAT:
-            LOG_I("key1", "长按1回调函数触发");
+            LOG_I(KEY, "长按1回调函数触发");
             break;
     }
 }
@@ -180,7 +180,7 @@ int main(void) {
     MX_ADC1_Init();
     /* USER CODE BEGIN 2 */
     lcd_init();
-    LOG_E("cu", "ssss");
+    LOG_E(APP, "ssss");
     // bsp_esp8266_Init();
 
     lcd_show_string(10, 40, 240, 32, 32, "STM32", RED);
@@ -4,9 +4,9 @@
 #include "HFSM.h"
 #include "log.h"
 #include "config_cus.h"
-/* 默认 TAG，可以按需改 */
+/* 默认 TAG (须在 log_tags.h 中注册)，可以按需改 */
 #ifndef KEY_LOG_TAG
-#define KEY_LOG_TAG  "KEY"
+#define KEY_LOG_TAG  KEY
 #endif
 
 /**************************************************************************/
@@ -38,10 +38,10 @@
 /* --- 情况二：只有局部开关，无总日志系统 -> 回退到 printf --- */
 #include <stdio.h>
 
-#define KEY_LOGE(fmt, ...)  printf("[E][%s] " fmt "\r\n", KEY_LOG_TAG, ##__VA_ARGS__)
-#define KEY_LOGW(fmt, ...)  printf("[W][%s] " fmt "\r\n", KEY_LOG_TAG, ##__VA_ARGS__)
-#define KEY_LOGI(fmt, ...)  printf("[I][%s] " fmt "\r\n", KEY_LOG_TAG, ##__VA_ARGS__)
-#define KEY_LOGD(fmt, ...)  printf("[D][%s] " fmt "\r\n", KEY_LOG_TAG, ##__VA_ARGS__)
+#define KEY_LOGE(fmt, ...)  printf("[E][%s] " fmt "\r\n", LOG_STR(KEY_LOG_TAG), ##__VA_ARGS__)
+#define KEY_LOGW(fmt, ...)  printf("[W][%s] " fmt "\r\n", LOG_STR(KEY_LOG_TAG), ##__VA_ARGS__)
+#define KEY_LOGI(fmt, ...)  printf("[I][%s] " fmt "\r\n", LOG_STR(KEY_LOG_TAG), ##__VA_ARGS__)
+#define KEY_LOGD(fmt, ...)  printf("[D][%s] " fmt "\r\n", LOG_STR(KEY_LOG_TAG), ##__VA_ARGS__)
 
 #else
 
@@ -8,15 +8,13 @@
 
 #include "AT.h"
 #include "AT_UartMap.h"
-#include "MemoryAllocation.h"
 #include "log.h"
 #include "ret_code.h"
 
 static void AT_OnLine(AT_Manager_t* mgr, const char* line);
 
-AT_Resp_t AT_Wait(AT_Command_t* h, uint32_t wait_ms);
-
-void AT_CmdRelease(AT_Manager_t* mgr, AT_Command_t* h);
+/* 行结束符：'\n' 结束普通行，'>' 是发送数据提示符（后面不跟换行） */
+static const uint8_t s_at_eol[] = {'\n', '>'};
 
 /**
  * @brief 初始化串口设备句柄初始化变量、消息队列、静态对象池
@@ -28,33 +26,36 @@ void AT_Core_Init(AT_Manager_t* at_device, UART_HandleTypeDef* uart, const HW_Se
     /* 1、接收发送命令函数指针 */
     at_device->hw_send = hw_send;
 
-    /* 2、初始化AT管理的 RingBuffer缓冲区 */
-    if (ret_is_err(CreateRingBuffer(&at_device->rx_rb, "at_device", AT_RX_RB_SIZE))) {
-        LOG_E("RingBuffer", "at_device 环形缓冲区初始化失败");
-    }
-    LOG_W("heap", "%uKB- %u空间还剩余 %u", MEMORY_POND_MAX_SIZE, AT_RX_RB_SIZE,
-          query_remain_size());
-
-    if (ret_is_err(
-            CreateRingBuffer(&at_device->msg_len_rb, "at_device.mesg_rx_rb", AT_LEN_RB_SIZE))) {
-        LOG_E("RingBuffer", "at_device.mesg_rx_rb 环形缓冲区初始化失败");
+    /* 2、接收环直接建在 DMA 循环缓冲上：ISR 单生产者（只发布写位置）+ 核心任务单消费者 */
+    if (ret_is_err(CreateRingBufferStatic(&at_device->rx_rb, "at_rx", at_device->dma_rx_arr,
+                                          AT_RX_RB_SIZE, RB_FLAG_SPSC))) {
+        LOG_E(AT, "at_device 接收环初始化失败");
     }
-    LOG_W("heap", "%uKB- %u空间还剩余 %u", MEMORY_POND_MAX_SIZE, AT_LEN_RB_SIZE,
-          query_remain_size());
     /* 3、初始化 HFSM 为空闲状态*/
 
     /* 4、初始化变量 */
-    at_device->line_idx            = 0;
-    at_device->isr_line_len        = 0;
-    at_device->last_pos            = 0;
+    at_device->rx_scan             = 0;
+    at_device->rx_discard          = false;
+    at_device->rx_notified         = 0;
     at_device->curr_cmd            = NULL;
     at_device->urc_cb              = NULL;
     at_device->urc_user            = NULL;
+    at_device->urc_cnt             = 0;
+    at_device->bin_cnt             = 0;
+    at_device->bin_total           = 0;
+    at_device->bin_off             = 0;
     at_device->uart                = uart;
     at_device->fsm.customizeHandle = at_device;
     at_device->fsm.fsm_name        = "fsm";
+#if AT_RX_ISR_PROFILE
+    at_device->rx_isr_cycles = 0;
+    at_device->rx_isr_bytes  = 0;
+    at_device->rx_isr_calls  = 0;
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+#endif
     /* 有需求重新实现状态机 */
-    LOG_I("AT", "Bind UART=%p Instance=%p", uart, uart->Instance);
+    LOG_I(AT, "Bind UART=%p Instance=%p", uart, uart->Instance);
 
     /* 5、RTOS 裸机环境分开处理 */
 #if AT_RTOS_ENABLE
@@ -65,7 +66,7 @@ void AT_Core_Init(AT_Manager_t* at_device, UART_HandleTypeDef* uart, const HW_Se
     OSAL_sem_create(&at_device->tx_done_sem, "ATDone", 0,
                     1);  // 初值0：等回调释放
     if (!at_device->tx_done_sem) {
-        LOG_E("AT", "tx_done_sem create failed");
+        LOG_E(AT, "tx_done_sem create failed");
     }
 #endif
 
@@ -80,13 +81,19 @@ void AT_Core_Init(AT_Manager_t* at_device, UART_HandleTypeDef* uart, const HW_Se
     /*  创建队列（元素是 AT_Command_t*）*/
     OSAL_msgq_create(&at_device->cmd_q, "AT_CMD_Q", sizeof(AT_Command_t*), AT_MAX_PENDING);
     if (!at_device->cmd_q) {
-        LOG_E("AT", "cmd_q create failed");
+        LOG_E(AT, "cmd_q create failed");
     }
 
     /*  创建池互斥（保护 alloc/free） */
     OSAL_mutex_create(&at_device->pool_mutex, "ATPool", true, true);
     if (!at_device->pool_mutex) {
-        LOG_E("AT", "pool_mutex create failed");
+        LOG_E(AT, "pool_mutex create failed");
+    }
+
+    /*  创建 URC 表互斥（注册与查表） */
+    OSAL_mutex_create(&at_device->urc_mutex, "ATUrc", false, true);
+    if (!at_device->urc_mutex) {
+        LOG_E(AT, "urc_mutex create failed");
     }
 
     /*  初始化 free 栈 + 预创建每个命令的 done_sem */
@@ -98,22 +105,22 @@ void AT_Core_Init(AT_Manager_t* at_device, UART_HandleTypeDef* uart, const HW_Se
 
         OSAL_sem_create(&at_device->cmd_pool[i].done_sem, "ATDone", 0, 1);
         if (!at_device->cmd_pool[i].done_sem) {
-            LOG_E("AT", "done_sem create failed idx=%u", i);
+            LOG_E(AT, "done_sem create failed idx=%u", i);
         }
 
         at_device->free_stack[at_device->free_top++] = i;
     }
 
     /* 3、开启串口DMA接收 */
-    HAL_UARTEx_ReceiveToIdle_DMA(uart, at_device->dma_rx_arr, AT_DMA_BUF_SIZE);
+    HAL_UARTEx_ReceiveToIdle_DMA(uart, at_device->dma_rx_arr, AT_RX_RB_SIZE);
 #else
     /* 裸机模式：简单复位标志位 */
 
     at_device->is_locked = false;
     /* 、开启串口DMA接收 */
-    HAL_UARTEx_ReceiveToIdle_DMA(uart, at_device->dma_rx_arr, AT_DMA_BUF_SIZE);
+    HAL_UARTEx_ReceiveToIdle_DMA(uart, at_device->dma_rx_arr, AT_RX_RB_SIZE);
 #endif
-    LOG_D("AT", "INIT at=%p core_task=%p\r\n", at_device, at_device->core_task);
+    LOG_D(AT, "INIT at=%p core_task=%p\r\n", at_device, at_device->core_task);
 }
 
 /**
@@ -121,164 +128,248 @@ void AT_Core_Init(AT_Manager_t* at_device, UART_HandleTypeDef* uart, const HW_Se
  * @param at_manager
  * @param huart 串口句柄
  * @param Size  这次新增数据
- * @note  DMA + circle模式
+ * @note  DMA + circle模式；数据已由 DMA 写进接收环存储区，这里只发布写位置并通知任务，
+ *        开销与字节数无关。拆行在 AT_Core_Process 中完成
+ * @note  任务还没开始处理上一次通知时（突发期间的半满/全满/IDLE 连发）不再重复置标志
  */
 void AT_Core_RxCallback(AT_Manager_t* at_manager, const UART_HandleTypeDef* huart, uint16_t Size) {
     (void)Size;
-    bool has_line = false;
-    bool stop     = false;
     /* 0. 句柄检查 */
     if (huart->Instance != at_manager->uart->Instance) return;
+#if AT_RX_ISR_PROFILE
+    const uint32_t cyc0 = DWT->CYCCNT;
+#endif
 
-    /* 1. 计算 DMA 接收的数据量和位置 */
-    /* 当前索引位置 */
-    const uint16_t cur_pos = AT_DMA_BUF_SIZE - __HAL_DMA_GET_COUNTER(huart->hdmarx);
+    /* 1. DMA 下一次要写的偏移 */
+    const uint32_t cur_pos = (AT_RX_RB_SIZE - __HAL_DMA_GET_COUNTER(huart->hdmarx)) % AT_RX_RB_SIZE;
+
+    /* 2. 发布写位置；覆盖了未读数据时由核心任务重同步 */
+    uint32_t delta = 0;
+    (void)RingBuffer_PublishWritePosFromISR(&at_manager->rx_rb, cur_pos, &delta);
+
+    /* 3. 通知任务（上一次通知未被处理时省掉这次 RTOS 调用） */
+    if (delta > 0u && !at_manager->rx_notified && at_manager->core_task) {
+        at_manager->rx_notified = 1;
+        if (ret_is_err(OSAL_thread_flags_set(at_manager->core_task, AT_FLAG_RX))) {
+            at_manager->rx_notified = 0;
+        }
+    }
+#if AT_RX_ISR_PROFILE
+    at_manager->rx_isr_cycles += DWT->CYCCNT - cyc0;
+    at_manager->rx_isr_bytes += delta;
+    at_manager->rx_isr_calls++;
+#endif
+}
 
-    /* 为空没有触发*/
-    if (cur_pos == at_manager->last_pos) return;
-    if (cur_pos > AT_DMA_BUF_SIZE) {
-        LOG_E("AT", "DMA异常");
+#if AT_RX_ISR_PROFILE
+/**
+ * @brief 输出接收中断的 DWT 统计并清零（任务上下文调用）
+ * @param at_manager AT管理句柄
+ * @note  每 KB 周期数 = rx_isr_cycles * 1024 / rx_isr_bytes；新旧实现在同一负载下各取一次对比
+ */
+void AT_RxIsrProfileReport(AT_Manager_t* at_manager) {
+    osal_crit_state_t state;
+    OSAL_enter_critical_ex(&state);
+    const uint32_t cycles     = at_manager->rx_isr_cycles;
+    const uint32_t bytes      = at_manager->rx_isr_bytes;
+    const uint32_t calls      = at_manager->rx_isr_calls;
+    at_manager->rx_isr_cycles = 0;
+    at_manager->rx_isr_bytes  = 0;
+    at_manager->rx_isr_calls  = 0;
+    OSAL_exit_critical_ex(state);
+
+    if (bytes == 0u || calls == 0u) return;
+    LOG_I(AT, "rx isr: %lu B %lu 次 %lu 周期/次 %lu 周期/KB", (unsigned long)bytes,
+          (unsigned long)calls, (unsigned long)(cycles / calls),
+          (unsigned long)(((uint64_t)cycles * 1024u) / bytes));
+}
+#endif
+
+/**
+ * @brief 从接收环读出一行交给状态机
+ * @param mgr AT设备句柄
+ * @param len 行长度（含行结束符）
+ * @note  超过 line_buf 的部分丢弃，行仍按截断后的内容交付
+ */
+static void AT_DeliverLine(AT_Manager_t* mgr, const uint32_t len) {
+    uint32_t n = (len < AT_LINE_MAX_LEN - 1u) ? len : (AT_LINE_MAX_LEN - 1u);
+    if (ret_is_err(ReadRingBuffer(&mgr->rx_rb, mgr->line_buf, &n, 0))) {
+        LOG_E(AT, "行读失败！len=%u", (unsigned)len);
         return;
     }
+    if (n < len) {
+        LOG_E(AT, "数据帧过长已截断 (can=%u fact=%u)", AT_LINE_MAX_LEN - 1, (unsigned)len);
+        uint32_t dropped = 0;
+        (void)RingBuffer_Drop(&mgr->rx_rb, len - n, &dropped, false);
+    }
 
-    /* 新增长度 */
-    uint16_t raw_len;
-    /* 传输开始索引位置 */
-    uint16_t start_index;
+    /* 加上结束符后交给状态机 */
+    mgr->line_buf[n] = '\0';
+    AT_OnLine(mgr, (const char*)mgr->line_buf);
+    /* 打印返回数据 */
+    LOG_W(AT, "RX: %s", mgr->line_buf);
+}
 
-    // 计算本次接收数据的长度和起始索引
-    if (cur_pos > at_manager->last_pos) {
-        raw_len     = cur_pos - at_manager->last_pos;
-        start_index = at_manager->last_pos;
-    } else {
-        raw_len     = AT_DMA_BUF_SIZE - at_manager->last_pos;
-        start_index = at_manager->last_pos;
-    }
-
-    /* 2. 准备变量 */
-
-    /* [静态变量] 记录当前行已接收的字节数 (跨中断保持) */
-
-    /*  WriteRingBufferFromISR 需要传入指针，这里准备好 */
-    uint32_t write_size_one = 1;
-
-    /* 定义一个宏来处理单个字节逻辑，避免回卷代码重复 */
-#define AT_HANDLE_BYTE(b)                                                                            \
-    do {                                                                                             \
-        /* 尝试写入 数据 RingBuffer */                                                               \
-        write_size_one = 1;                                                                          \
-        if (ret_is_ok(WriteRingBufferFromISR(&at_manager->rx_rb, &(b), &write_size_one, 0))) {       \
-            /* 只有写入成功才统计长度，防止 Buffer 满导致逻辑错位 */                                 \
-            ++(at_manager->isr_line_len);                                                            \
-                                                                                                     \
-            /* 检测结束符 \n 或 > */                                                                 \
-            if ((b) == '\n' || (b) == '>') {                                                         \
-                /* 将当前行的长度 (uint16_t) 存入 长度 RingBuffer */                                 \
-                uint16_t len_val         = at_manager->isr_line_len;                                 \
-                uint32_t len_size        = sizeof(uint16_t);                                         \
-                /* 把 &len_val 强转为 uint8_t* 写入 2 个字节 */                                      \
-                ret_code_t ok_len        = WriteRingBufferFromISR(&at_manager->msg_len_rb,           \
-                                                                  (uint8_t*)&len_val, &len_size, 0); \
-                at_manager->isr_line_len = 0;                                                        \
-                /* 溢出 */                                                                           \
-                if ((ret_is_err(ok_len))) {                                                          \
-                    at_manager->rx_overflow = 1;                                                     \
-                    stop                    = true;                                                  \
-                } else {                                                                             \
-                    has_line = true;                                                                 \
-                }                                                                                    \
-            }                                                                                        \
-        }                                                                                            \
-    } while (0)
-
-    /* 3. 第一段循环处理 */
-    for (uint16_t i = 0; i < raw_len; i++) {
-        uint8_t byte = at_manager->dma_rx_arr[start_index + i];
-        AT_HANDLE_BYTE(byte);
-        if (stop) break;
-    }
-
-    /* 4. 第二段循环处理 (处理 DMA 回卷情况: buffer尾 -> buffer头) */
-    if (cur_pos < at_manager->last_pos) {
-        for (uint16_t i = 0; i < cur_pos; i++) {
-            uint8_t byte = at_manager->dma_rx_arr[i];
-            AT_HANDLE_BYTE(byte);
-            if (stop) break;
+/* 行首二进制头检查结果 */
+typedef enum {
+    AT_BIN_NONE = 0, /* 不是二进制头，按普通行处理 */
+    AT_BIN_WAIT,     /* 前缀已命中但头部还没收全，等后续数据 */
+    AT_BIN_ENTER,    /* 头部已消费，进入二进制模式 */
+} AT_BinState_t;
+
+/**
+ * @brief 检查接收环开头是否为已注册的二进制头，是则消费头部并进入二进制模式
+ * @param mgr AT设备句柄
+ * @return 检查结果
+ * @note  头部到第一个引号外的 ':' 为止（引号内可能是 IPv6 地址）；先遇到 '\n' 说明是普通行
+ */
+static AT_BinState_t AT_BinTryEnter(AT_Manager_t* mgr) {
+    RingBuffer* rb = &mgr->rx_rb;
+    char head[AT_URC_PREFIX_MAX];
+    uint32_t n = AT_URC_PREFIX_MAX - 1u;
+    if (ret_is_err(PeekRingBuffer(rb, (uint8_t*)head, &n, 1)) || n == 0) return AT_BIN_NONE;
+
+    /* 1、前缀匹配（取最长），回调信息拷贝出来后解锁 */
+    AT_BinEntry_t hit = {0};
+#if AT_RTOS_ENABLE
+    if (mgr->urc_mutex) OSAL_mutex_lock(mgr->urc_mutex, OSAL_WAIT_FOREVER);
+#endif
+    for (uint8_t i = 0; i < mgr->bin_cnt; i++) {
+        const AT_BinEntry_t* e = &mgr->bin_tab[i];
+        if (e->len <= n && e->len > hit.len && memcmp(head, e->prefix, e->len) == 0) hit = *e;
+    }
+#if AT_RTOS_ENABLE
+    if (mgr->urc_mutex) OSAL_mutex_unlock(mgr->urc_mutex);
+#endif
+    if (hit.len == 0) return AT_BIN_NONE;
+
+    /* 2、找头部结尾 */
+    uint32_t avail = AT_LINE_MAX_LEN - 1u;
+    (void)PeekRingBuffer(rb, mgr->line_buf, &avail, 1);
+    uint32_t hlen = 0;
+    bool in_quote = false;
+    for (uint32_t i = hit.len; i < avail; i++) {
+        const uint8_t b = mgr->line_buf[i];
+        if (b == '"') in_quote = !in_quote;
+        if (b == '\n') return AT_BIN_NONE;
+        if (b == ':' && !in_quote) {
+            hlen = i + 1u;
+            break;
         }
     }
+    if (hlen == 0) return (avail >= AT_LINE_MAX_LEN - 1u) ? AT_BIN_NONE : AT_BIN_WAIT;
+
+    /* 3、解析长度；格式不符按普通行处理 */
+    mgr->line_buf[hlen] = '\0';
+    uint32_t total      = 0;
+    if (!hit.len_fn || !hit.len_fn((const char*)mgr->line_buf, &total)) {
+        LOG_E(AT, "二进制头解析失败: %s", mgr->line_buf);
+        return AT_BIN_NONE;
+    }
 
-    /* 5. 更新位置 */
-    at_manager->last_pos = cur_pos;
+    /* 4、消费头部，切换到二进制模式（头部文本留在 line_buf 供回调使用） */
+    uint32_t dropped = 0;
+    (void)RingBuffer_Drop(rb, hlen, &dropped, false);
+    mgr->bin_cur   = hit;
+    mgr->bin_total = total;
+    mgr->bin_off   = 0;
+    mgr->rx_scan   = 0;
+    LOG_D(AT, "BIN %s len=%u", mgr->line_buf, (unsigned)total);
+    return AT_BIN_ENTER;
+}
 
-    /* 6. 通知任务 */
-    if (has_line && at_manager->core_task) {
-        OSAL_thread_flags_set(at_manager->core_task, AT_FLAG_RX);
+/**
+ * @brief 二进制模式：把已到达的负载以零拷贝视图交给回调
+ * @param mgr AT设备句柄
+ * @return 没有新数据返回 false
+ */
+static bool AT_BinFeed(AT_Manager_t* mgr) {
+    AT_BinChunk_t chunk;
+    uint32_t granted    = 0;
+    const uint32_t want = mgr->bin_total - mgr->bin_off;
+    if (ret_is_err(RingBuffer_ReadReserve(&mgr->rx_rb, want, &chunk.span, &granted, true)) ||
+        granted == 0) {
+        return false;
     }
+    chunk.hdr   = (const char*)mgr->line_buf;
+    chunk.off   = mgr->bin_off;
+    chunk.total = mgr->bin_total;
+    mgr->bin_cur.cb(mgr, &chunk, mgr->bin_cur.user);
+
+    (void)RingBuffer_ReadCommit(&mgr->rx_rb, granted);
+    mgr->bin_off += granted;
+    return true;
 }
 
 /**
  * @brief 对串口接收的数据进行处理
  * @param at_manager AT管理句柄
+ * @note  一次唤醒处理全部积压：按 32 位字批量查找行结束符，逐行读出；
+ *        未结束的半行留在接收环里，下次从 rx_scan 继续查找。
+ *        行首命中已注册的二进制头时切换到按长度接收，负载交付完回到行模式
  */
 void AT_Core_Process(AT_Manager_t* at_manager) {
-    /* 处理写入失败 */
-    if (at_manager->rx_overflow) {
-        at_manager->rx_overflow = 0;
-        ResetRingBuffer(&at_manager->msg_len_rb);
-        ResetRingBuffer(&at_manager->rx_rb);
-        at_manager->isr_line_len = 0;
-        LOG_E("AT", "RB缓冲区写入失败");
-    }
-    /* 1、判断是否有一句完整的数据帧 */
-    while (RingBuffer_GetUsedSize(&at_manager->msg_len_rb) >= sizeof(uint16_t)) {
-        /* 2、 读取数据 */
-        uint32_t size = sizeof(uint16_t);
-        uint8_t len_size_t[2];
-
-        /* 3、判读当前行的字节数 是否大于最大可读数 */
-        if (ret_is_err(ReadRingBuffer(&at_manager->msg_len_rb, len_size_t, &size, 0))) {
-            LOG_E("AT", "行读失败！");
-            break;
+    RingBuffer* rb   = &at_manager->rx_rb;
+    uint32_t dropped = 0;
+
+    /* 先清通知标志再读接收环：此后发布的数据由中断重新通知，不会漏处理 */
+    at_manager->rx_notified = 0;
+    __DMB();
+
+    /* 处理覆盖：积压里混有被 DMA 改写的字节，已整体丢弃，从下一行重新开始 */
+    if (RingBuffer_CheckOverrun(rb)) {
+        at_manager->rx_scan    = 0;
+        at_manager->rx_discard = true;
+        if (at_manager->bin_off < at_manager->bin_total) {
+            LOG_E(AT, "二进制负载被覆盖，已交付 %u/%u", (unsigned)at_manager->bin_off,
+                  (unsigned)at_manager->bin_total);
+            at_manager->bin_total = 0;
+            at_manager->bin_off   = 0;
         }
-        if (size != sizeof(uint16_t)) {
-            LOG_E("AT", "size被异常修改");
-            break;
-        }
-
-        /* 4、当前行的长度 */
-        const uint16_t frame_len = (uint16_t)len_size_t[0] | ((uint16_t)len_size_t[1] << 8);
+        LOG_E(AT, "接收环被 DMA 覆盖，丢弃积压数据");
+    }
 
-        /* 限制最大读取数 */
-        uint16_t actual          = frame_len;
-        if (actual > (AT_LINE_MAX_LEN - 1)) {
-            actual = (AT_LINE_MAX_LEN - 1);
+    for (;;) {
+        /* 0、二进制模式：按长度原样交付，不看行结束符 */
+        if (at_manager->bin_off < at_manager->bin_total) {
+            if (!AT_BinFeed(at_manager)) break;
+            continue;
         }
-
-        /* 5、读取数据帧 */
-        uint32_t to_read    = actual;
-        const ret_code_t rc = ReadRingBuffer(&at_manager->rx_rb, at_manager->line_buf, &to_read, 0);
-        if (ret_is_err(rc) || (to_read != actual)) {
-            LOG_E("AT", "数据帧读取失败/不同步 (need=%u got=%u rc=%d)", actual, to_read, (int)rc);
-            break; /* 待实现重置策略 */
+        if (at_manager->bin_cnt && !at_manager->rx_discard) {
+            const AT_BinState_t st = AT_BinTryEnter(at_manager);
+            if (st == AT_BIN_WAIT) break;
+            if (st == AT_BIN_ENTER) continue;
         }
 
-        /*６、判断数据帧是否完整 丢弃无法读取的*/
-        if (frame_len > actual) {
-            LOG_E("AT", "数据帧过长尝试丢弃数据 (can=%u fact=%u)", actual, frame_len);
-            const uint16_t drop = frame_len - actual;
-            uint32_t dropped    = 0;
-            if (ret_is_err(RingBuffer_Drop(&at_manager->rx_rb, drop, &dropped, 0))) {
-                LOG_E("AT", "超长帧丢弃失败，数据可能已不同步");
+        /* 1、从上次扫到的位置继续找行结束符 */
+        uint32_t eol        = 0;
+        const ret_code_t rc = RingBuffer_FindAny(rb, s_at_eol, sizeof(s_at_eol),
+                                                 at_manager->rx_scan, &eol);
+        if (!ret_is_ok(rc)) {
+            const uint32_t used = RingBuffer_GetUsedSize(rb);
+            at_manager->rx_scan = used;
+            /* 2、半行已经放不下 line_buf：先截断交付，剩余部分丢到行尾 */
+            if (used >= AT_LINE_MAX_LEN - 1u) {
+                if (at_manager->rx_discard) {
+                    (void)RingBuffer_Drop(rb, used, &dropped, false);
+                } else {
+                    AT_DeliverLine(at_manager, used);
+                    at_manager->rx_discard = true;
+                }
+                at_manager->rx_scan = 0;
             }
+            break;
         }
 
-        /* 7、加上结束符 */
-        at_manager->line_buf[actual] = '\0';
-
-        /* 8、开始状态机处理 */
-        AT_OnLine(at_manager, (const char*)at_manager->line_buf);
-        /* 打印返回数据 */
-        LOG_W("AT", "RX: %s", at_manager->line_buf);
+        /* 3、[0, eol] 为完整一行 */
+        const uint32_t len  = eol + 1u;
+        at_manager->rx_scan = 0;
+        if (at_manager->rx_discard) {
+            (void)RingBuffer_Drop(rb, len, &dropped, false);
+            at_manager->rx_discard = false;
+            continue;
+        }
+        AT_DeliverLine(at_manager, len);
     }
 }
 
@@ -304,6 +395,319 @@ AT_Resp_t AT_SendCmd(AT_Manager_t* mgr, const char* cmd, const char* expect, uin
 #endif
 }
 
+/**
+ * @brief 一次扫描行首判断是否为终止结果码
+ * @param line 接收到的一行
+ * @return 行的分类
+ * @note  只比较行首固定几个字节，不做整行子串查找
+ */
+AT_LineKind_t AT_ClassifyLine(const char* line) {
+    switch (line[0]) {
+        case 'O':
+            /* "OK" 后只能是行尾，排除 "OKxxx" 之类的普通行 */
+            if (line[1] == 'K' && (line[2] == '\r' || line[2] == '\n' || line[2] == '\0')) {
+                return AT_LINE_OK;
+            }
+            break;
+        case 'E':
+            if (strncmp(line, "ERROR", 5) == 0) return AT_LINE_ERROR;
+            break;
+        case '+':
+            /* "+CME ERROR: n" / "+CMS ERROR: n" */
+            if (line[1] == 'C' && line[2] == 'M' && (line[3] == 'E' || line[3] == 'S') &&
+                strncmp(&line[4], " ERROR", 6) == 0) {
+                return AT_LINE_ERROR;
+            }
+            break;
+        case 'S':
+            if (strncmp(line, "SEND FAIL", 9) == 0) return AT_LINE_ERROR;
+            break;
+        case 'b':
+            if (strncmp(line, "busy ", 5) == 0 && (line[5] == 'p' || line[5] == 's')) {
+                return AT_LINE_BUSY;
+            }
+            break;
+        default:
+            break;
+    }
+    return AT_LINE_OTHER;
+}
+
+/**
+ * @brief 重新计算 URC 表每个条目的 parent（调用方持有 urc_mutex）
+ * @param mgr AT设备句柄
+ * @note  表已按字典序排列：某条目的真前缀都排在它前面，向前找到的第一个就是最长的
+ */
+static void AT_UrcRebuild(AT_Manager_t* mgr) {
+    for (int8_t i = 0; i < (int8_t)mgr->urc_cnt; i++) {
+        AT_UrcEntry_t* e = &mgr->urc_tab[i];
+        e->parent        = -1;
+        for (int8_t j = (int8_t)(i - 1); j >= 0; j--) {
+            const AT_UrcEntry_t* p = &mgr->urc_tab[j];
+            if (p->len < e->len && strncmp(e->prefix, p->prefix, p->len) == 0) {
+                e->parent = j;
+                break;
+            }
+        }
+    }
+}
+
+/**
+ * @brief 按行首前缀注册 URC 回调
+ * @param mgr AT设备句柄
+ * @param prefix 行首前缀，如 "+IPD"（长度 1..AT_URC_PREFIX_MAX-1）
+ * @param cb 命中后的回调；NULL 表示注销该前缀
+ * @param user 传递的上下文
+ * @return 表满返回 RET_E_NO_MEM，注销不存在的前缀返回 RET_E_NOT_FOUND
+ */
+ret_code_t AT_RegisterUrc(AT_Manager_t* mgr, const char* prefix, const AT_UrcCb cb, void* user) {
+    if (!mgr || !prefix) return RET_E_INVALID_ARG;
+    const size_t len = strlen(prefix);
+    if (len == 0 || len >= AT_URC_PREFIX_MAX) return RET_E_INVALID_ARG;
+
+#if AT_RTOS_ENABLE
+    if (mgr->urc_mutex) OSAL_mutex_lock(mgr->urc_mutex, OSAL_WAIT_FOREVER);
+#endif
+    /* 1、二分查找插入位置（第一个 >= prefix 的条目） */
+    uint8_t lo = 0;
+    uint8_t hi = mgr->urc_cnt;
+    while (lo < hi) {
+        const uint8_t mid = (uint8_t)((lo + hi) / 2u);
+        if (strcmp(mgr->urc_tab[mid].prefix, prefix) < 0) {
+            lo = (uint8_t)(mid + 1u);
+        } else {
+            hi = mid;
+        }
+    }
+    AT_UrcEntry_t* e  = &mgr->urc_tab[lo];
+    const bool exists = (lo < mgr->urc_cnt) && (strcmp(e->prefix, prefix) == 0);
+    const size_t tail = (size_t)(mgr->urc_cnt - lo) * sizeof(AT_UrcEntry_t);
+    ret_code_t rc     = RET_OK;
+
+    if (exists && cb) {
+        /* 2、已存在：只替换回调 */
+        e->cb   = cb;
+        e->user = user;
+    } else if (exists) {
+        /* 3、注销：后面的条目前移 */
+        memmove(e, e + 1, tail - sizeof(AT_UrcEntry_t));
+        mgr->urc_cnt--;
+        AT_UrcRebuild(mgr);
+    } else if (!cb) {
+        rc = RET_E_NOT_FOUND;
+    } else if (mgr->urc_cnt >= AT_URC_MAX) {
+        rc = RET_E_NO_MEM;
+    } else {
+        /* 4、新增：后面的条目后移腾出位置 */
+        memmove(e + 1, e, tail);
+        memcpy(e->prefix, prefix, len + 1u);
+        e->len  = (uint8_t)len;
+        e->cb   = cb;
+        e->user = user;
+        mgr->urc_cnt++;
+        AT_UrcRebuild(mgr);
+    }
+#if AT_RTOS_ENABLE
+    if (mgr->urc_mutex) OSAL_mutex_unlock(mgr->urc_mutex);
+#endif
+    return rc;
+}
+
+/**
+ * @brief 注册二进制头：行首命中 prefix 后切换为按长度接收，负载原样分段交给 cb
+ * @param mgr AT设备句柄
+ * @param prefix 头部前缀，如 "+IPD"（长度 1..AT_URC_PREFIX_MAX-1）
+ * @param len_fn 头部解析函数
+ * @param cb 负载回调；NULL 表示注销该前缀
+ * @param user 传递的上下文
+ * @return 表满返回 RET_E_NO_MEM，注销不存在的前缀返回 RET_E_NOT_FOUND
+ */
+ret_code_t AT_RegisterBinary(AT_Manager_t* mgr, const char* prefix, const AT_BinLenFn len_fn,
+                             const AT_BinCb cb, void* user) {
+    if (!mgr || !prefix || (cb && !len_fn)) return RET_E_INVALID_ARG;
+    const size_t len = strlen(prefix);
+    if (len == 0 || len >= AT_URC_PREFIX_MAX) return RET_E_INVALID_ARG;
+
+#if AT_RTOS_ENABLE
+    if (mgr->urc_mutex) OSAL_mutex_lock(mgr->urc_mutex, OSAL_WAIT_FOREVER);
+#endif
+    /* 表很小（AT_BIN_MAX），线性查找即可 */
+    uint8_t i = 0;
+    while (i < mgr->bin_cnt && strcmp(mgr->bin_tab[i].prefix, prefix) != 0) i++;
+
+    ret_code_t rc = RET_OK;
+    if (!cb) {
+        /* 注销：最后一项补到空位 */
+        if (i < mgr->bin_cnt) {
+            mgr->bin_tab[i] = mgr->bin_tab[--mgr->bin_cnt];
+        } else {
+            rc = RET_E_NOT_FOUND;
+        }
+    } else if (i == mgr->bin_cnt && mgr->bin_cnt >= AT_BIN_MAX) {
+        rc = RET_E_NO_MEM;
+    } else {
+        AT_BinEntry_t* e = &mgr->bin_tab[i];
+        memcpy(e->prefix, prefix, len + 1u);
+        e->len    = (uint8_t)len;
+        e->len_fn = len_fn;
+        e->cb     = cb;
+        e->user   = user;
+        if (i == mgr->bin_cnt) mgr->bin_cnt++;
+    }
+#if AT_RTOS_ENABLE
+    if (mgr->urc_mutex) OSAL_mutex_unlock(mgr->urc_mutex);
+#endif
+    return rc;
+}
+
+/**
+ * @brief 解析 ESP-AT 的 "+IPD,[<link>,]<len>[,"<ip>",<port>]:" 头部
+ * @param hdr 头部文本
+ * @param len 负载长度
+ * @return 格式不符返回 false
+ * @note  开头连续的纯数字字段只有一个时是 <len>，两个时是 <link>,<len>；
+ *        后面的地址字段含 '.' 或引号，不会被当成数字
+ */
+bool AT_ParseIpdLen(const char* hdr, uint32_t* len) {
+    if (!hdr || !len || strncmp(hdr, "+IPD,", 5) != 0) return false;
+
+    uint32_t num[2] = {0};
+    uint8_t cnt     = 0;
+    const char* p   = hdr + 5;
+    while (cnt < 2u) {
+        const char* q = p;
+        uint32_t v    = 0;
+        /* 最多 9 位，避免 32 位溢出 */
+        while (*q >= '0' && *q <= '9' && (q - p) < 9) {
+            v = v * 10u + (uint32_t)(*q - '0');
+            q++;
+        }
+        if (q == p || (*q != ',' && *q != ':')) break;
+        num[cnt++] = v;
+        if (*q == ':') break;
+        p = q + 1;
+    }
+    if (cnt == 0) return false;
+    *len = num[cnt - 1u];
+    return true;
+}
+
+/**
+ * @brief 在 URC 表中查找行首最长匹配的前缀
+ * @param mgr AT设备句柄
+ * @param line 接收到的一行
+ * @param hit 命中条目的拷贝（回调在解锁后调用）
+ * @return 是否命中
+ * @note  二分定位最后一个 <= line 的条目：能匹配 line 的前缀都是它的前缀，沿 parent 回退即可
+ */
+static bool AT_UrcLookup(AT_Manager_t* mgr, const char* line, AT_UrcEntry_t* hit) {
+    bool found = false;
+#if AT_RTOS_ENABLE
+    if (mgr->urc_mutex) OSAL_mutex_lock(mgr->urc_mutex, OSAL_WAIT_FOREVER);
+#endif
+    uint8_t lo = 0;
+    uint8_t hi = mgr->urc_cnt;
+    while (lo < hi) {
+        const uint8_t mid = (uint8_t)((lo + hi) / 2u);
+        if (strcmp(mgr->urc_tab[mid].prefix, line) <= 0) {
+            lo = (uint8_t)(mid + 1u);
+        } else {
+            hi = mid;
+        }
+    }
+    for (int8_t i = (int8_t)(lo - 1); i >= 0; i = mgr->urc_tab[i].parent) {
+        const AT_UrcEntry_t* e = &mgr->urc_tab[i];
+        if (strncmp(line, e->prefix, e->len) == 0) {
+            *hit  = *e;
+            found = true;
+            break;
+        }
+    }
+#if AT_RTOS_ENABLE
+    if (mgr->urc_mutex) OSAL_mutex_unlock(mgr->urc_mutex);
+#endif
+    return found;
+}
+
+/**
+ * @brief 释放当前命令的负载（调用 tx_done，之后不再引用负载缓冲区）
+ * @param mgr AT设备句柄
+ * @param c 命令对象
+ * @param sent 负载是否已全部发出
+ */
+static void AT_PayloadRelease(AT_Manager_t* mgr, AT_Command_t* c, const bool sent) {
+    const AT_TxDoneCb done = c->tx_done;
+    c->phase               = AT_PHASE_RESP;
+    c->tx_done             = NULL;
+    if (done) done(mgr, c, sent, c->tx_user);
+}
+
+/**
+ * @brief 结束当前活动命令（核心任务上下文）
+ * @param mgr AT设备句柄
+ * @param result 命令结果
+ * @note  负载还没释放时先停止发送并调用 tx_done，再唤醒等待者、推进下一条命令
+ */
+void AT_CmdFinish(AT_Manager_t* mgr, const AT_Resp_t result) {
+    AT_Command_t* c = mgr->curr_cmd;
+    if (!c) return;
+
+    if (c->phase != AT_PHASE_RESP) {
+#if AT_RTOS_ENABLE
+        /* DMA 还在读负载：先停下来，回调之后缓冲区才能交还给调用者 */
+        if (c->phase == AT_PHASE_PAYLOAD && mgr->tx_busy) {
+            (void)HAL_UART_AbortTransmit(mgr->uart);
+            mgr->tx_busy = 0;
+        }
+#endif
+        AT_PayloadRelease(mgr, c, false);
+    }
+
+    c->result     = result;
+    mgr->curr_cmd = NULL;
+    OSAL_sem_give(c->done_sem);
+    // 触发发送下一条
+    if (mgr->core_task) OSAL_thread_flags_set(mgr->core_task, AT_FLAG_TX);
+}
+
+/**
+ * @brief 推进当前命令的负载发送（核心任务上下文，收到 TXDONE 后调用）
+ * @param mgr AT设备句柄
+ * @note  各段直接从调用者的缓冲区交给 hw_send，不拷贝；DMA 发送时每段等 TXDONE 再发下一段，
+ *        单段超过 hw_send 的 16 位长度时分片
+ */
+void AT_PayloadPump(AT_Manager_t* mgr) {
+    AT_Command_t* c = mgr->curr_cmd;
+    if (!c || c->phase != AT_PHASE_PAYLOAD) return;
+#if AT_RTOS_ENABLE
+    if (mgr->tx_busy) return; /* 上一段还在发 */
+#endif
+
+    while (c->seg_idx < c->seg_cnt) {
+        const RingBufferConstVec* v = &c->segs[c->seg_idx];
+        const uint32_t left         = v->len - c->seg_off;
+        if (left == 0) {
+            c->seg_idx++;
+            c->seg_off = 0;
+            continue;
+        }
+
+        const uint16_t n = (left > 0xFFFFu) ? 0xFFFFu : (uint16_t)left;
+        if (!mgr->hw_send || !mgr->hw_send(mgr, v->ptr + c->seg_off, n)) {
+            LOG_E(AT, "负载发送失败 seg=%u off=%u", c->seg_idx, (unsigned)c->seg_off);
+            AT_CmdFinish(mgr, AT_RESP_ERROR);
+            return;
+        }
+        c->seg_off += n;
+#if AT_RTOS_ENABLE
+        if (mgr->tx_busy) return; /* DMA 已启动：等 TXDONE */
+#endif
+    }
+
+    /* 全部发完：缓冲区可复用，接下来等 expect（默认 "SEND OK"） */
+    AT_PayloadRelease(mgr, c, true);
+}
+
 /**
  * @brief 对返回的字符串进行处理
  * @param mgr AT设备句柄
@@ -312,49 +716,48 @@ AT_Resp_t AT_SendCmd(AT_Manager_t* mgr, const char* cmd, const char* expect, uin
 static void AT_OnLine(AT_Manager_t* mgr, const char* line) {
     if (!mgr || !line) return;
 
-    /* 有正在执行的命令：优先作为响应处理 */
+    /* 1、有正在执行的命令：先按行首分类判断是否为终止结果码 */
     if (mgr->curr_cmd) {
-        AT_Command_t* c    = mgr->curr_cmd;
-        const char* expect = (c->expect_buf[0] != '\0') ? c->expect_buf : "OK";
-
-        if (strstr(line, expect)) {
-            c->result     = AT_RESP_OK;
-            mgr->curr_cmd = NULL;
-            OSAL_sem_give(c->done_sem);
-            // 触发发送下一条
-            if (mgr->core_task) OSAL_thread_flags_set(mgr->core_task, AT_FLAG_TX);
-            LOG_D("AT", "match result=%d line=%s", c->result, line);
+        AT_Command_t* c = mgr->curr_cmd;
+
+        /* 负载阶段：先收尾已完成的 DMA，"SEND OK" 可能比 TXDONE 先被处理 */
+        if (c->phase == AT_PHASE_PAYLOAD) AT_PayloadPump(mgr);
+        /* 提示符：开始发送负载 */
+        if (c->phase == AT_PHASE_PROMPT && line[0] == '>') {
+            c->phase = AT_PHASE_PAYLOAD;
+            AT_PayloadPump(mgr);
             return;
         }
-        if (strstr(line, "ERROR")) {
-            c->result     = AT_RESP_ERROR;
-            mgr->curr_cmd = NULL;
-            OSAL_sem_give(c->done_sem);
-            if (mgr->core_task) OSAL_thread_flags_set(mgr->core_task, AT_FLAG_TX);
-            LOG_D("AT", "match result=%d line=%s", c->result, line);
-            return;
-        }
-        if (strstr(line, "busy p") || strstr(line, "busy s")) {
-            c->result     = AT_RESP_BUSY;
-            mgr->curr_cmd = NULL;
-            OSAL_sem_give(c->done_sem);
-            if (mgr->core_task) OSAL_thread_flags_set(mgr->core_task, AT_FLAG_TX);
-            LOG_D("AT", "match result=%d line=%s", c->result, line);
-            return;
+
+        const AT_LineKind_t kind = AT_ClassifyLine(line);
+        AT_Resp_t result         = AT_RESP_WAITING;
+
+        /* 自定义 expect 仍按子串匹配；默认只认行首 "OK"；负载发完之前的 "OK" 只是中间行 */
+        const bool matched = (c->expect_buf[0] != '\0') ? (strstr(line, c->expect_buf) != NULL)
+                                                        : (kind == AT_LINE_OK);
+        if (matched && c->phase == AT_PHASE_RESP) {
+            result = AT_RESP_OK;
+        } else if (kind == AT_LINE_ERROR) {
+            result = AT_RESP_ERROR;
+        } else if (kind == AT_LINE_BUSY) {
+            result = AT_RESP_BUSY;
         }
 
-        /* 2、未命中：很可能是 URC/中间行，交给 URC 回调（如果有）*/
-        if (mgr->urc_cb) {
-            mgr->urc_cb(mgr, line, mgr->urc_user);
+        if (result != AT_RESP_WAITING) {
+            AT_CmdFinish(mgr, result);
+            LOG_D(AT, "match result=%d line=%s", c->result, line);
+            return;
         }
-        return;
     }
 
-    /* 3、 没有 curr_cmd：一定是 URC */
-    if (mgr->urc_cb) {
+    /* 2、中间行 / URC：先查前缀表，未命中交给兜底回调 */
+    AT_UrcEntry_t hit;
+    if (AT_UrcLookup(mgr, line, &hit)) {
+        hit.cb(mgr, line, hit.user);
+    } else if (mgr->urc_cb) {
         mgr->urc_cb(mgr, line, mgr->urc_user);
-    } else {
-        LOG_W("AT", "URC: %s", line);
+    } else if (!mgr->curr_cmd) {
+        LOG_W(AT, "URC: %s", line);
     }
 }
 
@@ -414,13 +817,13 @@ static void AT_CmdFree(AT_Manager_t* mgr, AT_Command_t* c) {
     if (!mgr || !c) return;
     /* 判断指针范围是否在池中 */
     if (c < mgr->cmd_pool || c >= &mgr->cmd_pool[AT_MAX_PENDING]) {
-        LOG_E("AT", "CmdFree invalid ptr=%p", c);
+        LOG_E(AT, "CmdFree invalid ptr=%p", c);
         return;
     }
 
     /* 防止重复释放 */
     if (c->in_use == 0) {
-        LOG_E("AT", "CmdFree double free idx=%u", (unsigned)(c - mgr->cmd_pool));
+        LOG_E(AT, "CmdFree double free idx=%u", (unsigned)(c - mgr->cmd_pool));
         return;
     }
     // 清理字段（保留 done_sem）
@@ -429,6 +832,9 @@ static void AT_CmdFree(AT_Manager_t* mgr, AT_Command_t* c) {
     c->timeout_ms    = AT_CMD_TIMEOUT_DEF;
     c->cmd_buf[0]    = '\0';
     c->expect_buf[0] = '\0';
+    c->seg_cnt       = 0;
+    c->phase         = AT_PHASE_RESP;
+    c->tx_done       = NULL;
 
     /* 加锁 */
     if (mgr->pool_mutex) OSAL_mutex_lock(mgr->pool_mutex, OSAL_WAIT_FOREVER);
@@ -438,7 +844,7 @@ static void AT_CmdFree(AT_Manager_t* mgr, AT_Command_t* c) {
     if (mgr->free_top < AT_MAX_PENDING) {
         mgr->free_stack[mgr->free_top++] = idx;
     } else {
-        LOG_E("AT", "free_stack overflow (double free?) idx=%u", idx);
+        LOG_E(AT, "free_stack overflow (double free?) idx=%u", idx);
     }
 
     /* 释放锁 */
@@ -463,24 +869,33 @@ void AT_SemDrain(osal_sem_t sem) {
 }
 
 /**
- * @brief 获取空闲对象装填参数后返回
+ * @brief 获取空闲对象装填参数（含可选负载段）后入队
  * @param mgr AT句柄
  * @param cmd 发送的AT命令
  * @param expect 期待返回中应该有的字符串
  * @param timeout_ms 超时时间
+ * @param segs 负载段，seg_cnt 为 0 时可为 NULL
+ * @param seg_cnt 段数
+ * @param done 负载缓冲区可复用时的回调
+ * @param user 回调上下文
  * @return 返回一个装填好的命令对象指针
  */
-AT_Command_t* AT_Submit(AT_Manager_t* mgr, const char* cmd, const char* expect,
-                        uint32_t timeout_ms) {
+static AT_Command_t* AT_SubmitEx(AT_Manager_t* mgr, const char* cmd, const char* expect,
+                                 uint32_t timeout_ms, const RingBufferConstVec* segs,
+                                 const uint8_t seg_cnt, const AT_TxDoneCb done, void* user) {
 #if !AT_RTOS_ENABLE
     (void)mgr;
     (void)cmd;
     (void)expect;
     (void)timeout_ms;
+    (void)segs;
+    (void)seg_cnt;
+    (void)done;
+    (void)user;
     return NULL;
 #else
     /* 1、防止空指针 */
-    if (!mgr || !cmd) return NULL;
+    if (!mgr || !cmd || seg_cnt > AT_TX_SEG_MAX || (seg_cnt && !segs)) return NULL;
     /* 2、设置默认超时时间 */
     if (timeout_ms == 0) timeout_ms = AT_CMD_TIMEOUT_DEF;
 
@@ -495,14 +910,25 @@ AT_Command_t* AT_Submit(AT_Manager_t* mgr, const char* cmd, const char* expect,
     strncpy(c->cmd_buf, cmd, AT_CMD_MAX_LEN - 1);
     c->cmd_buf[AT_CMD_MAX_LEN - 1] = '\0';
 
-    /* 6、期待字符串存在且其对应需要的缓冲区存在 */
-    if (expect && expect[0]) {
+    /* 6、期待字符串存在且其对应需要的缓冲区存在（"OK" 等同默认，走行首分类而非子串查找） */
+    if (expect && expect[0] && strcmp(expect, "OK") != 0) {
         strncpy(c->expect_buf, expect, AT_EXPECT_MAX_LEN - 1);
         c->expect_buf[AT_EXPECT_MAX_LEN - 1] = '\0';
+    } else if (seg_cnt) {
+        strcpy(c->expect_buf, "SEND OK");  // 带负载命令的默认终止响应
     } else {
         c->expect_buf[0] = '\0';  // 表示默认 OK
     }
 
+    /* 7、负载只拷贝段描述，数据留在调用者缓冲区 */
+    if (seg_cnt) memcpy(c->segs, segs, seg_cnt * sizeof(RingBufferConstVec));
+    c->seg_cnt = seg_cnt;
+    c->seg_idx = 0;
+    c->seg_off = 0;
+    c->phase   = seg_cnt ? AT_PHASE_PROMPT : AT_PHASE_RESP;
+    c->tx_done = done;
+    c->tx_user = user;
+
     c->timeout_ms     = timeout_ms;
     c->result         = AT_RESP_WAITING;
 
@@ -518,11 +944,75 @@ AT_Command_t* AT_Submit(AT_Manager_t* mgr, const char* cmd, const char* expect,
     if (mgr->core_task) {
         OSAL_thread_flags_set(mgr->core_task, AT_FLAG_TX);  // AT_FLAG_TX
     }
-    LOG_D("AT", "submit cmd=%s q=%p", c->cmd_buf, mgr->cmd_q);
+    LOG_D(AT, "submit cmd=%s q=%p", c->cmd_buf, mgr->cmd_q);
     return c;
 #endif
 }
 
+/**
+ * @brief 获取空闲对象装填参数后返回
+ * @param mgr AT句柄
+ * @param cmd 发送的AT命令
+ * @param expect 期待返回中应该有的字符串
+ * @param timeout_ms 超时时间
+ * @return 返回一个装填好的命令对象指针
+ */
+AT_Command_t* AT_Submit(AT_Manager_t* mgr, const char* cmd, const char* expect,
+                        uint32_t timeout_ms) {
+    return AT_SubmitEx(mgr, cmd, expect, timeout_ms, NULL, 0, NULL, NULL);
+}
+
+/**
+ * @brief 提交带负载的命令：命令发出后等 '>' 提示符，再把各段负载直接交给串口（DMA）发送
+ * @param mgr AT句柄
+ * @param cmd 命令头
+ * @param segs 负载段（只拷贝描述，数据不拷贝）
+ * @param seg_cnt 段数（1..AT_TX_SEG_MAX）
+ * @param expect 负载发完后期待的响应，NULL 表示 "SEND OK"
+ * @param timeout_ms 整个交互的超时时间
+ * @param done 负载缓冲区可复用时的回调
+ * @param user 回调上下文
+ * @return 返回一个装填好的命令对象指针，失败返回 NULL
+ */
+AT_Command_t* AT_SubmitPayload(AT_Manager_t* mgr, const char* cmd, const RingBufferConstVec* segs,
+                               const uint8_t seg_cnt, const char* expect, uint32_t timeout_ms,
+                               const AT_TxDoneCb done, void* user) {
+    if (seg_cnt == 0) return NULL;
+    return AT_SubmitEx(mgr, cmd, expect, timeout_ms, segs, seg_cnt, done, user);
+}
+
+/**
+ * @brief 发送带负载的命令并等待结果 (阻塞式接口)
+ * @param mgr AT句柄
+ * @param cmd 命令头
+ * @param segs 负载段
+ * @param seg_cnt 段数
+ * @param expect 负载发完后期待的响应，NULL 表示 "SEND OK"
+ * @param timeout_ms 整个交互的超时时间
+ * @return 执行结果
+ * @note  核心任务在超时点一定会结束命令，所以这里不设上限地等待，
+ *        保证返回时负载缓冲区（常在调用者栈上）已不再被 DMA 引用
+ */
+AT_Resp_t AT_SendPayload(AT_Manager_t* mgr, const char* cmd, const RingBufferConstVec* segs,
+                         const uint8_t seg_cnt, const char* expect, uint32_t timeout_ms) {
+#if !AT_RTOS_ENABLE
+    (void)mgr;
+    (void)cmd;
+    (void)segs;
+    (void)seg_cnt;
+    (void)expect;
+    (void)timeout_ms;
+    return AT_RESP_ERROR;
+#else
+    AT_Command_t* h = AT_SubmitPayload(mgr, cmd, segs, seg_cnt, expect, timeout_ms, NULL, NULL);
+    if (!h) return AT_RESP_BUSY;
+
+    const AT_Resp_t r = AT_Wait(h, OSAL_WAIT_FOREVER);
+    AT_CmdRelease(mgr, h);
+    return r;
+#endif
+}
+
 /**
  * @brief 阻塞等待直到获取到信号量或者超时
  * @param h 命令对象指针
@@ -11,6 +11,10 @@
 #ifndef AT_RTOS_ENABLE
 #define AT_RTOS_ENABLE 1 /*是否启用了RTOS*/
 #endif
+/* 1: 接收中断里用 DWT 周期计数累计耗时(rx_isr_cycles / rx_isr_bytes)  0: 关闭 */
+#ifndef AT_RX_ISR_PROFILE
+#define AT_RX_ISR_PROFILE 0
+#endif
 /* 2、=阻塞发送(HAL_UART_Transmit)  1=DMA发送(HAL_UART_Transmit_DMA)*/
 #ifndef AT_TX_USE_DMA
 #define AT_TX_USE_DMA 1
@@ -20,14 +24,16 @@
 #define AT_FLAG_TX (1u << 1)
 #define AT_FLAG_TXDONE (1u << 2)
 /* AT指令超时设置 */
-#define AT_RX_RB_SIZE 1024      /* AT接收环形缓冲区大小 最好为2的幂*/
-#define AT_LEN_RB_SIZE 64       /* 长度缓冲区: 存每行的长度 (存32行足够了, 32*2byte=64) */
-#define AT_DMA_BUF_SIZE 256     /* DMA 接收缓冲区 */
+#define AT_RX_RB_SIZE 1024      /* AT接收环大小，同时是 DMA 循环接收缓冲 必须为2的幂*/
 #define AT_LINE_MAX_LEN 256     /* 单行回复最大长度 */
 #define AT_CMD_TIMEOUT_DEF 5000 /* 默认超时时间 5s */
 #define AT_MAX_PENDING 16       /* 同同一个串口最大排队的命令数 */
 #define AT_CMD_MAX_LEN 128      /* 命令缓存长度  */
 #define AT_EXPECT_MAX_LEN 64    /* expect 缓存长度 */
+#define AT_URC_MAX 16           /* 每个设备最多注册的 URC 前缀数 */
+#define AT_URC_PREFIX_MAX 16    /* URC 前缀缓存长度(含结束符) */
+#define AT_BIN_MAX 4            /* 每个设备最多注册的二进制头数 */
+#define AT_TX_SEG_MAX 4         /* 单条命令提示符后最多发送的负载段数 */
 
 /* 根据模式引入头文件 */
 #if AT_RTOS_ENABLE
@@ -35,11 +41,37 @@
 #endif
 /* 向前声明 */
 typedef struct AT_Manager_t AT_Manager_t;
+typedef struct AT_Command_t AT_Command_t;
 
 typedef void (*AT_UrcCb)(AT_Manager_t *mgr, const char *line, void *user);
 
 typedef bool (*HW_Send)(AT_Manager_t *mgr, const uint8_t *data, uint16_t len);
 
+/**
+ * @brief 二进制负载的一段（零拷贝视图）
+ * @note  span 指向接收环内部，可能跨尾分成 p1/p2 两段，只在回调期间有效；
+ *        需要保留时在回调里拷贝到自己的缓冲区（off 即写入偏移）
+ */
+typedef struct {
+    const char *hdr;     /* 头部文本（前缀到 ':'，含 ':'，'\0' 结尾） */
+    RingBufferSpan span; /* 本段数据 */
+    uint32_t off;        /* 本段在整个负载中的偏移 */
+    uint32_t total;      /* 负载总长度（由头部解析得到） */
+} AT_BinChunk_t;
+
+/**
+ * @brief 负载发送结束回调（核心任务上下文）
+ * @note  调用时负载缓冲区已不再被串口/DMA 引用，可以复用或释放；
+ *        sent 为 true 表示全部字节已发出，false 表示命令在发送前/发送中被终止
+ */
+typedef void (*AT_TxDoneCb)(AT_Manager_t *mgr, AT_Command_t *cmd, bool sent, void *user);
+
+/* 二进制负载回调：负载按到达顺序分段交付，off + 本段长度 == total 时为最后一段 */
+typedef void (*AT_BinCb)(AT_Manager_t *mgr, const AT_BinChunk_t *chunk, void *user);
+
+/* 二进制头解析：hdr 为前缀到 ':' 的文本，解析出负载长度；返回 false 则按普通行处理 */
+typedef bool (*AT_BinLenFn)(const char *hdr, uint32_t *len);
+
 /* ================= 枚举定义 ================= */
 /* AT命令执行返回的结果 */
 typedef enum {
@@ -58,6 +90,43 @@ typedef enum {
     AT_EVT_TIMEOUT, /* [Tick] 定时器超时 */
 } AT_EventID_t;
 
+/* 单行快速分类结果（只看行首若干字节） */
+typedef enum {
+    AT_LINE_OTHER = 0, /* 普通行：中间响应 / URC */
+    AT_LINE_OK,        /* "OK" */
+    AT_LINE_ERROR,     /* "ERROR" / "+CME ERROR" / "+CMS ERROR" */
+    AT_LINE_BUSY,      /* "busy p..." / "busy s..." */
+} AT_LineKind_t;
+
+/**
+ * @brief URC 前缀路由表条目
+ * @note  表按 prefix 字典序排列；parent 指向表中“是本前缀真前缀”的最长条目，
+ *        注册时计算，查找时二分定位后沿 parent 回退即可得到最长匹配
+ */
+typedef struct {
+    char prefix[AT_URC_PREFIX_MAX]; /* 行首前缀，如 "+IPD" */
+    uint8_t len;                    /* 前缀长度 */
+    int8_t parent;                  /* 真前缀条目下标，-1 表示无 */
+    AT_UrcCb cb;                    /* 命中后的回调 */
+    void *user;                     /* 回调上下文 */
+} AT_UrcEntry_t;
+
+/* 二进制头注册表条目 */
+typedef struct {
+    char prefix[AT_URC_PREFIX_MAX]; /* 行首前缀，如 "+IPD" */
+    uint8_t len;                    /* 前缀长度 */
+    AT_BinLenFn len_fn;             /* 头部解析 */
+    AT_BinCb cb;                    /* 负载回调 */
+    void *user;                     /* 回调上下文 */
+} AT_BinEntry_t;
+
+/* 带负载命令的发送阶段 */
+typedef enum {
+    AT_PHASE_RESP = 0, /* 等待终止响应（不带负载的命令，或负载已发完） */
+    AT_PHASE_PROMPT,   /* 命令已发出，等待 '>' 提示符 */
+    AT_PHASE_PAYLOAD,  /* 正在逐段发送负载 */
+} AT_TxPhase_t;
+
 /* 串口发送是否采用DMA */
 typedef enum { AT_TX_BLOCK = 0, AT_TX_DMA = 1 } AT_TxMode;
 
@@ -71,9 +140,10 @@ typedef enum { AT_TX_BLOCK = 0, AT_TX_DMA = 1 } AT_TxMode;
  *
  * 注意：
  * - cmd_buf / expect_buf 采用“拷贝式存储”，避免上层传入栈内存导致悬空。
+ * - 负载只拷贝段描述（segs），数据本身由调用者持有，直到 tx_done 回调/命令结束。
  * - result / is_finished 常在核心任务与上层调用线程之间共享，因此以 volatile 标记可见性。
  */
-typedef struct {
+typedef struct AT_Command_t {
     /* ===========================
      * 1) 请求参数（由调用者写入）
      * =========================== */
@@ -91,6 +161,24 @@ typedef struct {
     /** 命令级超时（毫秒），从“命令发出/会话开始”起计算 */
     uint32_t timeout_ms;
 
+    /**
+     * 提示符后发送的负载（零拷贝，分散段）
+     * - seg_cnt 为 0：普通命令
+     * - 非 0：命令发出后等 '>'，再按顺序把各段直接交给串口发送
+     * - seg_idx / seg_off：发送进度（核心任务维护）
+     */
+    RingBufferConstVec segs[AT_TX_SEG_MAX];
+    uint8_t seg_cnt;
+    uint8_t seg_idx;
+    uint32_t seg_off;
+
+    /** 发送阶段（核心任务维护） */
+    AT_TxPhase_t phase;
+
+    /** 负载发送结束回调及其上下文（可为 NULL） */
+    AT_TxDoneCb tx_done;
+    void *tx_user;
+
     /* ===========================
      * 2) 运行结果（由核心层回填）
      * =========================== */
@@ -136,14 +224,14 @@ typedef struct {
  *
  * 管理器负责协调如下职责：
  * 1) 底层输入输出：串口句柄、发送函数、DMA 接收缓冲
- * 2) 接收路径：DMA -> 回调搬运 -> 字节环形缓冲；以及“行边界/长度”队列
+ * 2) 接收路径：DMA 直接写入接收环存储区 -> 回调只发布写位置 -> 核心任务批量拆行
  * 3) 解析与分流：按行取出，区分“命令响应”与“URC 异步通知”
  * 4) 命令调度：命令队列、单活动命令会话、超时裁决
  * 5) 双模：RTOS 下用消息队列/任务/互斥；裸机下用简化忙锁
  *
  * 线程模型（RTOS）：
- * - ISR/回调：只做增量搬运 + 行边界打点 + 事件通知，不做字符串解析
- * - 核心任务：消费行、执行匹配、驱动命令会话完成、路由 URC
+ * - ISR/回调：只发布 DMA 写位置 + 事件通知，不搬运、不逐字节检查
+ * - 核心任务：按字批量查找行结束符拆行、执行匹配、驱动命令会话完成、路由 URC
  */
 typedef struct AT_Manager_t {
     /* =========================================================
@@ -162,11 +250,9 @@ typedef struct AT_Manager_t {
      * ========================================================= */
 
     /**
-     * 接收字节环形缓冲（Byte Ring Buffer）
-     * - 写入侧：ISR/接收回调（增量搬运）
-     * - 读取侧：核心任务（按行长度读取）
-     *
-     * 注意：若 RingBuffer 内部不自带存储区，则需在外部注入静态内存。
+     * 接收环（存储区即 dma_rx_arr，SPSC）
+     * - 写入侧：DMA 直接写存储区，接收回调只发布写位置（不拷贝、不进临界区）
+     * - 读取侧：核心任务查找行结束符后整行读出
      */
     RingBuffer rx_rb;
 
@@ -192,58 +278,74 @@ typedef struct AT_Manager_t {
     uint8_t line_buf[AT_LINE_MAX_LEN];
 
     /**
-     * DMA 循环接收缓冲（DMA Rx Circular Buffer）
+     * DMA 循环接收缓冲（DMA Rx Circular Buffer），同时是 rx_rb 的存储区
      * - DMA 写入侧：硬件/驱动
-     * - 消费侧：接收回调根据 DMA 写指针增量取出新数据
+     * - 消费侧：核心任务经 rx_rb 读取，ISR 不接触数据本身
      */
-    uint8_t dma_rx_arr[AT_DMA_BUF_SIZE];
+    uint8_t dma_rx_arr[AT_RX_RB_SIZE];
 
     /**
-     * 行处理索引（可用于行缓存消费过程中的游标）
-     * - 若仅作为调试/统计，可考虑后续收敛
-     * - volatile：可能在不同上下文读取（建议统一由核心任务维护）
+     * 拆行扫描游标（任务上下文私有）
+     * - 相对读位置已经确认不含行结束符的字节数，下次从这里继续查找
+     * - 避免半行数据在每次唤醒时被重复扫描
      */
-    volatile uint16_t line_idx;
+    uint32_t rx_scan;
 
     /**
-     * ISR 侧“当前行累计长度”
-     * - 接收回调逐字节统计：当前行写入了多少字节
-     * - 遇到行结束符/提示符时，将该长度写入“行长度队列”，并清零重新累计
+     * 丢弃到行尾标志（任务上下文私有）
+     * - 超长行已截断交付、或 DMA 覆盖了未读数据（rx_rb 的 overruns 计数变化）后置位，
+     *   丢弃本行剩余字节
+     * - 遇到行结束符/提示符后清零，下一行重新开始
      */
-    volatile uint16_t isr_line_len;
+    bool rx_discard;
 
     /**
-     * 行长度环形缓冲（Length Queue）
-     * - 存放每一行的长度（uint16）
-     * - 写入侧：ISR/接收回调（边界打点）
-     * - 读取侧：核心任务（按长度从 rx_rb 取出完整行）
-     *
-     * 该队列的存在使核心任务无需再扫描分隔符，直接按长度取行。
+     * 接收通知已发出、核心任务尚未开始处理
+     * - 中断里置位后再发 AT_FLAG_RX；置位期间的后续中断只发布写位置，不再调用 RTOS
+     * - AT_Core_Process 读接收环之前清零，之后发布的数据会重新通知
      */
-    RingBuffer msg_len_rb;
+    volatile uint8_t rx_notified;
+
+#if AT_RX_ISR_PROFILE
+    /** 接收中断累计 DWT 周期数 / 累计发布字节数 / 中断次数，AT_RxIsrProfileReport 输出并清零 */
+    volatile uint32_t rx_isr_cycles;
+    volatile uint32_t rx_isr_bytes;
+    volatile uint32_t rx_isr_calls;
+#endif
+
+    /** URC 回调的用户上下文指针（透传给 urc_cb） */
+    void *urc_user;
 
     /**
-     * DMA 增量处理游标：记录上次处理到的 DMA 写入位置
-     * - 用于处理 DMA 环形回卷：计算“新增字节段”
+     * URC 回调（异步通知处理，兜底）
+     * - 当收到的行不属于任何活动命令会话、且未命中 urc_tab 中任何前缀时，调用该回调
+     * - 建议 URC 回调只做轻量解析与投递，避免阻塞核心任务
      */
-    volatile uint16_t last_pos;
+    AT_UrcCb urc_cb;
 
     /**
-     * 接收溢出标志
-     * - 当 rx_rb 或 msg_len_rb 写入失败（空间不足）时置位
-     * - 核心任务应执行“止血策略”：清空缓冲、记录统计、必要时进入恢复状态
+     * URC 前缀路由表（AT_RegisterUrc 维护，按前缀字典序排列）
+     * - 核心任务对每个非终止行二分查找一次，命中最长前缀后调用对应回调
+     * - urc_cnt：当前条目数
      */
-    volatile bool rx_overflow;
+    AT_UrcEntry_t urc_tab[AT_URC_MAX];
+    uint8_t urc_cnt;
 
-    /** URC 回调的用户上下文指针（透传给 urc_cb） */
-    void *urc_user;
+    /**
+     * 二进制头注册表（AT_RegisterBinary 维护，受 urc_mutex 保护）
+     * - 行首命中某个前缀后读到 ':' 为止作为头部，解析出长度，切换到按长度接收
+     */
+    AT_BinEntry_t bin_tab[AT_BIN_MAX];
+    uint8_t bin_cnt;
 
     /**
-     * URC 回调（异步通知处理）
-     * - 当收到的行不属于任何活动命令会话时，调用该回调
-     * - 建议 URC 回调只做轻量解析与投递，避免阻塞核心任务
+     * 当前二进制负载接收状态（任务上下文私有）
+     * - bin_off < bin_total：处于二进制模式，接收环里的字节按原样交给 bin_cur.cb
+     * - 交付满 bin_total 字节后回到行模式；头部文本保留在 line_buf 中
      */
-    AT_UrcCb urc_cb;
+    AT_BinEntry_t bin_cur;
+    uint32_t bin_total;
+    uint32_t bin_off;
 
     /* =========================================================
      * 4) 命令会话运行时状态（单活动命令）
@@ -312,6 +414,9 @@ typedef struct AT_Manager_t {
     /** 对象池互斥：保护对象池分配/归还操作，避免多线程并发破坏 */
     osal_mutex_t pool_mutex;
 
+    /** URC 表互斥：注册线程改表与核心任务查表互斥 */
+    osal_mutex_t urc_mutex;
+
     /**
      * 命令对象池（静态分配，避免动态内存）
      * - cmd_pool：实际对象存储
@@ -367,6 +472,10 @@ void AT_Core_RxCallback(AT_Manager_t *at_manager, const UART_HandleTypeDef *huar
  */
 void AT_Core_Process(AT_Manager_t *at_manager);
 
+#if AT_RX_ISR_PROFILE
+void AT_RxIsrProfileReport(AT_Manager_t *at_manager);
+#endif
+
 /**
  * @brief 发送 AT 指令并等待结果 (阻塞式接口)
  * @param at_manager AT设备句柄
@@ -392,14 +501,69 @@ uint32_t AT_MsToTicks(uint32_t ms);
  */
 AT_Resp_t AT_Poll(AT_Command_t *h);
 
+/**
+ * @brief 阻塞等待直到获取到信号量或者超时
+ * @param h 命令对象指针
+ * @param wait_ms 等待的时间
+ * @return 命令结果
+ */
+AT_Resp_t AT_Wait(AT_Command_t *h, uint32_t wait_ms);
+
+/**
+ * @brief 将内存池中的对象进行释放重置参数
+ * @param mgr AT设备对象指针
+ * @param h   AT命令对象指针
+ */
+void AT_CmdRelease(AT_Manager_t *mgr, AT_Command_t *h);
+
 /**
  *
  * @param mgr AT设备句柄
  * @param cb  绑定的URC回调函数
  * @param user 传递的上下文
+ * @note  兜底回调：只接收未命中 AT_RegisterUrc 前缀表的行
  */
 void AT_SetUrcHandler(AT_Manager_t *mgr, AT_UrcCb cb, void *user);
 
+/**
+ * @brief 按行首前缀注册 URC 回调
+ * @param mgr AT设备句柄
+ * @param prefix 行首前缀，如 "+IPD"（长度 1..AT_URC_PREFIX_MAX-1）
+ * @param cb 命中后的回调；NULL 表示注销该前缀
+ * @param user 传递的上下文
+ * @return 表满返回 RET_E_NO_MEM，注销不存在的前缀返回 RET_E_NOT_FOUND
+ * @note  同一前缀重复注册会替换回调；多个前缀同时命中时取最长的那个
+ */
+ret_code_t AT_RegisterUrc(AT_Manager_t *mgr, const char *prefix, AT_UrcCb cb, void *user);
+
+/**
+ * @brief 注册二进制头：行首命中 prefix 后切换为按长度接收，负载原样分段交给 cb
+ * @param mgr AT设备句柄
+ * @param prefix 头部前缀，如 "+IPD"（长度 1..AT_URC_PREFIX_MAX-1）
+ * @param len_fn 头部解析函数（ESP-AT 的 +IPD 可直接用 AT_ParseIpdLen）
+ * @param cb 负载回调；NULL 表示注销该前缀
+ * @param user 传递的上下文
+ * @return 表满返回 RET_E_NO_MEM，注销不存在的前缀返回 RET_E_NOT_FOUND
+ * @note  负载可以比接收环大：边收边交付，回调要跟上 DMA 速度，否则覆盖后本次负载作废
+ */
+ret_code_t AT_RegisterBinary(AT_Manager_t *mgr, const char *prefix, AT_BinLenFn len_fn,
+                             AT_BinCb cb, void *user);
+
+/**
+ * @brief 解析 ESP-AT 的 "+IPD,[<link>,]<len>[,"<ip>",<port>]:" 头部
+ * @param hdr 头部文本
+ * @param len 负载长度
+ * @return 格式不符返回 false
+ */
+bool AT_ParseIpdLen(const char *hdr, uint32_t *len);
+
+/**
+ * @brief 一次扫描行首判断是否为终止结果码
+ * @param line 接收到的一行
+ * @return 行的分类
+ */
+AT_LineKind_t AT_ClassifyLine(const char *line);
+
 /**
  * @brief 获取空闲对象装填参数后返回
  * @param mgr AT句柄
@@ -411,6 +575,51 @@ void AT_SetUrcHandler(AT_Manager_t *mgr, AT_UrcCb cb, void *user);
 AT_Command_t *AT_Submit(AT_Manager_t *mgr, const char *cmd, const char *expect,
                         uint32_t timeout_ms);
 
+/**
+ * @brief 提交带负载的命令：命令发出后等 '>' 提示符，再把各段负载直接交给串口（DMA）发送
+ * @param mgr AT句柄
+ * @param cmd 命令头，如 "AT+CIPSEND=0,1024\r\n"（长度由调用者写对）
+ * @param segs 负载段（只拷贝描述，数据不拷贝）
+ * @param seg_cnt 段数（1..AT_TX_SEG_MAX）
+ * @param expect 负载发完后期待的响应，NULL 表示 "SEND OK"
+ * @param timeout_ms 整个交互（命令 + 提示符 + 负载 + 响应）的超时时间
+ * @param done 负载缓冲区可复用时的回调（核心任务上下文，可为 NULL）
+ * @param user 回调上下文
+ * @return 返回一个装填好的命令对象指针，失败返回 NULL（此时不会调用 done）
+ * @note  非阻塞：结果用 AT_Poll 查询，用完 AT_CmdRelease；done 回调前负载数据必须保持有效
+ */
+AT_Command_t *AT_SubmitPayload(AT_Manager_t *mgr, const char *cmd, const RingBufferConstVec *segs,
+                               uint8_t seg_cnt, const char *expect, uint32_t timeout_ms,
+                               AT_TxDoneCb done, void *user);
+
+/**
+ * @brief 发送带负载的命令并等待结果 (阻塞式接口)
+ * @param mgr AT句柄
+ * @param cmd 命令头
+ * @param segs 负载段
+ * @param seg_cnt 段数
+ * @param expect 负载发完后期待的响应，NULL 表示 "SEND OK"
+ * @param timeout_ms 整个交互的超时时间
+ * @return 执行结果
+ * @note  一直等到核心任务结束该命令才返回，返回后负载缓冲区一定不再被引用
+ */
+AT_Resp_t AT_SendPayload(AT_Manager_t *mgr, const char *cmd, const RingBufferConstVec *segs,
+                         uint8_t seg_cnt, const char *expect, uint32_t timeout_ms);
+
+/**
+ * @brief 结束当前活动命令（核心任务上下文）
+ * @param mgr AT设备句柄
+ * @param result 命令结果
+ * @note  负载还没释放时先停止发送并调用 tx_done，再唤醒等待者、推进下一条命令
+ */
+void AT_CmdFinish(AT_Manager_t *mgr, AT_Resp_t result);
+
+/**
+ * @brief 推进当前命令的负载发送（核心任务上下文，收到 TXDONE 后调用）
+ * @param mgr AT设备句柄
+ */
+void AT_PayloadPump(AT_Manager_t *mgr);
+
 /**
  * @brief 获取空闲对象装填参数后返回
  * @param mgr AT句柄
@@ -22,9 +22,12 @@ void AT_Core_Task(void* argument) {
     AT_Manager_t* mgr = (AT_Manager_t*)argument;
 
     for (;;) {
-        /*  用一个小超时周期，让有机会做超时检查*/
-        const uint32_t flags = OSAL_thread_flags_wait(AT_FLAG_RX | AT_FLAG_TX | AT_FLAG_TXDONE,
-                                                      OSAL_FLAGS_WAIT_ANY, 10);
+        /* 有命令在执行时睡到它的截止 tick，空闲时一直阻塞：所有推进都由 RX/TX/TXDONE 事件驱动 */
+        const osal_flags_t wait = AT_FLAG_RX | AT_FLAG_TX | AT_FLAG_TXDONE;
+        const uint32_t flags =
+            mgr->curr_cmd
+                ? OSAL_thread_flags_wait_until(wait, OSAL_FLAGS_WAIT_ANY, mgr->curr_deadline_tick)
+                : OSAL_thread_flags_wait(wait, OSAL_FLAGS_WAIT_ANY, OSAL_WAIT_FOREVER);
 
         if (!(flags & 0x80000000u)) {
             if (flags & AT_FLAG_RX) {
@@ -32,13 +35,16 @@ void AT_Core_Task(void* argument) {
             }
         }
 
+        /* 0、 负载阶段：上一段 DMA 完成后接着发下一段 */
+        AT_PayloadPump(mgr);
+
         /* 1、 若无当前命令，尝试取队列下一条并发送 */
         if (mgr->curr_cmd == NULL && mgr->cmd_q) {
             /* 判断是否能够发送 */
 #if defined(AT_TX_USE_DMA) && (AT_TX_USE_DMA == 1)
             if (mgr->tx_mode == AT_TX_DMA && mgr->tx_busy) {
                 /* DMA 还在发：不要取队列，不要动 next，不要判错 */
-                /* 等待 TXDONE 或下一次 10ms 轮询 */
+                /* 等待 TXDONE 唤醒后再取 */
                 goto timeout_check;
             }
 #endif
@@ -48,20 +54,17 @@ void AT_Core_Task(void* argument) {
                 mgr->curr_cmd           = next;
                 mgr->req_start_tick     = OSAL_tick_get();
                 mgr->curr_deadline_tick = mgr->req_start_tick + OSAL_ms_to_ticks(next->timeout_ms);
-                LOG_D("AT", "deq cmd=%s", next->cmd_buf);
+                LOG_D(AT, "deq cmd=%s", next->cmd_buf);
                 /* 调用发送函数 */
                 if (mgr->hw_send) {
                     /* 未发生完成就返回 释放命令对象的信号量 重新通知任务发送 */
                     const bool ok =
                         mgr->hw_send(mgr, (uint8_t*)next->cmd_buf, (uint16_t)strlen(next->cmd_buf));
-                    LOG_D("AT", "send ok=%d busy=%u mode=%u", (int)ok, mgr->tx_busy,
+                    LOG_D(AT, "send ok=%d busy=%u mode=%u", (int)ok, mgr->tx_busy,
                           (unsigned)mgr->tx_mode);
                     /* 异常处理 */
                     if (!ok) {
-                        next->result  = AT_RESP_ERROR;
-                        mgr->curr_cmd = NULL;
-                        OSAL_sem_give(next->done_sem);
-                        OSAL_thread_flags_set(mgr->core_task, AT_FLAG_TX); /* 继续发下一条 */
+                        AT_CmdFinish(mgr, AT_RESP_ERROR); /* 继续发下一条 */
                     }
                 }
             }
@@ -73,13 +76,8 @@ void AT_Core_Task(void* argument) {
             const uint32_t now = OSAL_tick_get();
             // 处理 tick 回绕：用有符号差判断
             if ((int32_t)(now - mgr->curr_deadline_tick) >= 0) {
-                AT_Command_t* c = mgr->curr_cmd;
-                c->result       = AT_RESP_TIMEOUT;
-                mgr->curr_cmd   = NULL;
-                OSAL_sem_give(c->done_sem);
-
-                /* 超时后立刻尝试发下一条（提高吞吐）*/
-                OSAL_thread_flags_set(mgr->core_task, AT_FLAG_TX);
+                /* 超时后立刻尝试发下一条（提高吞吐）；负载未发完时先中止 DMA 再交还缓冲区 */
+                AT_CmdFinish(mgr, AT_RESP_TIMEOUT);
             }
         }
     }
@@ -102,7 +100,7 @@ void at_core_task_init(AT_Manager_t* at, UART_HandleTypeDef* uart) {
     if (AT_Core_Task_Handle != NULL) {
         at->core_task = AT_Core_Task_Handle;
     } else {
-        LOG_E("AT_Task", "Task Create Failed!");
+        LOG_E(AT, "Task Create Failed!");
     }
     /* 3、继续初始化 */
     AT_Core_Init(at, uart, Uart_send);
@@ -34,7 +34,7 @@ void AT_BindUart(AT_Manager_t* mgr, UART_HandleTypeDef* huart) {
         }
     }
     /* 满了就报错 */
-    LOG_E("AT", "AT_BindUart bind table full");
+    LOG_E(AT, "AT_BindUart bind table full");
 }
 
 /**
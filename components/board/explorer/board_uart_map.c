@@ -12,13 +12,13 @@ extern UART_HandleTypeDef huart1;
 extern DMA_HandleTypeDef hdma_usart1_rx;
 extern DMA_HandleTypeDef hdma_usart1_tx;
 
-/* DMA 环形缓冲 + 软件 RB（静态） */
+/* DMA 环形缓冲（零拷贝模式下同时作为软件 RB 的存储区） */
 #if defined(CORE_ALIGNED)
-static CORE_ALIGNED(32) uint8_t g_uart1_rx_dma[512];
+static CORE_ALIGNED(32) uint8_t g_uart1_rx_dma[2048];
 #elif defined(__ALIGNED)
-static __ALIGNED(32) uint8_t g_uart1_rx_dma[512];
+static __ALIGNED(32) uint8_t g_uart1_rx_dma[2048];
 #else
-static uint8_t g_uart1_rx_dma[512];
+static uint8_t g_uart1_rx_dma[2048];
 #endif
 
 ret_code_t stm32_uart_bsp_get(hal_uart_id_t id, stm32_uart_bsp_t* out) {
@@ -34,7 +34,7 @@ ret_code_t stm32_uart_bsp_get(hal_uart_id_t id, stm32_uart_bsp_t* out) {
             out->dma_tx_irq = DMA2_Stream7_IRQn;
             out->rx_dma_buf = g_uart1_rx_dma;          // DMA 内存侧地址
             out->rx_dma_len = sizeof(g_uart1_rx_dma);  // 长度 必须为2的幂次大小
-            out->sw_rb_len  = 2048;                    /* 软件RB的容量 KB 尽量为2的幂次大小 */
+            out->sw_rb_len  = 0;                       /* 0：零拷贝，DMA 缓冲即软件 RB */
             out->irq_prio   = 5;
             return UART_MAP_RET(RET_ERRNO_OK);
         default:
@@ -10,6 +10,7 @@
 #define ENABLE_ASSERT_SYSTEM     /* 断言管理系统 */
 #define ENABLE_STATIC_ALLOCATION /* 静态内存分配 */
 #define ENABLE_RINGBUFFER_SYSTEM /* 环形缓冲区系统 */
+#define ENABLE_RINGBUFFER_STATS  /* 环形缓冲区运行统计与登记表（高水位/失败/截断/吞吐） */
 #define ENABLE_HFSM_SYSTEM       /* HFSM系统 */
 #define ENABLE_KEYS              /* 使能按键系统 */
 
@@ -13,10 +13,20 @@
  */
 uint32_t hal_get_tick_ms(void);
 /**
- * @note 可以回绕 上层应该做好检查
+ * @note 按 2^32 us 回绕（约 71.6 分钟），上层用无符号差值比较；ISR 和任务中均可调用
  * @return 返回当前以 us 为单位的时间戳
  */
 uint32_t hal_get_tick_us32(void);
+/**
+ * @brief 获取 CPU 周期计数（DWT->CYCCNT，DWT 不可用时按毫秒计数折算）
+ * @return 32 位周期计数，按 2^32 回绕（168MHz 下约 25.5 s）
+ * @note 只读一次寄存器、不进临界区，ISR 和任务中均可调用；频率见 hal_get_cycles_hz()
+ */
+uint32_t hal_get_cycles(void);
+/**
+ * @return hal_get_cycles() 的计数频率 (Hz)
+ */
+uint32_t hal_get_cycles_hz(void);
 
 /**
  * @brief 毫秒级阻塞延时
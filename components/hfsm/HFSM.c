@@ -7,9 +7,9 @@
 #include "HFSM.h"
 #include "log.h"
 
-/* 默认 TAG，可以按需改 */
+/* 默认 TAG (须在 log_tags.h 中注册)，可以按需改 */
 #ifndef HFSM_LOG_TAG
-#define HFSM_LOG_TAG "HFSM"
+#define HFSM_LOG_TAG HFSM
 #endif
 
 /**************************************************************************/
@@ -42,10 +42,10 @@
 /* --- 情况二：只有局部开关，无总日志系统 -> 回退到 printf --- */
 #include <stdio.h>
 
-#define HFSM_LOGE(fmt, ...) printf("[E][%s] " fmt "\r\n", HFSM_LOG_TAG, ##__VA_ARGS__)
-#define HFSM_LOGW(fmt, ...) printf("[W][%s] " fmt "\r\n", HFSM_LOG_TAG, ##__VA_ARGS__)
-#define HFSM_LOGI(fmt, ...) printf("[I][%s] " fmt "\r\n", HFSM_LOG_TAG, ##__VA_ARGS__)
-#define HFSM_LOGD(fmt, ...) printf("[D][%s] " fmt "\r\n", HFSM_LOG_TAG, ##__VA_ARGS__)
+#define HFSM_LOGE(fmt, ...) printf("[E][%s] " fmt "\r\n", LOG_STR(HFSM_LOG_TAG), ##__VA_ARGS__)
+#define HFSM_LOGW(fmt, ...) printf("[W][%s] " fmt "\r\n", LOG_STR(HFSM_LOG_TAG), ##__VA_ARGS__)
+#define HFSM_LOGI(fmt, ...) printf("[I][%s] " fmt "\r\n", LOG_STR(HFSM_LOG_TAG), ##__VA_ARGS__)
+#define HFSM_LOGD(fmt, ...) printf("[D][%s] " fmt "\r\n", LOG_STR(HFSM_LOG_TAG), ##__VA_ARGS__)
 
 #else
 
@@ -9,10 +9,14 @@
 #include "main.h" /* 包含HAL库定义 */
 
 /* 引入 CMSIS-OS2 和 RingBuffer */
+#include "BroadcastRing.h"
 #include "MemoryAllocation.h"
 #include "RingBuffer.h"
+#include "hal_time.h"
 #include "osal.h"
+#include "rb_port.h"
 #include "ret_code.h"
+#include "utils_def.h"
 
 #define snprintf_my  sniprintf
 #define vsnprintf_my vsniprintf
@@ -36,95 +40,1399 @@
 /* 单条日志最大长度 (字节) */
 #define LOG_LINE_MAX 256
 
-/* 定义用于唤醒后台任务的事件标志位 (任意未使用的位即可) */
-#define LOG_TASK_FLAG    0x0001
+/* 日志行尾部：颜色复位 + 换行 */
+static const char s_log_tail[] = COLOR_RESET "\r\n";
+
+/* ================= 日志记录 ================= */
+/* 异步缓冲区中每条日志是一条记录：[log_rec_hdr_t][负载]，头与负载由同一次 WriteV 写入 */
+#define LOG_REC_TEXT  0u /* 负载为 log_fmt_rec_t (fmt 为 NULL) + 已格式化的正文，由后台任务加头尾 */
+#define LOG_REC_FMT   1u /* 负载为 log_fmt_rec_t + 打包参数，由后台任务格式化 */
+#define LOG_REC_TOKEN 2u /* 负载为令牌化日志帧，原样发送，由主机端解码 */
+#define LOG_REC_HEX   3u /* 负载为 log_hex_rec_t + 原始字节，由后台任务展开成 HEX 行 */
+
+typedef struct {
+    uint8_t kind;   // LOG_REC_xxx
+    uint8_t level;  // LogLevel_t
+    uint16_t len;   // 负载字节数
+} log_rec_hdr_t;
+
+/* 文本/延迟格式化记录的固定部分：调用点描述符与 fmt 都是常量，记录里只保存指针 */
+typedef struct {
+    uint32_t stamp;  // 时间戳 (时间源原始计数，32 位回绕)
+    const log_site_t* site;
+    const char* fmt;
+} log_fmt_rec_t;
+
+/* HEX 记录的固定部分：调用方只拷贝原始字节，渲染留给后台任务 */
+typedef struct {
+    uint32_t stamp;  // 时间戳 (时间源原始计数，32 位回绕)
+    const log_site_t* site;
+    uint32_t off;    // 本条记录首字节在整段数据中的偏移
+} log_hex_rec_t;
+
+/* 单条记录负载上限：一行文本 + 尾部 */
+#define LOG_REC_PAYLOAD_MAX (LOG_LINE_MAX + sizeof(s_log_tail))
+
+/* 每条 HEX 记录携带的原始字节数（整行的倍数），长数据拆成多条记录 */
+#define LOG_HEX_REC_BYTES (LOG_HEX_BYTES_PER_LINE * 8u)
+
+CORE_STATIC_ASSERT(sizeof(log_fmt_rec_t) + LOG_DEFER_ARGS_MAX <= LOG_REC_PAYLOAD_MAX,
+                   log_defer_args_too_big);
+CORE_STATIC_ASSERT(sizeof(log_hex_rec_t) + LOG_HEX_REC_BYTES <= LOG_REC_PAYLOAD_MAX,
+                   log_hex_rec_too_big);
+
+#if LOG_TOKENIZED_ENABLE
+#if !LOG_ASYNC_ENABLE
+#error "LOG_TOKENIZED_ENABLE 需要 LOG_ASYNC_ENABLE"
+#endif
+/* 令牌帧: 同步字节 + 长度 + varint(ID) + varint(时间戳 us) + 参数区
+ * (写入缓冲区时时间戳是时间源原始计数，LogTask 分发前换成 us) */
+#define LOG_TOKEN_FRAME_MAX (2u + 5u + 5u + LOG_DEFER_ARGS_MAX)
+
+CORE_STATIC_ASSERT(LOG_TOKEN_FRAME_MAX - 2u <= 0xFFu, log_token_frame_too_big);
+CORE_STATIC_ASSERT(LOG_TOKEN_FRAME_MAX <= LOG_REC_PAYLOAD_MAX, log_token_frame_too_long);
+#endif
+
+/* 分发环只存线上字节，相邻记录首尾相接，后端一笔 DMA 可以连发多条；
+ * 每条记录的长度与等级放在按序号索引的描述符环里，由 LogTask 在发布序号之前写好 */
+typedef struct {
+    uint16_t len;      // 线上字节数
+    uint8_t level;     // LogLevel_t
+    uint8_t reserved;  // 对齐
+} log_out_desc_t;
+
+#define LOG_FANOUT_DESC_MASK (LOG_FANOUT_RECORDS - 1u)
+
+CORE_STATIC_ASSERT(LOG_BACKEND_MAX <= BR_CURSOR_MAX, log_backend_max_too_big);
+CORE_STATIC_ASSERT((LOG_FANOUT_RECORDS & LOG_FANOUT_DESC_MASK) == 0u, log_fanout_records_pow2);
+
+/* LogTask 空闲时的最长等待：开启限流时按折叠窗口醒来补发摘要；
+ * 否则也定期醒来推进 64 位时间基准（32 位 us 时间戳约 71 分钟回绕） */
+#if LOG_RATE_LIMIT_ENABLE
+#define LOG_TASK_IDLE_MS LOG_REPEAT_WINDOW_MS
+#else
+#define LOG_TASK_IDLE_MS 60000u
+#endif
+
+/* 后端回到空闲的事件标志位（新日志到达由 RingBuffer 读等待者唤醒，不再使用事件标志） */
 #define LOG_TX_DONE_FLAG 0x0002
 
-/* 将单字节写入环形缓冲区 */
-static void Log_PushBytes_NoBlock(const uint8_t* data, uint16_t len);
+static void Log_PrintfAt(LogLevel_t level, const log_site_t* site, const char* fmt, ...);
+#if LOG_TOKENIZED_ENABLE
+static uint32_t Log_TokenRestamp(const uint8_t* in, uint32_t n, uint8_t* out);
+#endif
+
+/* ================= 外部依赖 ================= */
+
+/* ================= 变量定义 ================= */
+/* 后端槽：每个后端在分发环上有自己的读游标，发送节奏互不影响 */
+typedef struct {
+    log_backend_t b;
+    BroadcastCursor* cur;       // 分发环读游标（Log_Init 之后有效）
+    volatile uint8_t level;     // 只输出等级 <= level 的日志
+    volatile bool busy;         // 有一笔发送在途：任务启动时置位，完成中断无数据可发时清除
+    volatile bool hold;         // 任务要覆盖在途数据所在空间：完成后不要续发
+    volatile bool lost;         // 游标与序号失配：停发，由 LogTask 重新挂接
+    volatile bool stale;        // 在途发送已放弃但未能中止：下一个完成通知属于那一笔，只清状态
+    bool used;                  // 槽已注册
+    uint32_t next;              // 下一条待处理记录的序号（与游标位置对应）
+    uint32_t pending;           // 在途的连续多条记录总长度，发送完成后 ReadCommit
+    const uint8_t* p2;          // 在途数据跨越末尾时的第二段
+    uint32_t n2;                // 第二段长度
+    volatile uint32_t dropped;  // 落后太多而丢弃的记录条数
+} log_sink_t;
+
+static log_sink_t s_log_sinks[LOG_BACKEND_MAX];
+
+/* tag 运行时等级 (下标为 tag ID)，初值来自 log_tags.h */
+#define LOG_TAG_LEVEL_INIT(name, level) (uint8_t)(level),
+volatile uint8_t g_log_tag_level[LOG_TAG_COUNT] = {LOG_TAG_LIST(LOG_TAG_LEVEL_INIT)};
+#undef LOG_TAG_LEVEL_INIT
+
+/* 每个 tag 一个本模块的调用点：名称查询与汇总报告（丢弃/限流/重复）使用，等级由报告时指定 */
+#define LOG_TAG_SITE_INIT(name, level) LOG_SITE_INIT(name, LOG_LEVEL_WARN),
+static const log_site_t s_log_tag_site[LOG_TAG_COUNT] = {LOG_TAG_LIST(LOG_TAG_SITE_INIT)};
+#undef LOG_TAG_SITE_INIT
+
+/* 日志时间源：记录只存原始计数 (默认 DWT 周期数，只读寄存器不进临界区)，
+ * 输出时才扩展并折算成 us；Log_SetClock 可替换，频率为 0 表示取 hal_get_cycles_hz() */
+static volatile log_clock_fn_t s_log_clock = hal_get_cycles;
+static volatile uint32_t s_log_clock_hz    = 0;
+
+static inline uint32_t Log_Now(void) {
+    return s_log_clock();
+}
+
+#if LOG_ASYNC_ENABLE
+/* 异步模式资源：多生产者无锁缓冲区，任务与中断直接并发写入整条记录，无需互斥量 */
+static RingBuffer s_logRB; /* 环形缓冲区实例 */
+
+/* 多后端分发环（唯一生产者为 LogTask）、记录描述符与已发布的记录数 */
+static BroadcastRing s_logBR;
+static log_out_desc_t s_log_desc[LOG_FANOUT_RECORDS];
+static volatile uint32_t s_log_seq = 0;
+
+/* 缓冲区满整条丢弃的记录数（调用方累加，LogTask 报告差值） */
+static volatile uint32_t s_log_lost = 0;
+static uint32_t s_log_lost_seen     = 0;
+
+/* 后台发送任务的线程 ID */
+static osal_thread_t s_logTaskHandle = NULL;
+
+#else
+/* 同步模式：直接阻塞输出，用互斥量避免多个任务的行交错 */
+static osal_mutex_t s_logMutex = NULL;
+#endif
+
+/* ================= 内部任务实现 ================= */
+/**
+ * @brief 同步模式下串行化任务的输出（异步模式写入无锁，什么也不做）
+ * @param in_isr 是否在中断中（中断中不能取互斥量）
+ */
+static inline void Log_Lock(const bool in_isr) {
+#if !LOG_ASYNC_ENABLE
+    if (!in_isr && OSAL_kernel_is_running() && s_logMutex != NULL) {
+        OSAL_mutex_lock(s_logMutex, OSAL_WAIT_FOREVER);
+    }
+#else
+    (void)in_isr;
+#endif
+}
+
+/**
+ * @brief 释放 Log_Lock
+ * @param in_isr 是否在中断中
+ */
+static inline void Log_Unlock(const bool in_isr) {
+#if !LOG_ASYNC_ENABLE
+    if (!in_isr && OSAL_kernel_is_running() && s_logMutex != NULL) {
+        OSAL_mutex_unlock(s_logMutex);
+    }
+#else
+    (void)in_isr;
+#endif
+}
+
+/**
+ * @brief 获取日志等级对应的颜色与等级字符
+ * @param level 日志等级
+ * @param color 返回颜色前缀
+ * @param level_char 返回等级字符
+ */
+static void Log_LevelStyle(const LogLevel_t level, const char** color, char* level_char) {
+    switch (level) {
+        case LOG_LEVEL_ERROR:
+            *color      = COLOR_RED;
+            *level_char = 'E';
+            break;
+        case LOG_LEVEL_WARN:
+            *color      = COLOR_YELLOW;
+            *level_char = 'W';
+            break;
+        case LOG_LEVEL_INFO:
+            *color      = COLOR_GREEN;
+            *level_char = 'I';
+            break;
+        case LOG_LEVEL_DEBUG:
+            *color      = COLOR_BLUE;
+            *level_char = 'D';
+            break;
+        default:
+            *color      = "";
+            *level_char = ' ';
+            break;
+    }
+}
+
+#if !defined(__FILE_NAME__)
+/**
+ * @brief 文件名简化处理：去除路径，只保留文件名
+ * @param file __FILE__
+ * @return 文件名
+ * @note  编译器提供 __FILE_NAME__ 时调用点描述符里已是文件名，不再逐条扫描
+ */
+static const char* Log_ShortFile(const char* file) {
+    const char* short_file = strrchr(file, '/');
+    if (!short_file) short_file = strrchr(file, '\\');
+    return short_file ? short_file + 1 : file;
+}
+#define LOG_SITE_FILE(site) Log_ShortFile((site)->file)
+#else
+#define LOG_SITE_FILE(site) ((site)->file)
+#endif
+
+/* ================= 时间戳 ================= */
+/* 记录里的 32 位原始计数按输出顺序扩展成 64 位：DWT 在 168MHz 下约 25.5 s 回绕一次，
+ * 所以先按毫秒计数推算当前计数值，时间戳与推算值相差不超过半个回绕周期即可正确扩展 */
+static uint64_t s_log_time_base; /* 见过的最新时刻 (时间源计数) */
+static uint32_t s_log_time_ms;   /* s_log_time_base 对应的毫秒计数 */
+static uint64_t s_log_time_prev; /* 上一条日志的时刻，用于计算间隔 */
+
+static inline uint32_t Log_ClockHz(void) {
+    const uint32_t hz = s_log_clock_hz;
+    return (hz != 0u) ? hz : hal_get_cycles_hz();
+}
+
+/**
+ * @brief 把 32 位时间戳扩展成 64 位
+ * @param stamp 时间戳 (时间源计数)
+ * @return 64 位时刻 (时间源计数)
+ * @note  并发写入的记录可能比前一条早一点，按有符号差值处理，不会被当成回绕；
+ *        调用方负责互斥 (没有除法，可以放在临界区内)
+ */
+static uint64_t Log_TimeExtend(const uint32_t stamp) {
+    const uint32_t ms     = hal_get_tick_ms();
+    const uint32_t per_ms = Log_ClockHz() / 1000u;
+    const uint64_t guess  = s_log_time_base + (uint64_t)(ms - s_log_time_ms) * per_ms;
+    const int32_t d       = (int32_t)(stamp - (uint32_t)guess);
+    if (d < 0 && (uint64_t)(-(int64_t)d) > guess) return 0;
+    const uint64_t t = guess + (uint64_t)(int64_t)d;
+    if (t > s_log_time_base) {
+        s_log_time_base = t;
+        s_log_time_ms   = ms;
+    }
+    return t;
+}
+
+/**
+ * @brief 时间源计数折算成 us（64 位除法，只在输出侧调用）
+ */
+static uint64_t Log_TimeToUs(const uint64_t t) {
+    const uint32_t hz = Log_ClockHz();
+    return (t / hz) * 1000000u + (t % hz) * 1000000u / hz;
+}
+
+/**
+ * @brief 拼装日志头: [秒.微秒 +间隔us] L/TAG file:line:
+ * @param stamp 时间戳 (时间源计数)
+ * @return snprintf 的返回值（未截断长度）
+ * @note  只在 LogTask 或同步输出路径中调用：间隔是相对上一条输出的日志
+ */
+static int Log_FormatHead(char* buf, const uint32_t cap, const LogLevel_t level,
+                          const uint32_t stamp, const log_site_t* site) {
+    const char* color;
+    char level_char;
+    Log_LevelStyle(level, &color, &level_char);
+
+    osal_crit_state_t state;
+    OSAL_enter_critical_ex(&state);
+    const uint64_t now  = Log_TimeExtend(stamp);
+    const uint64_t prev = s_log_time_prev;
+    s_log_time_prev     = now;
+    OSAL_exit_critical_ex(state);
+
+    /* 折算放在临界区外 */
+    const uint64_t t   = Log_TimeToUs(now);
+    const int64_t gap  = (now >= prev) ? (int64_t)Log_TimeToUs(now - prev)
+                                       : -(int64_t)Log_TimeToUs(prev - now);
+    const uint32_t sec = (uint32_t)(t / 1000000u);
+    const long delta   = (long)CLAMP(gap, -(int64_t)INT32_MAX, (int64_t)INT32_MAX);
+    return snprintf_my(buf, cap, "%s[%lu.%06lu %+ld] %c/%s %s:%u: ", color, (unsigned long)sec,
+                       (unsigned long)(t - (uint64_t)sec * 1000000u), delta, level_char,
+                       site->tag, LOG_SITE_FILE(site), (unsigned)site->line);
+}
+
+/* ================= HEX 渲染 ================= */
+/* 字节 -> 两个十六进制字符的查找表：每字节一次半字读写，不做移位/分支 */
+#define LOG_HEX_DIGIT(x) (char)((x) < 10 ? '0' + (x) : 'A' - 10 + (x))
+#define LOG_HEX_PAIR(n)  {LOG_HEX_DIGIT((n) >> 4), LOG_HEX_DIGIT((n) & 0xF)}
+#define LOG_HEX_ROW(h)                                                                       \
+    LOG_HEX_PAIR((h) * 16 + 0), LOG_HEX_PAIR((h) * 16 + 1), LOG_HEX_PAIR((h) * 16 + 2),      \
+        LOG_HEX_PAIR((h) * 16 + 3), LOG_HEX_PAIR((h) * 16 + 4), LOG_HEX_PAIR((h) * 16 + 5),  \
+        LOG_HEX_PAIR((h) * 16 + 6), LOG_HEX_PAIR((h) * 16 + 7), LOG_HEX_PAIR((h) * 16 + 8),  \
+        LOG_HEX_PAIR((h) * 16 + 9), LOG_HEX_PAIR((h) * 16 + 10), LOG_HEX_PAIR((h) * 16 + 11), \
+        LOG_HEX_PAIR((h) * 16 + 12), LOG_HEX_PAIR((h) * 16 + 13), LOG_HEX_PAIR((h) * 16 + 14), \
+        LOG_HEX_PAIR((h) * 16 + 15)
+static const char s_log_hex_lut[256][2] = {
+    LOG_HEX_ROW(0),  LOG_HEX_ROW(1),  LOG_HEX_ROW(2),  LOG_HEX_ROW(3),
+    LOG_HEX_ROW(4),  LOG_HEX_ROW(5),  LOG_HEX_ROW(6),  LOG_HEX_ROW(7),
+    LOG_HEX_ROW(8),  LOG_HEX_ROW(9),  LOG_HEX_ROW(10), LOG_HEX_ROW(11),
+    LOG_HEX_ROW(12), LOG_HEX_ROW(13), LOG_HEX_ROW(14), LOG_HEX_ROW(15),
+};
+#undef LOG_HEX_ROW
+#undef LOG_HEX_PAIR
+#undef LOG_HEX_DIGIT
+
+/* HEX 行主体最大长度: "偏移: " + 每字节 3 字符 + 半行处空格 + "|ASCII|" + 尾部 */
+#define LOG_HEX_BODY_MAX \
+    (10u + LOG_HEX_BYTES_PER_LINE * 3u + 1u + LOG_HEX_BYTES_PER_LINE + 2u + sizeof(s_log_tail) - 1u)
+
+/* 行缓冲区至少留一半给日志头 */
+CORE_STATIC_ASSERT(LOG_HEX_BODY_MAX * 2u <= LOG_LINE_MAX, log_hex_line_too_long);
+
+/* HEX 行输出方式：LogTask 写分发环，调度器启动前/同步模式直接输出 */
+typedef void (*log_hex_emit_t)(LogLevel_t level, const char* line, uint32_t len);
+
+/**
+ * @brief 渲染一行 HEX 主体: "偏移: XX XX ... |ASCII|" + 尾部
+ * @param out 输出区（>= LOG_HEX_BODY_MAX）
+ * @param off 本行首字节在整段数据中的偏移
+ * @param p 本行数据
+ * @param n 本行字节数（<= LOG_HEX_BYTES_PER_LINE）
+ * @return 写入的字节数（不含 '\0'）
+ */
+static uint32_t Log_HexBody(char* out, const uint32_t off, const uint8_t* p, const uint32_t n) {
+    char* o = out;
+    memcpy(o + 0, s_log_hex_lut[(off >> 24) & 0xFFu], 2);
+    memcpy(o + 2, s_log_hex_lut[(off >> 16) & 0xFFu], 2);
+    memcpy(o + 4, s_log_hex_lut[(off >> 8) & 0xFFu], 2);
+    memcpy(o + 6, s_log_hex_lut[off & 0xFFu], 2);
+    o[8] = ':';
+    o[9] = ' ';
+    o += 10;
+
+    for (uint32_t i = 0; i < LOG_HEX_BYTES_PER_LINE; i++) {
+        if (i < n) {
+            memcpy(o, s_log_hex_lut[p[i]], 2);
+        } else {
+            o[0] = ' ';
+            o[1] = ' ';
+        }
+        o[2] = ' ';
+        o += 3;
+        /* 半行处额外空格 */
+        if (i + 1 == LOG_HEX_BYTES_PER_LINE / 2) *o++ = ' ';
+    }
+
+    /* ASCII 区：不可打印字符 (含中文) 显示为 '.' */
+    *o++ = '|';
+    for (uint32_t i = 0; i < LOG_HEX_BYTES_PER_LINE; i++) {
+        const uint8_t c = (i < n) ? p[i] : (uint8_t)' ';
+        *o++            = ((uint8_t)(c - 32u) < 95u) ? (char)c : '.';
+    }
+    *o++ = '|';
+
+    memcpy(o, s_log_tail, sizeof(s_log_tail) - 1);
+    o += sizeof(s_log_tail) - 1;
+    return (uint32_t)(o - out);
+}
+
+/**
+ * @brief 把一段数据渲染成 HEX 行并逐行输出（日志头只格式化一次，各行复用）
+ * @param level 日志等级
+ * @param stamp 时间戳 (时间源计数)
+ * @param site 调用点描述符
+ * @param off 本段首字节在整段数据中的偏移
+ * @param p 数据
+ * @param len 字节数（0 时输出一行 "HEX len=0"）
+ * @param line 行缓冲区
+ * @param cap 行缓冲区大小（> LOG_HEX_BODY_MAX）
+ * @param emit 每行的输出方式
+ */
+static void Log_HexLines(const LogLevel_t level, const uint32_t stamp, const log_site_t* site,
+                         const uint32_t off, const uint8_t* p, const uint32_t len, char* line,
+                         const uint32_t cap, const log_hex_emit_t emit) {
+    const uint32_t limit = cap - LOG_HEX_BODY_MAX;
+    const int h          = Log_FormatHead(line, limit, level, stamp, site);
+    const uint32_t head  = (h < 0) ? 0 : MIN((uint32_t)h, limit - 1);
+
+    if (len == 0) {
+        static const char empty[] = "HEX len=0";
+        memcpy(line + head, empty, sizeof(empty) - 1);
+        memcpy(line + head + sizeof(empty) - 1, s_log_tail, sizeof(s_log_tail) - 1);
+        emit(level, line, head + sizeof(empty) - 1 + sizeof(s_log_tail) - 1);
+        return;
+    }
+    for (uint32_t i = 0; i < len; i += LOG_HEX_BYTES_PER_LINE) {
+        const uint32_t n = MIN(len - i, LOG_HEX_BYTES_PER_LINE);
+        emit(level, line, head + Log_HexBody(line + head, off + i, p + i, n));
+    }
+}
+
+#if LOG_RATE_LIMIT_ENABLE
+/* ================= 限流与重复折叠 ================= */
+/* 每个 tag 一个令牌桶 + 最近一条消息；全零即满桶、无待报告。
+ * 任务与中断并发访问，各字段都是 32 位字，用 RB_CAS 更新，不进临界区 */
+#define LOG_RATE_MS_MASK     0x00FFFFFFu /* 令牌桶时刻只保留 ms 低 24 位 (约 4.6 小时回绕) */
+#define LOG_RATE_SPENT_SHIFT 24u
+
+CORE_STATIC_ASSERT(LOG_RATE_BURST < 0xFFu, log_rate_burst_too_big);
+
+typedef struct {
+    volatile uint32_t bucket;       // [31:24] 已用令牌数，[23:0] 上次补充令牌的时刻
+    volatile uint32_t limited;      // 令牌耗尽丢弃的条数 (待报告)
+    volatile uint32_t rep_key;      // 最近输出的消息：调用点 + 参数的哈希，0 表示无
+    volatile uint32_t rep_ms;       // 该消息本轮首次输出的时刻
+    volatile uint32_t repeats;      // 窗口内折叠掉的重复次数 (待报告)
+    const void* volatile rep_site;  // 该消息的调用点 (描述符 / 字典条目)，报告用
+    volatile uint8_t rep_level;     // 该消息的等级
+} log_rate_t;
+
+static log_rate_t s_log_rate[LOG_TAG_COUNT];
+/* 有 tag 存在待报告的计数：LogTask 据此补发摘要 */
+static volatile bool s_log_rate_pending = false;
+
+/**
+ * @brief 原子加一（LDREX/STREX 重试，不关中断）
+ */
+static inline void Log_AtomicInc(volatile uint32_t* p) {
+    uint32_t v = RB_LOAD_ACQUIRE(p);
+    while (!RB_CAS(p, &v, v + 1u)) {
+    }
+}
+
+/**
+ * @brief 原子取出并清零
+ * @return 取出的值
+ */
+static inline uint32_t Log_AtomicTake(volatile uint32_t* p) {
+    uint32_t v = RB_LOAD_ACQUIRE(p);
+    while (v != 0u && !RB_CAS(p, &v, 0u)) {
+    }
+    return v;
+}
+
+/**
+ * @brief 从令牌桶取一个令牌（先按流逝时间补充）
+ * @param r 限流状态
+ * @param now 当前时刻 (ms)
+ * @return 取到返回 true
+ */
+static bool Log_RateTake(log_rate_t* r, const uint32_t now) {
+    uint32_t b = RB_LOAD_ACQUIRE(&r->bucket);
+    for (;;) {
+        uint32_t spent   = b >> LOG_RATE_SPENT_SHIFT;
+        uint32_t last    = b & LOG_RATE_MS_MASK;
+        const uint32_t n = ((now - last) & LOG_RATE_MS_MASK) / LOG_RATE_REFILL_MS;
+        if (n != 0) {
+            spent = (n >= spent) ? 0 : spent - n;
+            /* 桶满后不再累计，否则长时间空闲后的第一条会从很早的时刻算起 */
+            last  = (spent == 0) ? now : last + n * LOG_RATE_REFILL_MS;
+        }
+        if (spent >= LOG_RATE_BURST) return false;
+
+        const uint32_t next = ((spent + 1u) << LOG_RATE_SPENT_SHIFT) | (last & LOG_RATE_MS_MASK);
+        if (RB_CAS(&r->bucket, &b, next)) return true;
+    }
+}
+
+/**
+ * @brief 退还一个令牌（被折叠的重复消息不占用输出配额）
+ * @param r 限流状态
+ */
+static void Log_RateRefund(log_rate_t* r) {
+    uint32_t b = RB_LOAD_ACQUIRE(&r->bucket);
+    while ((b >> LOG_RATE_SPENT_SHIFT) != 0u &&
+           !RB_CAS(&r->bucket, &b, b - (1u << LOG_RATE_SPENT_SHIFT))) {
+    }
+}
+
+/**
+ * @brief 输出重复折叠摘要 (摘要本身不受限流、不参与折叠)
+ * @param tag tag ID
+ * @param site 被折叠的调用点
+ * @param level 被折叠日志的等级
+ * @param repeats 折叠掉的次数
+ */
+static void Log_RepeatReport(const log_tag_t tag, const void* site, const uint8_t level,
+                             const uint32_t repeats) {
+    const log_site_t* at = &s_log_tag_site[tag];
+    if (site == NULL) return;
+#if LOG_TOKENIZED_ENABLE
+    /* 字典条目不在 Flash 中，只能报告 ID */
+    Log_PrintfAt((LogLevel_t)level, at, "上一条日志 (ID 0x%08lx) 又重复了 %lu 次",
+                 (unsigned long)(uintptr_t)site, (unsigned long)repeats);
+#else
+    const log_site_t* s = (const log_site_t*)site;
+    Log_PrintfAt((LogLevel_t)level, at, "上一条日志 (%s:%u) 又重复了 %lu 次", LOG_SITE_FILE(s),
+                 (unsigned)s->line, (unsigned long)repeats);
+#endif
+}
+
+/**
+ * @brief 输出限流摘要
+ * @param tag tag ID
+ * @param limited 丢弃的条数
+ */
+static void Log_LimitReport(const log_tag_t tag, const uint32_t limited) {
+    Log_PrintfAt(LOG_LEVEL_WARN, &s_log_tag_site[tag], "限流丢弃 %lu 条", (unsigned long)limited);
+}
+
+/**
+ * @brief 限流判定 (由 LOG_x 宏在求值参数、格式化之前调用)
+ * @param tag tag ID
+ * @return 允许输出返回 true
+ * @note  任务与中断均可调用，只用 CAS 更新令牌桶；令牌耗尽时整条丢弃，恢复后报告丢弃条数
+ */
+bool Log_RateAllow(const log_tag_t tag) {
+    if ((uint32_t)tag >= LOG_TAG_COUNT) return true;
+    log_rate_t* r = &s_log_rate[tag];
+
+    if (!Log_RateTake(r, hal_get_tick_ms())) {
+        Log_AtomicInc(&r->limited);
+        s_log_rate_pending = true;
+        return false;
+    }
+    const uint32_t limited = (r->limited != 0u) ? Log_AtomicTake(&r->limited) : 0u;
+    if (limited != 0u) Log_LimitReport(tag, limited);
+    return true;
+}
+
+/**
+ * @brief 32 位 FNV-1a 哈希
+ * @param h 初值（可串联多段）
+ * @param p 数据
+ * @param n 字节数
+ */
+static uint32_t Log_Hash(uint32_t h, const void* p, const uint32_t n) {
+    const uint8_t* b = (const uint8_t*)p;
+    for (uint32_t i = 0; i < n; i++) h = (h ^ b[i]) * 16777619u;
+    return h;
+}
+
+/**
+ * @brief 重复折叠判定：同一调用点且参数完全相同的消息在 LOG_REPEAT_WINDOW_MS 内只计数
+ * @param tag tag ID
+ * @param site 调用点标识 (描述符 / 字典条目)
+ * @param level 日志等级
+ * @param arg 参数内容（延迟模式为打包后的参数区，否则为格式化后的正文）
+ * @param len 参数内容字节数
+ * @return 需要输出返回 true；被折叠返回 false（退还 LOG_PASS 取走的令牌）
+ * @note  在格式化之前、参数已打包之后调用；换了消息时先带出上一条的重复次数。
+ *        并发折叠同一 tag 时计数可能记到相邻的消息上，只影响摘要的归属
+ */
+static bool Log_RepeatAllow(const log_tag_t tag, const void* site, const LogLevel_t level,
+                            const void* arg, const uint32_t len) {
+    if ((uint32_t)tag >= LOG_TAG_COUNT) return true;
+    log_rate_t* r = &s_log_rate[tag];
+
+    uint32_t key = Log_Hash(2166136261u, &site, sizeof(site));
+    key          = Log_Hash(key, arg, len);
+    if (key == 0u) key = 1u;
+
+    const uint32_t now = hal_get_tick_ms();
+    uint32_t cur       = RB_LOAD_ACQUIRE(&r->rep_key);
+    if (cur == key && now - r->rep_ms < LOG_REPEAT_WINDOW_MS) {
+        /* 窗口内的同一条消息：只计数，不占用令牌 */
+        Log_AtomicInc(&r->repeats);
+        Log_RateRefund(r);
+        s_log_rate_pending = true;
+        return false;
+    }
+
+    /* 换了消息或窗口已过：认领 rep_key 后带出上一轮的重复次数；被并发者抢先则照常输出 */
+    if (!RB_CAS(&r->rep_key, &cur, key)) return true;
+    const void* prev_site    = r->rep_site;
+    const uint8_t prev_level = r->rep_level;
+    r->rep_ms                = now;
+    r->rep_site              = site;
+    r->rep_level             = (uint8_t)level;
+    const uint32_t repeats   = (r->repeats != 0u) ? Log_AtomicTake(&r->repeats) : 0u;
+    if (repeats != 0u) Log_RepeatReport(tag, prev_site, prev_level, repeats);
+    return true;
+}
+
+#if LOG_ASYNC_ENABLE
+/**
+ * @brief 补发已到期的摘要 (LogTask 调用)
+ * @note  消息停止重复后，折叠/丢弃的计数不会再被下一条日志带出，由这里在窗口结束后输出
+ */
+static void Log_RateFlush(void) {
+    if (!s_log_rate_pending) return;
+    /* 先清标志再扫描：扫描期间新产生的计数会重新置位 */
+    s_log_rate_pending = false;
+    __DMB();
+
+    const uint32_t now = hal_get_tick_ms();
+    for (uint32_t i = 0; i < LOG_TAG_COUNT; i++) {
+        log_rate_t* r = &s_log_rate[i];
+        if (r->repeats != 0u && now - r->rep_ms >= LOG_REPEAT_WINDOW_MS) {
+            const void* site     = r->rep_site;
+            const uint8_t level  = r->rep_level;
+            const uint32_t count = Log_AtomicTake(&r->repeats);
+            if (count != 0u) Log_RepeatReport((log_tag_t)i, site, level, count);
+        }
+        if (r->limited != 0u && Log_RateTake(r, now)) {
+            const uint32_t count = Log_AtomicTake(&r->limited);
+            if (count != 0u) Log_LimitReport((log_tag_t)i, count);
+        }
+        if (r->repeats != 0u || r->limited != 0u) s_log_rate_pending = true;
+    }
+}
+#endif
+#else
+/* 关闭限流时不折叠重复消息 */
+static inline bool Log_RepeatAllow(const log_tag_t tag, const void* site, const LogLevel_t level,
+                                   const void* arg, const uint32_t len) {
+    (void)tag;
+    (void)site;
+    (void)level;
+    (void)arg;
+    (void)len;
+    return true;
+}
+#endif
+
+#if LOG_ASYNC_ENABLE
+/**
+ * @brief 把一条记录写入缓冲区（CAS 认领整条记录的空间后拷贝，不关中断、不加锁）
+ * @param hdr 记录头（len 由调用方填好）
+ * @param vec 负载分段
+ * @param cnt 段数（<= 3）
+ * @param in_isr 是否在中断中（只决定唤醒后台任务用哪个接口）
+ * @return 空间不足返回 RET_E_NO_MEM，整条丢弃
+ */
+static ret_code_t Log_PushRecord(const log_rec_hdr_t* hdr, const RingBufferConstVec* vec,
+                                 const uint32_t cnt, const bool in_isr) {
+    RingBufferConstVec rec_vec[4] = {{.ptr = (const uint8_t*)hdr, .len = sizeof(*hdr)}};
+    for (uint32_t i = 0; i < cnt && i < ARRAY_SIZE(rec_vec) - 1; i++) rec_vec[i + 1] = vec[i];
+
+    uint32_t written = 0;
+    const uint32_t n = MIN(cnt, ARRAY_SIZE(rec_vec) - 1) + 1;
+    const ret_code_t rc = in_isr ? RingBuffer_WriteVFromISR(&s_logRB, rec_vec, n, &written, false)
+                                 : RingBuffer_WriteV(&s_logRB, rec_vec, n, &written, false);
+    if (ret_is_err(rc)) {
+        /* 只计数，由 LogTask 汇总成一行报告，不在调用方打印 */
+        osal_crit_state_t state;
+        OSAL_enter_critical_ex(&state);
+        s_log_lost++;
+        OSAL_exit_critical_ex(state);
+    }
+    return rc;
+}
+
+/**
+ * @brief HEX 日志：只把原始字节按 LOG_HEX_REC_BYTES 分段压入缓冲区（不格式化、不加锁）
+ * @param level 日志等级
+ * @param site 调用点描述符
+ * @param p 数据（len 为 0 时可为 NULL）
+ * @param len 字节数
+ * @note  某段写不下时其余各段一并放弃（计入 s_log_lost）
+ */
+static void Log_PushHex(const LogLevel_t level, const log_site_t* site, const uint8_t* p,
+                        const uint32_t len) {
+    log_hex_rec_t rec = {.stamp = Log_Now(), .site = site, .off = 0};
+    const bool in_isr = OSAL_in_isr();
+    do {
+        const uint32_t n        = MIN(len - rec.off, LOG_HEX_REC_BYTES);
+        const log_rec_hdr_t hdr = {
+            .kind  = LOG_REC_HEX,
+            .level = (uint8_t)level,
+            .len   = (uint16_t)(sizeof(rec) + n),
+        };
+        const RingBufferConstVec vec[] = {
+            {.ptr = (const uint8_t*)&rec, .len = sizeof(rec)},
+            {.ptr = p + rec.off, .len = n},
+        };
+        if (ret_is_err(Log_PushRecord(&hdr, vec, (n != 0) ? 2u : 1u, in_isr))) break;
+        rec.off += n;
+    } while (rec.off < len);
+}
+#endif
+
+#if LOG_ASYNC_ENABLE && LOG_DEFERRED_ENABLE
+/* 转换说明对应的参数类型 */
+typedef enum {
+    LOG_ARG_NONE = 0, /* 无参数（%% 或不认识的转换） */
+    LOG_ARG_INT,      /* int 及提升后的 char/short */
+    LOG_ARG_LONG,
+    LOG_ARG_LLONG,
+    LOG_ARG_SIZE,     /* size_t / ptrdiff_t */
+    LOG_ARG_DOUBLE,   /* float 提升后的 double */
+    LOG_ARG_LDOUBLE,  /* long double，按 double 保存 */
+    LOG_ARG_PTR,
+    LOG_ARG_STR,      /* 字符串内联拷贝，调用返回后原缓冲区可以复用 */
+    LOG_ARG_SKIP,     /* %n：消耗一个指针，不保存也不输出 */
+} log_arg_t;
+
+/* 精度来自 '*' 参数 */
+#define LOG_PREC_STAR (-2)
+
+/**
+ * @brief 解析一个转换说明（调用方与后台任务共用，保证两侧对参数的理解一致）
+ * @param p 指向 '%' 之后的字符
+ * @param type 返回参数类型
+ * @param stars 返回宽度/精度中 '*' 的个数（每个额外消耗一个 int 参数）
+ * @param prec 返回精度：-1 无，LOG_PREC_STAR 来自参数，否则为字面值
+ * @return 转换字符之后的位置（格式串提前结束时指向 '\0'）
+ */
+static const char* Log_ScanSpec(const char* p, log_arg_t* type, uint8_t* stars, int32_t* prec) {
+    *type  = LOG_ARG_NONE;
+    *stars = 0;
+    *prec  = -1;
+    while (*p == '-' || *p == '+' || *p == ' ' || *p == '#' || *p == '0') p++;
+    if (*p == '*') {
+        (*stars)++;
+        p++;
+    } else {
+        while (*p >= '0' && *p <= '9') p++;
+    }
+    if (*p == '.') {
+        p++;
+        if (*p == '*') {
+            (*stars)++;
+            *prec = LOG_PREC_STAR;
+            p++;
+        } else {
+            *prec = 0;
+            while (*p >= '0' && *p <= '9') *prec = *prec * 10 + (*p++ - '0');
+        }
+    }
+
+    uint8_t longs = 0;
+    bool is_size  = false;
+    for (;; p++) {
+        if (*p == 'l') {
+            longs++;
+        } else if (*p == 'j' || *p == 'q' || *p == 'L') {
+            longs = 2;
+        } else if (*p == 'z' || *p == 't') {
+            is_size = true;
+        } else if (*p != 'h') {
+            break;
+        }
+    }
+
+    switch (*p) {
+        case '\0':
+            return p;
+        case 'd':
+        case 'i':
+        case 'u':
+        case 'o':
+        case 'x':
+        case 'X':
+        case 'c':
+            *type = is_size      ? LOG_ARG_SIZE
+                    : longs >= 2 ? LOG_ARG_LLONG
+                    : longs == 1 ? LOG_ARG_LONG
+                                 : LOG_ARG_INT;
+            break;
+        case 'f':
+        case 'F':
+        case 'e':
+        case 'E':
+        case 'g':
+        case 'G':
+        case 'a':
+        case 'A':
+            *type = (longs >= 2) ? LOG_ARG_LDOUBLE : LOG_ARG_DOUBLE;
+            break;
+        case 'p':
+            *type = LOG_ARG_PTR;
+            break;
+        case 's':
+            *type = LOG_ARG_STR;
+            break;
+        case 'n':
+            *type = LOG_ARG_SKIP;
+            break;
+        default:
+            break;
+    }
+    return p + 1;
+}
+
+/**
+ * @brief 向参数区追加 n 字节
+ * @return 放不下返回 false
+ */
+static inline bool Log_ArgPut(uint8_t* out, const uint32_t cap, uint32_t* pos, const void* v,
+                              const uint32_t n) {
+    if (cap - *pos < n) return false;
+    memcpy(out + *pos, v, n);
+    *pos += n;
+    return true;
+}
+
+/**
+ * @brief 从参数区取出 n 字节
+ * @return 参数区已耗尽返回 false
+ */
+static inline bool Log_ArgTake(const uint8_t* arg, const uint32_t len, uint32_t* pos, void* v,
+                               const uint32_t n) {
+    if (len - *pos < n) return false;
+    memcpy(v, arg + *pos, n);
+    *pos += n;
+    return true;
+}
+
+/**
+ * @brief 按格式串把可变参数原样打包（调用方侧：只搬运字节，不做任何格式化）
+ * @param fmt 格式串
+ * @param args 参数列表
+ * @param out 参数区
+ * @param cap 参数区大小
+ * @return 打包的字节数；放不下时停在该参数之前，后台任务对其后的转换输出 "?"
+ */
+static uint32_t Log_PackArgs(const char* fmt, va_list args, uint8_t* out, const uint32_t cap) {
+    uint32_t pos = 0;
+    for (const char* p = fmt; *p != '\0';) {
+        if (*p++ != '%') continue;
+
+        log_arg_t type;
+        uint8_t stars;
+        int32_t prec;
+        p            = Log_ScanSpec(p, &type, &stars, &prec);
+
+        /* '*' 宽度/精度：按出现顺序保存 */
+        int star_val = 0;
+        for (uint8_t i = 0; i < stars; i++) {
+            star_val = va_arg(args, int);
+            if (!Log_ArgPut(out, cap, &pos, &star_val, sizeof(star_val))) return pos;
+        }
+        if (prec == LOG_PREC_STAR) prec = star_val;
+
+        bool ok = true;
+        switch (type) {
+            case LOG_ARG_INT: {
+                const int v = va_arg(args, int);
+                ok          = Log_ArgPut(out, cap, &pos, &v, sizeof(v));
+                break;
+            }
+            case LOG_ARG_LONG: {
+                const long v = va_arg(args, long);
+                ok           = Log_ArgPut(out, cap, &pos, &v, sizeof(v));
+                break;
+            }
+            case LOG_ARG_LLONG: {
+                const long long v = va_arg(args, long long);
+                ok                = Log_ArgPut(out, cap, &pos, &v, sizeof(v));
+                break;
+            }
+            case LOG_ARG_SIZE: {
+                const size_t v = va_arg(args, size_t);
+                ok             = Log_ArgPut(out, cap, &pos, &v, sizeof(v));
+                break;
+            }
+            case LOG_ARG_DOUBLE: {
+                const double v = va_arg(args, double);
+                ok             = Log_ArgPut(out, cap, &pos, &v, sizeof(v));
+                break;
+            }
+            case LOG_ARG_LDOUBLE: {
+                const double v = (double)va_arg(args, long double);
+                ok             = Log_ArgPut(out, cap, &pos, &v, sizeof(v));
+                break;
+            }
+            case LOG_ARG_PTR: {
+                const void* v = va_arg(args, void*);
+                ok            = Log_ArgPut(out, cap, &pos, &v, sizeof(v));
+                break;
+            }
+            case LOG_ARG_STR: {
+                /* 调用方的字符串可能在栈上：内联拷贝（受精度与 LOG_DEFER_STR_MAX 限制）并补 '\0' */
+                const char* str = va_arg(args, const char*);
+                if (str == NULL) str = "(null)";
+                const uint32_t max =
+                    (prec >= 0) ? MIN((uint32_t)prec, LOG_DEFER_STR_MAX) : LOG_DEFER_STR_MAX;
+                if (cap - pos < 1) return pos;
+                uint32_t n = 0;
+                while (n < max && n < cap - pos - 1 && str[n] != '\0') n++;
+                memcpy(out + pos, str, n);
+                out[pos + n] = '\0';
+                pos += n + 1;
+                break;
+            }
+            case LOG_ARG_SKIP:
+                (void)va_arg(args, void*);
+                break;
+            default:
+                break;
+        }
+        if (!ok) return pos;
+    }
+    return pos;
+}
+
+/**
+ * @brief 后台任务侧：按格式串把打包的参数逐个格式化
+ * @param out 输出区
+ * @param cap 输出区大小（含结尾 '\0'）
+ * @param fmt 格式串
+ * @param arg 参数区
+ * @param len 参数区字节数
+ * @return 写入的字符数（不含 '\0'）
+ */
+static uint32_t Log_RenderArgs(char* out, const uint32_t cap, const char* fmt, const uint8_t* arg,
+                               const uint32_t len) {
+    if (cap == 0) return 0;
+    uint32_t pos = 0;
+    uint32_t at  = 0;
+    bool dry     = false; /* 参数区已耗尽 */
+
+    for (const char* p = fmt; *p != '\0' && pos + 1 < cap;) {
+        if (*p != '%') {
+            out[pos++] = *p++;
+            continue;
+        }
+        if (p[1] == '%') {
+            out[pos++] = '%';
+            p += 2;
+            continue;
+        }
+
+        log_arg_t type;
+        uint8_t stars;
+        int32_t prec;
+        const char* start = p;
+        const char* end   = Log_ScanSpec(p + 1, &type, &stars, &prec);
+        p                 = end;
+
+        /* 重建单个转换说明，'*' 替换为保存的数值（负精度等同于未指定） */
+        char spec[32];
+        uint32_t k = 0;
+        for (const char* q = start; q < end && !dry && k + 12 < sizeof(spec); q++) {
+            if (*q != '*') {
+                spec[k++] = *q;
+                continue;
+            }
+            int v = 0;
+            if (!Log_ArgTake(arg, len, &at, &v, sizeof(v))) {
+                dry = true;
+                break;
+            }
+            if (v < 0 && k > 0 && spec[k - 1] == '.') {
+                k--;
+                continue;
+            }
+            k += (uint32_t)snprintf_my(spec + k, sizeof(spec) - k, "%d", v);
+        }
+        spec[k] = '\0';
+
+        char* dst          = out + pos;
+        const uint32_t rem = cap - pos;
+        int n              = 0;
+        if (dry || k + 12 >= sizeof(spec)) {
+            n = snprintf_my(dst, rem, "?");
+        } else {
+            switch (type) {
+#define LOG_RENDER_AS(T)                                                  \
+    do {                                                                  \
+        T v;                                                              \
+        if (Log_ArgTake(arg, len, &at, &v, sizeof(v)))                    \
+            n = snprintf_my(dst, rem, spec, v);                           \
+        else                                                              \
+            dry = true, n = snprintf_my(dst, rem, "?");                   \
+    } while (0)
+                case LOG_ARG_INT:
+                    LOG_RENDER_AS(int);
+                    break;
+                case LOG_ARG_LONG:
+                    LOG_RENDER_AS(long);
+                    break;
+                case LOG_ARG_LLONG:
+                    LOG_RENDER_AS(long long);
+                    break;
+                case LOG_ARG_SIZE:
+                    LOG_RENDER_AS(size_t);
+                    break;
+                case LOG_ARG_DOUBLE:
+                case LOG_ARG_LDOUBLE:
+                    LOG_RENDER_AS(double);
+                    break;
+                case LOG_ARG_PTR:
+                    LOG_RENDER_AS(void*);
+                    break;
+#undef LOG_RENDER_AS
+                case LOG_ARG_STR: {
+                    const char* str = (const char*)arg + at;
+                    const void* nul = (at < len) ? memchr(str, '\0', len - at) : NULL;
+                    if (nul == NULL) {
+                        dry = true;
+                        n   = snprintf_my(dst, rem, "?");
+                    } else {
+                        at = (uint32_t)((const uint8_t*)nul - arg) + 1;
+                        n  = snprintf_my(dst, rem, spec, str);
+                    }
+                    break;
+                }
+                case LOG_ARG_SKIP:
+                    break;
+                default:
+                    /* 不认识的转换：原样输出 */
+                    n = snprintf_my(dst, rem, "%s", spec);
+                    break;
+            }
+        }
+        if (n > 0) pos += MIN((uint32_t)n, rem - 1);
+    }
+    out[pos] = '\0';
+    return pos;
+}
+
+/**
+ * @brief 延迟模式：只把 fmt 指针和原始参数压入缓冲区（不加锁，任务和中断均可调用）
+ * @param collapse 是否参与重复折叠（模块内部的摘要不参与）
+ */
+static void Log_PushDeferred(const LogLevel_t level, const log_site_t* site, const char* fmt,
+                             va_list args, const bool collapse) {
+    const log_fmt_rec_t rec = {
+        .stamp = Log_Now(),
+        .site  = site,
+        .fmt   = fmt,
+    };
+    uint8_t arg_buf[LOG_DEFER_ARGS_MAX];
+    const uint32_t arg_len = Log_PackArgs(fmt, args, arg_buf, sizeof(arg_buf));
+    /* 打包后的参数就是消息内容：调用点与参数都相同才折叠 */
+    if (collapse && !Log_RepeatAllow((log_tag_t)site->tag_id, site, level, arg_buf, arg_len)) {
+        return;
+    }
+
+    const log_rec_hdr_t hdr = {
+        .kind  = LOG_REC_FMT,
+        .level = (uint8_t)level,
+        .len   = (uint16_t)(sizeof(rec) + arg_len),
+    };
+    const RingBufferConstVec vec[] = {
+        {.ptr = (const uint8_t*)&rec, .len = sizeof(rec)},
+        {.ptr = arg_buf, .len = arg_len},
+    };
+    /* 缓冲区满时整条丢弃（计入 s_log_lost），不在热路径上打印 */
+    (void)Log_PushRecord(&hdr, vec, ARRAY_SIZE(vec), OSAL_in_isr());
+}
+#endif
+#if LOG_ASYNC_ENABLE
+/**
+ * @brief 后台任务侧：把一条文本/延迟格式化记录渲染成完整日志行（日志头 + 正文 + 尾部）
+ * @param level 日志等级
+ * @param payload 记录负载
+ * @param len 负载字节数
+ * @param out 输出区（>= LOG_REC_PAYLOAD_MAX）
+ * @param cap 输出区大小
+ * @return 日志行长度，记录损坏返回 0
+ */
+static uint32_t Log_RenderRecord(const LogLevel_t level, const uint8_t* payload,
+                                 const uint32_t len, char* out, const uint32_t cap) {
+    log_fmt_rec_t rec;
+    if (len < sizeof(rec) || cap < sizeof(s_log_tail) + 1) return 0;
+    memcpy(&rec, payload, sizeof(rec));
+
+    /* 为尾部预留空间 */
+    const uint32_t limit = cap - (sizeof(s_log_tail) - 1);
+    const int head       = Log_FormatHead(out, limit, level, rec.stamp, rec.site);
+    uint32_t pos         = (head < 0) ? 0 : MIN((uint32_t)head, limit - 1);
+    const uint8_t* body  = payload + sizeof(rec);
+    const uint32_t n     = len - sizeof(rec);
+    if (rec.fmt == NULL) {
+        /* 文本记录：调用方已格式化好正文 */
+        const uint32_t c = MIN(n, limit - 1 - pos);
+        memcpy(out + pos, body, c);
+        pos += c;
+    } else {
+#if LOG_DEFERRED_ENABLE
+        pos += Log_RenderArgs(out + pos, limit - pos, rec.fmt, body, n);
+#endif
+    }
+    memcpy(out + pos, s_log_tail, sizeof(s_log_tail) - 1);
+    return pos + sizeof(s_log_tail) - 1;
+}
+
+/**
+ * @brief 取序号 seq 的记录描述符
+ */
+static inline log_out_desc_t Log_OutDesc(const uint32_t seq) {
+    return s_log_desc[seq & LOG_FANOUT_DESC_MASK];
+}
+
+/**
+ * @brief 启动该后端的下一笔发送（LogTask 或发送完成中断中调用，调用方已独占该后端）
+ * @param s 后端槽
+ * @return 启动成功返回 true；没有可发的记录或后端暂时忙返回 false
+ * @note  先跳过等级不够的记录，再把其后连续的可发记录合成一笔：分发环内字节首尾相接，
+ *        到环末尾为止一次 send_async，跨越末尾的部分在完成中断里接着发
+ */
+static bool Log_SinkStart(log_sink_t* s) {
+    const uint32_t end = RB_LOAD_ACQUIRE(&s_log_seq);
+    while (s->next != end) {
+        const log_out_desc_t d = Log_OutDesc(s->next);
+        if (d.level <= s->level && d.len != 0) break;
+        if (BroadcastRing_ReadCommit(s->cur, d.len) != RET_OK) {
+            s->lost = true;
+            return false;
+        }
+        s->next++;
+    }
+
+    uint32_t count = 0;
+    uint32_t total = 0;
+    while (s->next + count != end) {
+        const log_out_desc_t d = Log_OutDesc(s->next + count);
+        if (d.level > s->level || d.len == 0 || total + d.len > UINT16_MAX) break;
+        total += d.len;
+        count++;
+    }
+    if (count == 0) return false;
+
+    RingBufferSpan sp;
+    uint32_t g;
+    if (BroadcastRing_ReadReserve(s->cur, total, &sp, &g) != RET_OK || g != total) {
+        s->lost = true;
+        return false;
+    }
+    /* 完成中断可能在 send_async 返回前到来：先把在途信息填好 */
+    s->pending   = total;
+    s->p2        = sp.p2;
+    s->n2        = sp.n2;
+    const int tx = s->b.send_async(sp.p1, (uint16_t)sp.n1, s->b.user);
+    if (tx == RET_E_BUSY) {
+        /* 后端暂时忙：记录留在原处，下一条日志到达时再试 */
+        s->pending = 0;
+        s->n2      = 0;
+        return false;
+    }
+    s->next += count;
+    if (tx == RET_OK) return true;
+    /* 其它错误：丢弃这几条 */
+    s->pending = 0;
+    s->n2      = 0;
+    if (BroadcastRing_ReadCommit(s->cur, total) != RET_OK) s->lost = true;
+    return false;
+}
+
+/**
+ * @brief 摘下后端的分发环读游标，未发出的记录计入丢弃（仅 LogTask 调用）
+ * @param s 后端槽
+ */
+static void Log_SinkDetach(log_sink_t* s) {
+    if (s->cur == NULL) return;
+    s->dropped += s_log_seq - s->next;
+    BroadcastRing_Detach(s->cur);
+    s->cur = NULL;
+}
+
+/**
+ * @brief 给后端挂接分发环读游标（仅 LogTask 或 Log_Init 调用：此时没有写入在进行）
+ * @param s 后端槽
+ * @note  游标从当前写位置开始，序号同时取当前已发布的记录数，两者才能一一对应；
+ *        失配的游标摘下重挂，期间的记录计入丢弃
+ */
+static void Log_SinkAttach(log_sink_t* s) {
+    Log_SinkDetach(s);
+    BroadcastCursor* cur = NULL;
+    if (ret_is_err(BroadcastRing_Attach(&s_logBR, s->b.name ? s->b.name : "log", &cur))) return;
+    s->next = s_log_seq;
+    s->lost = false;
+    s->cur  = cur;
+}
+
+/**
+ * @brief 让所有空闲的后端开始发送（仅 LogTask 调用）
+ * @note  新注册的后端在这里挂接游标；失配的游标在这里重挂
+ */
+static void Log_KickSinks(void) {
+    for (uint32_t i = 0; i < LOG_BACKEND_MAX; i++) {
+        log_sink_t* s = &s_log_sinks[i];
+        if (!s->used || s->busy) continue;
+        if (s->cur == NULL || s->lost) Log_SinkAttach(s);
+        if (s->cur == NULL) continue;
+        /* 空闲的后端没有在途发送，也就不会有完成中断来抢 */
+        s->busy = true;
+        if (!Log_SinkStart(s)) s->busy = false;
+    }
+}
 
-/* ================= 外部依赖 ================= */
+/**
+ * @brief 后端在途发送超时未完成：收回或放弃这笔发送（仅 LogTask 调用，hold 已置位）
+ * @param s 后端槽
+ * @note  中止成功时 DMA 不再读在途数据，由本任务提交，后端继续使用；
+ *        不能中止时 DMA 可能仍在读，不能把这段空间还给生产者，也不能启动新的发送：
+ *        置 lost/stale、保持 busy，由调用方摘下游标，迟到的完成通知到来后才重新挂接
+ */
+static void Log_SinkStall(log_sink_t* s) {
+    const bool aborted = (s->b.abort != NULL) && (s->b.abort(s->b.user) == RET_OK);
+
+    osal_crit_state_t state;
+    OSAL_enter_critical_ex(&state);
+    /* 超时到中止之间完成中断可能已收尾（hold 置位时它不会续发），或已续发第二段 */
+    if (!s->busy) {
+        OSAL_exit_critical_ex(state);
+        return;
+    }
+    s->n2 = 0;
+    if (!aborted) {
+        s->stale = true;
+        s->lost  = true;
+        OSAL_exit_critical_ex(state);
+        return;
+    }
+    s->busy = false;
+    OSAL_exit_critical_ex(state);
 
-/* ================= 变量定义 ================= */
-static log_backend_t s_log_backend = {
-    .send_async = NULL,
-    .user       = NULL,
-};
-static bool s_log_backend_ready = 0;
-/* 互斥量句柄：用于保护日志缓冲区，防止多线程同时写入导致乱码 */
-static osal_mutex_t s_logMutex  = NULL;
+    if (BroadcastRing_ReadCommit(s->cur, s->pending) != RET_OK) s->lost = true;
+    s->pending = 0;
+}
 
-#if LOG_ASYNC_ENABLE
-/* 异步模式资源 */
-static RingBuffer s_logRB; /* 环形缓冲区实例 */
+/**
+ * @brief 写入 total 字节前，为落后的后端整条丢弃最旧的记录腾出空间
+ * @param total 即将写入的字节数
+ * @note  字节或描述符不够时，只等在途的那一笔发完（不能覆盖 DMA 正在读的数据），
+ *        再把积压丢到半个环以内，下一次追上要再写半个环，慢后端不会拖慢其他后端
+ */
+static void Log_FanoutMakeRoom(const uint32_t total) {
+    const uint32_t room = s_logBR.size - total;
+    for (uint32_t i = 0; i < LOG_BACKEND_MAX; i++) {
+        log_sink_t* s = &s_log_sinks[i];
+        if (!s->used || s->cur == NULL) continue;
+        if (BroadcastRing_GetUsedSize(s->cur) <= room &&
+            s_log_seq - s->next < LOG_FANOUT_RECORDS) {
+            continue;
+        }
 
-/* 后台发送任务的线程 ID */
-static osal_thread_t s_logTaskHandle = NULL;
+        s->hold = true;
+        __DMB();
+        while (s->busy && !s->stale) {
+            if (OSAL_thread_flags_wait(LOG_TX_DONE_FLAG, OSAL_FLAGS_WAIT_ANY,
+                                       LOG_BACKEND_STALL_MS) == 0) {
+                /* 后端卡死：中止这笔发送，不能中止则放弃该后端 */
+                Log_SinkStall(s);
+            }
+        }
+        /* 后端已空闲，没有完成中断来抢：由本任务跳过最旧的整条记录 */
+        while (!s->lost && s->next != s_log_seq &&
+               (BroadcastRing_GetUsedSize(s->cur) > MIN(room, s_logBR.size / 2u) ||
+                s_log_seq - s->next >= LOG_FANOUT_RECORDS / 2u)) {
+            const log_out_desc_t d = Log_OutDesc(s->next);
+            if (BroadcastRing_ReadCommit(s->cur, d.len) != RET_OK) s->lost = true;
+            if (d.level <= s->level) s->dropped++;
+            s->next++;
+        }
+        /* 失配的游标不再为它保留空间；发送仍悬而未决的后端只摘下，等完成通知后再挂接 */
+        if (s->lost) {
+            if (s->busy) {
+                Log_SinkDetach(s);
+            } else {
+                Log_SinkAttach(s);
+            }
+        }
+        s->hold = false;
+    }
+}
 
-#else
-/* 同步模式下的互斥量属性 */
-static const osMutexAttr_t logMutex_attr = {"LogMutex", osMutexRecursive, NULL, 0};
-#endif
+/**
+ * @brief 把一条渲染好的日志写入分发环并通知空闲的后端
+ * @param level 日志等级
+ * @param p1 第一段
+ * @param n1 第一段长度
+ * @param p2 第二段（可为 NULL）
+ * @param n2 第二段长度
+ * @note  先写描述符与字节，最后发布序号：后端看到序号时两者都已就绪
+ */
+static void Log_Fanout(const uint8_t level, const uint8_t* p1, const uint32_t n1,
+                       const uint8_t* p2, const uint32_t n2) {
+    const uint32_t len = n1 + n2;
+    if (len == 0) return;
+    const RingBufferConstVec vec[] = {
+        {.ptr = p1, .len = n1},
+        {.ptr = p2, .len = n2},
+    };
+    Log_FanoutMakeRoom(len);
+
+    const uint32_t seq                     = s_log_seq;
+    s_log_desc[seq & LOG_FANOUT_DESC_MASK] = (log_out_desc_t){.len = (uint16_t)len, .level = level};
+    (void)BroadcastRing_WriteV(&s_logBR, vec, (n2 != 0) ? 2u : 1u);
+    RB_STORE_RELEASE(&s_log_seq, seq + 1u);
+    /* 先发布记录再检查后端是否空闲：与完成中断“无数据可发才置闲”配对，不会漏发 */
+    __DMB();
+    Log_KickSinks();
+}
 
-/* ================= 内部任务实现 ================= */
 /**
- * @brief 判断是否初始化发送端
- * @return
+ * @brief 空闲时按当前时间推进 64 位时间基准（长时间没有日志时推算起点也不会太旧）
  */
-static inline uint8_t Log_BackendReady(void) {
-    return s_log_backend_ready;
+static void Log_TimeSync(void) {
+    const uint32_t now = Log_Now();
+    osal_crit_state_t state;
+    OSAL_enter_critical_ex(&state);
+    (void)Log_TimeExtend(now);
+    OSAL_exit_critical_ex(state);
 }
 
 /**
- * @brief 查询返回后端配置
- * @return
+ * @brief HEX 行输出方式：写入分发环（仅 LogTask 调用）
  */
-static inline const log_backend_t* Log_GetBackend(void) {
-    return &s_log_backend;
+static void Log_HexFanout(const LogLevel_t level, const char* line, const uint32_t len) {
+    Log_Fanout((uint8_t)level, (const uint8_t*)line, len, NULL, 0);
 }
-#if LOG_ASYNC_ENABLE
+
 /**
  * @brief 日志后台处理任务
- * @note  负责从 RingBuffer 取出数据并通过串口发送
+ * @note  从 RingBuffer 取出记录渲染成线上字节，写入分发环；各后端由自己的发送完成中断
+ *        续发积压的记录，DMA 直接读分发环，发送完成后才 ReadCommit 释放空间
  */
 void Log_Task_Entry(void* argument) {
-    static uint8_t send_buf[128];
+    /* 跨越末尾的记录拼接区与渲染结果只有本任务使用，放在静态区以减小任务栈 */
+    static uint8_t rec_buf[LOG_REC_PAYLOAD_MAX];
+    static char line_buf[LOG_REC_PAYLOAD_MAX];
+    log_rec_hdr_t hdr;
     uint32_t read_len;
+    RingBufferSpan span;
 
     for (;;) {
-        /* 等待：有新日志 或 上一笔发送完成（都可能触发继续flush） */
-        (void)OSAL_thread_flags_wait(LOG_TASK_FLAG | LOG_TX_DONE_FLAG, OSAL_FLAGS_WAIT_ANY,
-                                     OSAL_WAIT_FOREVER);
-
-        for (;;) {
-            read_len = sizeof(send_buf);
+        /* 报告缓冲区满丢弃的条数（刚消费过记录，此时已有空间） */
+        const uint32_t lost = s_log_lost;
+        if (lost != s_log_lost_seen) {
+            const uint32_t n = lost - s_log_lost_seen;
+            s_log_lost_seen  = lost;
+            Log_PrintfAt(LOG_LEVEL_WARN, &s_log_tag_site[LOG_TAG_ID_LOG],
+                         "日志缓冲区满，丢弃 %lu 条", (unsigned long)n);
+        }
+#if LOG_RATE_LIMIT_ENABLE
+        Log_RateFlush();
+#endif
+        Log_TimeSync();
+
+        /* 阻塞到缓冲区有一条记录：写入方（含中断）发布数据时直接唤醒；
+         * 最多等 LOG_TASK_IDLE_MS，以便补发到期的摘要、推进时间基准 */
+        read_len            = sizeof(hdr);
+        const ret_code_t rc = RingBuffer_ReadWait(&s_logRB, (uint8_t*)&hdr, &read_len,
+                                                  sizeof(hdr), LOG_TASK_IDLE_MS);
+        if (rc == RET_E_TIMEOUT) continue;
+        if (ret_is_err(rc)) {
+            /* 缓冲区创建失败：退避，避免空转 */
+            (void)OSAL_delay_ms(100);
+            continue;
+        }
 
-            if (!ret_is_ok(ReadRingBuffer(&s_logRB, send_buf, &read_len, true)) || read_len == 0) {
-                break; /* 空了 */
+        /* 头与负载由同一次 WriteV 写入：读到头时负载一定已经就绪，原地访问不拷贝 */
+        if (hdr.len > LOG_REC_PAYLOAD_MAX ||
+            ret_is_err(RingBuffer_ReadReserve(&s_logRB, hdr.len, &span, &read_len, false))) {
+            /* 记录错位：丢弃全部积压重新对齐 */
+            (void)ResetRingBuffer(&s_logRB);
+            continue;
+        }
+        if (read_len == 0) continue;
+
+        if (hdr.kind == LOG_REC_FMT || hdr.kind == LOG_REC_TEXT) {
+            /* 负载跨越末尾时先拼成连续的一段，否则直接在缓冲区内解析 */
+            const uint8_t* rec = span.p1;
+            if (span.n2 != 0) {
+                memcpy(rec_buf, span.p1, span.n1);
+                memcpy(rec_buf + span.n1, span.p2, span.n2);
+                rec = rec_buf;
             }
-
-            if (!Log_BackendReady()) {
-                /* 后端未就绪：丢弃 */
-                printf("LOG发送端待就位！！！\r\n");
-                continue;
+            const uint32_t n = Log_RenderRecord((LogLevel_t)hdr.level, rec, read_len, line_buf,
+                                                sizeof(line_buf));
+            /* 已渲染进 line_buf：先释放缓冲区空间，再分发 */
+            (void)RingBuffer_ReadCommit(&s_logRB, read_len);
+            if (n != 0) Log_Fanout(hdr.level, (const uint8_t*)line_buf, n, NULL, 0);
+            continue;
+        }
+        if (hdr.kind == LOG_REC_HEX) {
+            /* 原始字节先拷出并释放缓冲区空间（展开成多行时可能等待慢后端），再查表渲染 */
+            memcpy(rec_buf, span.p1, span.n1);
+            if (span.n2 != 0) memcpy(rec_buf + span.n1, span.p2, span.n2);
+            (void)RingBuffer_ReadCommit(&s_logRB, read_len);
+            if (read_len >= sizeof(log_hex_rec_t)) {
+                log_hex_rec_t rec;
+                memcpy(&rec, rec_buf, sizeof(rec));
+                Log_HexLines((LogLevel_t)hdr.level, rec.stamp, rec.site, rec.off,
+                             rec_buf + sizeof(rec), read_len - sizeof(rec), line_buf,
+                             sizeof(line_buf), Log_HexFanout);
             }
-
-            const log_backend_t* b = Log_GetBackend();
-
-            /* 启动发送：若忙则等待完成再重试 */
-            int rc;
-            do {
-                rc = b->send_async(send_buf, (uint16_t)read_len, b->user);
-                if (rc == RET_E_BUSY) {
-                    printf("LOG发送BUSY！！！\r\n");
-                    (void)OSAL_thread_flags_wait(LOG_TX_DONE_FLAG, OSAL_FLAGS_WAIT_ANY,
-                                                 OSAL_WAIT_FOREVER);
-                }
-            } while (rc == RET_E_BUSY);
-
-            /* 启动成功后必须等这笔发送完成，才能复用 send_buf 读下一段 */
-            (void)OSAL_thread_flags_wait(LOG_TX_DONE_FLAG, OSAL_FLAGS_WAIT_ANY, OSAL_WAIT_FOREVER);
+            continue;
         }
+
+#if LOG_TOKENIZED_ENABLE
+        /* 令牌帧：先拷出并释放缓冲区空间，时间戳换成 us 后分发 */
+        memcpy(rec_buf, span.p1, span.n1);
+        if (span.n2 != 0) memcpy(rec_buf + span.n1, span.p2, span.n2);
+        (void)RingBuffer_ReadCommit(&s_logRB, read_len);
+        const uint32_t n = Log_TokenRestamp(rec_buf, read_len, (uint8_t*)line_buf);
+        Log_Fanout(hdr.level, (const uint8_t*)line_buf, n, NULL, 0);
+#else
+        (void)RingBuffer_ReadCommit(&s_logRB, read_len);
+#endif
     }
 }
 
@@ -137,406 +1445,531 @@ void Log_Task_Entry(void* argument) {
  * @note  需要在 main.c 中系统调度开启前，或者第一个任务中调用
  */
 void Log_Init(void) {
-    /* 1. 创建互斥量 (如果尚未创建) */
-    if (s_logMutex == NULL) {
-        OSAL_mutex_create(&s_logMutex, "LogMutex", true, true);
-    }
-
 #if LOG_ASYNC_ENABLE
-    /* 2. 初始化 RingBuffer */
+    /* 1. 初始化 RingBuffer（多生产者无锁写入；后台任务阻塞读，需要读等待者） */
     /* 假设 CreateRingBuffer 内部使用了 static_alloc 或 malloc */
-    if (ret_is_err(CreateRingBuffer(&s_logRB, "s_logRB", LOG_RB_SIZE))) {
-        LOG_E("AT", "s_logRB 环形缓冲区分配失败");
+    if (ret_is_err(CreateRingBufferEx(&s_logRB, "s_logRB", LOG_RB_SIZE,
+                                      RB_FLAG_WAIT | RB_FLAG_MPSC))) {
+        LOG_E(LOG, "s_logRB 环形缓冲区分配失败");
     }
-    LOG_W("heap", "%uKB- %u空间还剩余 %u", MEMORY_POND_MAX_SIZE, LOG_RB_SIZE, query_remain_size());
-    /* 3. 创建后台发送任务 */
+    /* 2. 多后端分发环：为之前注册的后端挂接读游标 */
+    if (ret_is_err(CreateBroadcastRing(&s_logBR, "s_logBR", LOG_FANOUT_SIZE))) {
+        LOG_E(LOG, "s_logBR 分发环分配失败");
+    } else {
+        for (uint32_t i = 0; i < LOG_BACKEND_MAX; i++) {
+            if (s_log_sinks[i].used && s_log_sinks[i].cur == NULL) Log_SinkAttach(&s_log_sinks[i]);
+        }
+    }
+    LOG_W(HEAP, "%uKB- %u空间还剩余 %u", MEMORY_POND_MAX_SIZE, LOG_RB_SIZE + LOG_FANOUT_SIZE,
+          query_remain_size());
+    /* 3. 创建后台发送任务（延迟模式下格式化也在该任务中完成） */
     const osal_thread_attr_t log_attr = {
         .name       = "LogTask",
-        .stack_size = 128 * 4,
+        .stack_size = 256 * 4,
         .priority   = OSAL_PRIO_LOW,
     };
 
     /* 创建线程并保存句柄 */
     OSAL_thread_create(&s_logTaskHandle, Log_Task_Entry, NULL, &log_attr);
+#else
+    /* 同步模式：创建互斥量 (如果尚未创建) */
+    if (s_logMutex == NULL) {
+        OSAL_mutex_create(&s_logMutex, "LogMutex", true, true);
+    }
 #endif
 }
 
+/**
+ * @brief 替换日志时间源
+ * @param clock 自由运行的计数器（按 2^32 回绕），NULL 恢复默认 hal_get_cycles
+ * @param hz 计数频率，须不低于 1kHz；0 表示 hal_get_cycles_hz()
+ * @note  已在缓冲区中的记录仍按旧时间源解释，应在输出第一条日志前调用
+ */
+void Log_SetClock(const log_clock_fn_t clock, const uint32_t hz) {
+    s_log_clock_hz = (clock != NULL) ? hz : 0u;
+    s_log_clock    = (clock != NULL) ? clock : hal_get_cycles;
+}
+
 /**
  * @brief 核心日志打印函数
  */
-void Log_Printf(LogLevel_t level, const char* file, int line, const char* tag, const char* fmt,
-                ...) {
+static void Log_VPrintf(const LogLevel_t level, const log_site_t* site, const char* fmt,
+                        va_list args, const bool collapse) {
     /* 1. 过滤低等级日志 */
     if (level > LOG_CURRENT_LEVEL) return;
 
-    const bool in_isr = (__get_IPSR() != 0);
-
-    /* 2. 获取互斥锁 (保护静态缓冲区 static char log_buf) */
-    /* 只有当内核运行中时才需要锁，初始化阶段单线程运行不需要锁 */
-    if (OSAL_kernel_is_running() && !in_isr) {
-        if (s_logMutex != NULL) {
-            /* 等待获取锁，超时时间设为最大 */
-            OSAL_mutex_lock(s_logMutex, OSAL_WAIT_FOREVER);
-        }
+#if LOG_ASYNC_ENABLE && LOG_DEFERRED_ENABLE
+    /* 延迟模式：不加锁、不格式化，只压入调用点/fmt 指针和原始参数，由后台任务格式化 */
+    if (OSAL_kernel_is_running()) {
+        Log_PushDeferred(level, site, fmt, args, collapse);
+        return;
     }
+#endif
 
-    /* 待优化 静态ISR 和任务抢占的问题 */
+    const bool in_isr    = (__get_IPSR() != 0);
+    const uint32_t stamp = Log_Now();
     char log_buf[LOG_LINE_MAX];
 
-    /* ================= 格式化阶段 ================= */
+#if LOG_ASYNC_ENABLE
+    if (OSAL_kernel_is_running()) {
+        /* 2. 只在调用方的栈上格式化正文，日志头（时间/间隔）由后台任务按输出顺序补上；
+         * 记录无锁写入，任务和中断走同一路径，缓冲区满时整条丢弃并计数，由 LogTask 报告 */
+        const log_fmt_rec_t rec = {.stamp = stamp, .site = site, .fmt = NULL};
+        const uint32_t cap      = MIN(sizeof(log_buf), LOG_REC_PAYLOAD_MAX - sizeof(rec));
+        const int n             = vsnprintf_my(log_buf, cap, fmt, args);
+        const uint32_t body     = (n < 0) ? 0 : MIN((uint32_t)n, cap - 1);
+        if (collapse && !Log_RepeatAllow((log_tag_t)site->tag_id, site, level, log_buf, body)) {
+            return;
+        }
 
-    /* 获取系统滴答数 */
-    const uint32_t tick = HAL_GetTick();
+        const log_rec_hdr_t hdr = {
+            .kind  = LOG_REC_TEXT,
+            .level = (uint8_t)level,
+            .len   = (uint16_t)(sizeof(rec) + body),
+        };
+        const RingBufferConstVec vec[] = {
+            {.ptr = (const uint8_t*)&rec, .len = sizeof(rec)},
+            {.ptr = (const uint8_t*)log_buf, .len = body},
+        };
+        (void)Log_PushRecord(&hdr, vec, ARRAY_SIZE(vec), in_isr);
+        return;
+    }
+#endif
 
-    /* 设置颜色与等级字符 */
-    const char* color   = "";
-    char level_char     = ' ';
+    /* 3. 调度器启动前 / 同步模式：就地拼装整行直接输出，同步模式下串行化任务输出 */
+    Log_Lock(in_isr);
 
-    /* 判断使用的日志 */
-    switch (level) {
-        case LOG_LEVEL_ERROR:
-            color      = COLOR_RED;
-            level_char = 'E';
-            break;
-        case LOG_LEVEL_WARN:
-            color      = COLOR_YELLOW;
-            level_char = 'W';
-            break;
-        case LOG_LEVEL_INFO:
-            color      = COLOR_GREEN;
-            level_char = 'I';
-            break;
-        case LOG_LEVEL_DEBUG:
-            color      = COLOR_BLUE;
-            level_char = 'D';
-            break;
-        default:
-            break;
+    /* 拼装日志头: [时间 +间隔] L/TAG file:line: */
+    const int head_len = Log_FormatHead(log_buf, LOG_LINE_MAX, level, stamp, site);
+
+    /* 4. 拼装用户内容 (处理可变参数) */
+    /* vsnprintf 会自动处理缓冲区长度限制，防止溢出 */
+    const int content_len = vsnprintf_my(log_buf + head_len, LOG_LINE_MAX - head_len, fmt, args);
+
+    /* 计算当前总长度 (vsnprintf 返回的是未截断长度，这里按实际写入截断) */
+    int total_len = head_len + content_len;
+    if (total_len > LOG_LINE_MAX - 1) total_len = LOG_LINE_MAX - 1;
+    log_buf[total_len] = '\0';
+    if (collapse && !Log_RepeatAllow((log_tag_t)site->tag_id, site, level, log_buf + head_len,
+                                     (uint32_t)(total_len - head_len))) {
+        Log_Unlock(in_isr);
+        return;
     }
 
-    /* 文件名简化处理：去除路径，只保留文件名 */
-    const char* short_file = strrchr(file, '/');
-    if (!short_file) short_file = strrchr(file, '\\');
-    short_file         = short_file ? short_file + 1 : file;
+    /* 5. 发送 */
+#if LOG_ASYNC_ENABLE
+    /* 如果调度器没启动 (例如在 Log_Init 前使用)，强制使用同步发送 */
+    printf("RTOS调度器没启动！！！%s%s", log_buf, s_log_tail);
+#else
+    /* 同步模式：直接阻塞发送 */
+    printf("%s%s", log_buf, s_log_tail);
+#endif
 
-    /* 3. 拼装日志头: [Tick] L/TAG: */
-    const int head_len = snprintf_my(log_buf, LOG_LINE_MAX, "%s[%lu] %c/%s %s:%d: ", color, tick,
-                                     level_char, tag, short_file, line);
+    /* 6. 释放互斥锁（仅同步模式） */
+    Log_Unlock(in_isr);
+}
 
-    /* 4. 拼装用户内容 (处理可变参数) */
+/**
+ * @brief 核心日志打印函数（由 LOG_x 宏调用）
+ * @param site 调用点描述符（静态常量）
+ * @param fmt 格式串
+ */
+void Log_Printf(const log_site_t* site, const char* fmt, ...) {
     va_list args;
     va_start(args, fmt);
-    /* vsnprintf 会自动处理缓冲区长度限制，防止溢出 */
-    const int content_len = vsnprintf_my(log_buf + head_len, LOG_LINE_MAX - head_len, fmt, args);
+    Log_VPrintf((LogLevel_t)site->level, site, fmt, args, true);
     va_end(args);
+}
 
-    /* 计算当前总长度 */
-    int total_len = head_len + content_len;
+/**
+ * @brief 以指定等级借用调用点输出（模块内部的汇总报告使用，不参与重复折叠）
+ */
+static void Log_PrintfAt(const LogLevel_t level, const log_site_t* site, const char* fmt, ...) {
+    va_list args;
+    va_start(args, fmt);
+    Log_VPrintf(level, site, fmt, args, false);
+    va_end(args);
+}
+
+#if LOG_TOKENIZED_ENABLE
+/**
+ * @brief 写入 32 位 varint（每字节 7 位，低位在前）
+ * @return 写入的字节数（<= 5）
+ */
+static uint32_t Log_VarintPut(uint8_t* out, uint32_t v) {
+    uint32_t n = 0;
+    while (v >= 0x80u) {
+        out[n++] = (uint8_t)(v | 0x80u);
+        v >>= 7;
+    }
+    out[n++] = (uint8_t)v;
+    return n;
+}
+
+/**
+ * @brief 写入 64 位 varint
+ * @return 写入的字节数（<= 10）
+ */
+static uint32_t Log_Varint64Put(uint8_t* out, uint64_t v) {
+    uint32_t n = 0;
+    while (v >= 0x80u) {
+        out[n++] = (uint8_t)(v | 0x80u);
+        v >>= 7;
+    }
+    out[n++] = (uint8_t)v;
+    return n;
+}
+
+/**
+ * @brief 读取 32 位 varint
+ * @param in 数据
+ * @param n 数据字节数
+ * @param pos 读位置，成功时前移
+ * @param v 读出的值
+ * @return 成功返回 true；越界或超过 5 字节返回 false
+ */
+static bool Log_VarintGet(const uint8_t* in, const uint32_t n, uint32_t* pos, uint32_t* v) {
+    uint32_t x = 0;
+    for (uint32_t i = *pos, shift = 0; i < n && shift <= 28; i++, shift += 7) {
+        x |= (uint32_t)(in[i] & 0x7Fu) << shift;
+        if ((in[i] & 0x80u) == 0) {
+            *pos = i + 1;
+            *v   = x;
+            return true;
+        }
+    }
+    return false;
+}
 
-    /* 5. 拼装尾部 (颜色复位 + 换行) */
-    /* 预留 6 字节给尾部字符，如果不够则截断内容 */
-    if (total_len + 6 > LOG_LINE_MAX) total_len = LOG_LINE_MAX - 6;
+/**
+ * @brief 把令牌帧里的时间源计数换成 us（主机端按 32 位 us 解码，线上格式不变）
+ * @param in 原帧（连续）
+ * @param n 原帧字节数
+ * @param out 输出区（>= LOG_TOKEN_FRAME_MAX）
+ * @return 新帧字节数；帧头损坏时原样拷贝
+ * @note  只在 LogTask 或调度器启动前调用：与文本日志共用 64 位时间基准
+ */
+static uint32_t Log_TokenRestamp(const uint8_t* in, const uint32_t n, uint8_t* out) {
+    uint32_t pos = 2;
+    uint32_t id;
+    uint32_t stamp;
+    if (n > LOG_TOKEN_FRAME_MAX || !Log_VarintGet(in, n, &pos, &id) ||
+        !Log_VarintGet(in, n, &pos, &stamp)) {
+        memcpy(out, in, MIN(n, LOG_TOKEN_FRAME_MAX));
+        return MIN(n, LOG_TOKEN_FRAME_MAX);
+    }
 
-    const int tail_len =
-        snprintf_my(log_buf + total_len, LOG_LINE_MAX - total_len, "%s\r\n", COLOR_RESET);
-    total_len += tail_len;
+    osal_crit_state_t state;
+    OSAL_enter_critical_ex(&state);
+    const uint64_t t = Log_TimeExtend(stamp);
+    OSAL_exit_critical_ex(state);
+
+    uint32_t len = 2;
+    len += Log_VarintPut(out + len, id);
+    len += Log_VarintPut(out + len, (uint32_t)Log_TimeToUs(t));
+    memcpy(out + len, in + pos, n - pos);
+    len += n - pos;
+    out[0] = LOG_TOKEN_SYNC;
+    out[1] = (uint8_t)(len - 2);
+    return len;
+}
 
-    /* ================= 发送阶段 ================= */
+/**
+ * @brief 令牌化日志：编码一帧并写入缓冲区（不格式化、不加锁，任务和中断均可调用）
+ * @param level 日志等级
+ * @param tag tag ID（限流与重复折叠按 tag 记录）
+ * @param id 字典条目地址
+ * @param types 参数类型编码，每 4 位一个，低位对应第一个参数，0 结束
+ * @note  参数区放不下时截断，主机端对缺失的参数输出 "?"
+ */
+void Log_Token(LogLevel_t level, log_tag_t tag, uint32_t id, uint32_t types, ...) {
+    uint8_t frame[LOG_TOKEN_FRAME_MAX];
+    uint32_t pos = 2;
+    pos += Log_VarintPut(frame + pos, id);
+    pos += Log_VarintPut(frame + pos, Log_Now());
+    const uint32_t arg_at = pos;
 
-#if LOG_ASYNC_ENABLE
-    /* 异步模式：判断内核是否正在运行 */
-    if (__get_IPSR() == 0) {
-        if (OSAL_kernel_is_running()) {
-            /* 尝试写入 RingBuffer */
-            uint32_t write_len    = total_len;
-
-            /* 这里的 false 表示如果空间不足不写入全部丢弃 (或根据 RingBuffer 实现策略) */
-            const uint32_t result = WriteRingBuffer(&s_logRB, (uint8_t*)log_buf, &write_len, false);
-            if (ret_is_ok(result)) {
-                /* 写入成功，设置标志位唤醒后台任务 */
-                if (s_logTaskHandle != NULL) {
-                    /* OSAL_thread_flags_set 在 CMSIS-OS2 (STM32实现) 中通常是 ISR 安全的 */
-                    /* 它内部会自动判断是否在中断中，并调用对应的 FreeRTOS FromISR 函数 */
-                    OSAL_thread_flags_set(s_logTaskHandle, LOG_TASK_FLAG);
+    va_list args;
+    va_start(args, types);
+    for (bool full = false; types != 0 && !full; types >>= 4) {
+        const uint32_t room = sizeof(frame) - pos;
+        switch (types & 0xFu) {
+            case LOG_TT_I32: {
+                /* zigzag：小的负数也只占 1~2 字节；无符号数由主机端按 fmt 还原 */
+                const int32_t v = va_arg(args, int32_t);
+                if (room < 5) {
+                    full = true;
+                    break;
                 }
-            } else {
-                /* 缓冲区已满：可以选择丢弃，或者在此处强制改为阻塞发送(会影响实时性) */
-                printf("is_no_mem：%d\r\n", ret_is_no_mem(result));
-                printf("is_valid_param ：%d\r\n", ret_is_invalid_arg(result));
-                printf("缓冲区已满！！！%s \r\n", log_buf);
+                pos += Log_VarintPut(frame + pos, ((uint32_t)v << 1) ^ (uint32_t)(v >> 31));
+                break;
             }
-        } else {
-            /* 如果调度器没启动 (例如在 Log_Init 前使用)，强制使用同步发送 */
-            printf("RTOS调度器没启动！！！%s \r\n", log_buf);
-        }
-    } /* if (__get_IPSR() == 0) */
-    else {
-        /* 警告需要锁/阻塞代码 被上层尝试调用 */
-        char buffer[128];
-        uint32_t t_len =
-            sniprintf(buffer, 128, "%s[%lu] %c/%s %s:%d:  %s \r\n %s", COLOR_RED, tick, 'E', "LOG",
-                      short_file, line, "该代码尝试在中断调用有锁的代码！", COLOR_RESET);
-
-        uint32_t write_len = total_len;
-        /* 发送数据到缓冲区 提示 */
-        if (ret_is_ok(WriteRingBufferFromISR(&s_logRB, (uint8_t*)buffer, &t_len, false))) {
-            /* 写入成功，设置标志位唤醒后台任务 */
-            if (s_logTaskHandle != NULL) {
-                /* OSAL_thread_flags_set 在 CMSIS-OS2 (STM32实现) 中通常是 ISR 安全的 */
-                /* 它内部会自动判断是否在中断中，并调用对应的 FreeRTOS FromISR 函数 */
-                OSAL_thread_flags_set(s_logTaskHandle, LOG_TASK_FLAG);
+            case LOG_TT_I64: {
+                const int64_t v = va_arg(args, int64_t);
+                if (room < 10) {
+                    full = true;
+                    break;
+                }
+                pos += Log_Varint64Put(frame + pos, ((uint64_t)v << 1) ^ (uint64_t)(v >> 63));
+                break;
             }
-        } else {
-            /* 缓冲区已满：可以选择丢弃，或者在此处强制改为阻塞发送(会影响实时性) */
-            printf("缓冲区已满！！！%s \r\n", log_buf);
-        }
-
-        /* 发送数据到缓冲区 日志 */
-        if (ret_is_ok(WriteRingBufferFromISR(&s_logRB, (uint8_t*)log_buf, &write_len, false))) {
-            /* 写入成功，设置标志位唤醒后台任务 */
-            if (s_logTaskHandle != NULL) {
-                /* OSAL_thread_flags_set 在 CMSIS-OS2 (STM32实现) 中通常是 ISR 安全的 */
-                /* 它内部会自动判断是否在中断中，并调用对应的 FreeRTOS FromISR 函数 */
-                OSAL_thread_flags_set(s_logTaskHandle, LOG_TASK_FLAG);
+            case LOG_TT_DOUBLE: {
+                const float v = (float)va_arg(args, double);
+                if (room < sizeof(v)) {
+                    full = true;
+                    break;
+                }
+                memcpy(frame + pos, &v, sizeof(v)); /* Cortex-M 为小端 */
+                pos += sizeof(v);
+                break;
             }
-        } else {
-            /* 缓冲区已满：可以选择丢弃，或者在此处强制改为阻塞发送(会影响实时性) */
-            /* 采用阻塞式的代码发生 */
-            printf("缓冲区已满！！！%s \r\n", log_buf);
+            case LOG_TT_STR: {
+                const char* str = va_arg(args, const char*);
+                if (str == NULL) str = "(null)";
+                if (room < 2) {
+                    full = true;
+                    break;
+                }
+                uint32_t n = 0;
+                while (n < LOG_DEFER_STR_MAX && n < room - 2 && str[n] != '\0') n++;
+                pos += Log_VarintPut(frame + pos, n);
+                memcpy(frame + pos, str, n);
+                pos += n;
+                break;
+            }
+            default:
+                full = true;
+                break;
         }
     }
+    va_end(args);
 
-#else
-    /* 同步模式：直接阻塞发送 */
-    printf("%s", log_buf);
-#endif
+    /* 编码后的参数就是消息内容：字典条目与参数都相同才折叠 */
+    if (!Log_RepeatAllow(tag, (const void*)(uintptr_t)id, level, frame + arg_at, pos - arg_at)) {
+        return;
+    }
+
+    frame[0] = LOG_TOKEN_SYNC;
+    frame[1] = (uint8_t)(pos - 2);
 
-    /* 6. 释放互斥锁 */
     if (OSAL_kernel_is_running()) {
-        if (s_logMutex != NULL) {
-            OSAL_mutex_unlock(s_logMutex);
-        }
+        /* 缓冲区满时整条丢弃（计入 RingBuffer 的 write_fail 统计） */
+        const log_rec_hdr_t hdr    = {.kind = LOG_REC_TOKEN, .level = (uint8_t)level, .len = pos};
+        const RingBufferConstVec v = {.ptr = frame, .len = pos};
+        (void)Log_PushRecord(&hdr, &v, 1, OSAL_in_isr());
+    } else {
+        /* 调度器启动前同步输出二进制帧 */
+        uint8_t out[LOG_TOKEN_FRAME_MAX];
+        (void)fwrite(out, 1, Log_TokenRestamp(frame, pos, out), stdout);
+        (void)fflush(stdout);
     }
 }
+#endif
 
 /**
- * @brief 将数据传入环形缓冲区通知唤醒发送任务
- * @param data 数据源
- * @param len  数据长度
+ * @brief HEX 行输出方式：直接输出（调度器启动前或同步模式）
  */
-static void Log_PushBytes_NoBlock(const uint8_t* data, uint16_t len) {
-#if LOG_ASYNC_ENABLE
-    if (OSAL_kernel_is_running()) {
-        uint32_t write_len = (uint32_t)len;
-        (void)WriteRingBufferFromISR(&s_logRB, (uint8_t*)data, &write_len, false);
-
-        if (s_logTaskHandle != NULL) {
-            (void)OSAL_thread_flags_set(s_logTaskHandle, LOG_TASK_FLAG);
-        }
-    }
-#else
-    (void)data;
-    (void)len;
-#endif
+static void Log_HexWrite(const LogLevel_t level, const char* line, const uint32_t len) {
+    (void)level;
+    (void)fwrite(line, 1, len, stdout);
 }
 
 /**
  * @brief HEX版本的日志打印输出
- * @param level 日志等级
- * @param file  触发文件
- * @param line  触发行数
- * @param tag   tag
+ * @param site  调用点描述符（等级/tag/文件/行号）
  * @param buf   数据源缓冲区
  * @param len   数据长度
- * @note  buf为中文时ASC显示为...
+ * @note  异步模式下调用方只拷贝原始字节，由后台任务查表展开；buf为中文时ASC显示为...
  */
-void Log_Hexdump(LogLevel_t level, const char* file, int line, const char* tag, const void* buf,
-                 uint32_t len) {
+void Log_Hexdump(const log_site_t* site, const void* buf, uint32_t len) {
     /* 1、检查日志等级 */
+    const LogLevel_t level = (LogLevel_t)site->level;
     if (level > LOG_CURRENT_LEVEL) return;
 
-    /* 2、获取数据源的指针 */
-    const uint8_t* p    = (const uint8_t*)buf;
+    /* 2、获取数据源的指针（无效参数按空数据输出） */
+    const uint8_t* p = (const uint8_t*)buf;
+    if (p == NULL) len = 0;
 
-    /* 3、获取时间戳、根据日志等级获取输出颜色 */
-    const uint32_t tick = HAL_GetTick();
-    const char* color   = "";
-    char level_char     = ' ';
-    switch (level) {
-        case LOG_LEVEL_ERROR:
-            color      = COLOR_RED;
-            level_char = 'E';
-            break;
-        case LOG_LEVEL_WARN:
-            color      = COLOR_YELLOW;
-            level_char = 'W';
-            break;
-        case LOG_LEVEL_INFO:
-            color      = COLOR_GREEN;
-            level_char = 'I';
-            break;
-        case LOG_LEVEL_DEBUG:
-            color      = COLOR_BLUE;
-            level_char = 'D';
-            break;
-        default:
-            break;
+#if LOG_ASYNC_ENABLE
+    /* 3、异步模式：整段原始字节作为 HEX 记录压入缓冲区，不在调用方格式化 */
+    if (OSAL_kernel_is_running()) {
+        Log_PushHex(level, site, p, len);
+        return;
     }
+#endif
 
-    /* 4、获取文件名 */
-    const char* short_file = strrchr(file, '/');
-    if (!short_file) short_file = strrchr(file, '\\');
-    short_file        = short_file ? short_file + 1 : file;
-
-    /* 5、判断是否在中断中执行 */
+    /* 4、调度器启动前 / 同步模式：就地渲染并直接输出 */
     const bool in_isr = OSAL_in_isr();
+    Log_Lock(in_isr);
+    char line_buf[LOG_LINE_MAX];
+    Log_HexLines(level, Log_Now(), site, 0, p, len, line_buf, sizeof(line_buf), Log_HexWrite);
+    Log_Unlock(in_isr);
+}
 
-    /* --- [收敛：定义输出宏，用于处理中断和非中断的不同路径] --- */
-#if LOG_ASYNC_ENABLE
+/**
+ * @brief 在槽上登记后端（游标由 Log_Init 或 LogTask 下一次分发时挂接）
+ * @param s 后端槽
+ * @param b 后端
+ * @param level 该后端输出的最低等级
+ */
+static void Log_SinkSetup(log_sink_t* s, const log_backend_t b, const LogLevel_t level) {
+    memset(s, 0, sizeof(*s));
+    s->b     = b;
+    s->level = (uint8_t)level;
+    s->used  = true;
+}
 
-#define OUTPUT_LOG_LINE(ptr, length)                                                 \
-    do {                                                                             \
-        if (in_isr) {                                                                \
-            Log_PushBytes_NoBlock((const uint8_t*)(ptr), (uint16_t)(length));        \
-        } else {                                                                     \
-            if (OSAL_kernel_is_running()) {                                          \
-                uint32_t write_len = (uint32_t)(length);                             \
-                (void)WriteRingBuffer(&s_logRB, (uint8_t*)(ptr), &write_len, false); \
-                if (write_len > 0 && s_logTaskHandle != NULL) {                      \
-                    (void)OSAL_thread_flags_set(s_logTaskHandle, LOG_TASK_FLAG);     \
-                }                                                                    \
-            } else {                                                                 \
-                printf("HEX打印缓冲区已满！！！%s \r\n", ptr);                       \
-            }                                                                        \
-        }                                                                            \
-    } while (0)
+/**
+ * @brief 注册一个日志后端（UART/RTT/USB/Flash 等）
+ * @param b 后端
+ * @param level 只输出等级 <= level 的日志
+ * @param id 返回后端编号，完成通知 Log_BackendTxDoneISR(id) 使用（可为 NULL）
+ * @return 后端槽已满返回 RET_E_NO_MEM
+ * @note  每个后端在分发环上有独立读游标：慢后端落后太多时整条丢弃自己的积压，
+ *        丢弃条数由 Log_GetBackendDropped 查询，不影响其他后端
+ */
+ret_code_t Log_AddBackend(const log_backend_t b, const LogLevel_t level, uint8_t* id) {
+    if (b.send_async == NULL) return RET_E_INVALID_ARG;
+    for (uint8_t i = 0; i < LOG_BACKEND_MAX; i++) {
+        if (s_log_sinks[i].used) continue;
+        Log_SinkSetup(&s_log_sinks[i], b, level);
+        if (id != NULL) *id = i;
+        return RET_OK;
+    }
+    return RET_E_NO_MEM;
+}
 
-#else
+/**
+ * @brief 修改后端输出的最低等级
+ * @param id 后端编号
+ * @param level 新等级
+ * @return 返回是否成功
+ */
+ret_code_t Log_SetBackendLevel(const uint8_t id, const LogLevel_t level) {
+    if (id >= LOG_BACKEND_MAX || !s_log_sinks[id].used) return RET_E_INVALID_ARG;
+    s_log_sinks[id].level = (uint8_t)level;
+    return RET_OK;
+}
 
-#define OUTPUT_LOG_LINE(ptr, length)                                          \
-    do {                                                                      \
-        if (in_isr) {                                                         \
-            Log_PushBytes_NoBlock((const uint8_t*)(ptr), (uint16_t)(length)); \
-        } else {                                                              \
-            Hardware_Send((uint8_t*)(ptr), (uint16_t)(length));               \
-        }                                                                     \
-    } while (0)
+/**
+ * @brief 查询后端因落后太多而丢弃的日志条数
+ * @param id 后端编号
+ * @return 累计条数
+ */
+uint32_t Log_GetBackendDropped(const uint8_t id) {
+    if (id >= LOG_BACKEND_MAX) return 0;
+    return s_log_sinks[id].dropped;
+}
 
+/**
+ * @brief 注册日志后端（兼容接口：设为 0 号后端，输出全部等级）
+ * @note  必须在 Log_Init() 之前调用；一般只调用一次
+ */
+void Log_SetBackend(log_backend_t b) {
+    log_sink_t* s = &s_log_sinks[0];
+    // 若传入无效后端，则摘除 0 号后端
+    if (b.send_async == NULL) {
+#if LOG_ASYNC_ENABLE
+        if (s->cur != NULL) BroadcastRing_Detach(s->cur);
 #endif
-
-    /* 6、非中断模式下尝试获取互斥锁 */
-    if (!in_isr && OSAL_kernel_is_running() && s_logMutex != NULL) {
-        OSAL_mutex_lock(s_logMutex, OSAL_WAIT_FOREVER);
+        memset(s, 0, sizeof(*s));
+        return;
     }
 
-    /* 7、处理空数据或无效参数 */
-    if (p == NULL || len == 0) {
-        char line_buf[128];
-        const int n = sniprintf(line_buf, sizeof(line_buf), "%s[%lu] %c/%s %s:%d: HEX len=0%s\r\n",
-                                color, tick, level_char, tag, short_file, line, COLOR_RESET);
-        if (n > 0) OUTPUT_LOG_LINE(line_buf, n);
-    } else {
-        /* 8、开始循环拼装 HEX Dump 主体 */
-        static const char HEX[] = "0123456789ABCDEF";
-        for (uint32_t off = 0; off < len; off += LOG_HEX_BYTES_PER_LINE) {
-            char line_buf[LOG_LINE_MAX];  // 局部缓冲区
-            const size_t cap          = sizeof(line_buf);
-            const size_t tail_reserve = strlen(COLOR_RESET) + 2 /*\r\n*/ + 1 /*\0*/;
-            const size_t limit        = (cap > tail_reserve) ? (cap - tail_reserve) : 0;
-            size_t pos                = 0;
-            if (limit == 0) {
-                // line_buf 太小，无法保证尾部，直接输出简版
-                char small[96];
-                int n = snprintf_my(small, sizeof(small),
-                                    "%s[%lu] %c/%s %s:%d: HEX buf too small%s\r\n", color, tick,
-                                    level_char, tag, short_file, line, COLOR_RESET);
-                if (n > 0) OUTPUT_LOG_LINE(small, n);
-                break;  // 或 return
-            }
-
-            /* 拼装头部 */
-            const int head =
-                snprintf_my(line_buf, sizeof(line_buf), "%s[%lu] %c/%s %s:%d: %08lX: ", color, tick,
-                            level_char, tag, short_file, line, (unsigned long)off);
-            if (head < 0) continue;
-            pos = (size_t)head;
-            if (pos > limit) pos = limit;
-
-            /* 拼装 HEX 主体 */
-            for (uint16_t i = 0; i < LOG_HEX_BYTES_PER_LINE; i++) {
-                /* 至少能够装下一个16进制数 */
-                if (pos + 3 > limit) break;
-                /* 防止越界读取 */
-                if (off + i < len) {
-                    const uint8_t b = p[off + i];
-                    line_buf[pos++] = HEX[(b >> 4) & 0x0F];
-                    line_buf[pos++] = HEX[b & 0x0F];
-                    line_buf[pos++] = ' ';
-                } else {
-                    line_buf[pos++] = ' ';
-                    line_buf[pos++] = ' ';
-                    line_buf[pos++] = ' ';
-                }
-                /* 每 8 字节额外空格 */
-                if (i == 7 && pos + 1 < limit) line_buf[pos++] = ' ';
-            }
+    if (s->used) {
+        s->b     = b;
+        s->level = LOG_LEVEL_ALL;
+        return;
+    }
+    Log_SinkSetup(s, b, LOG_LEVEL_ALL);
+}
 
-            /* ASCII 区 */
-            if (pos + 1 < limit) line_buf[pos++] = '|';
-            for (uint16_t i = 0; i < LOG_HEX_BYTES_PER_LINE; i++) {
-                if (pos + 1 > limit) break;
-                if (off + i < len) {
-                    const uint8_t c = p[off + i];
-                    line_buf[pos++] = (c >= 32 && c <= 126) ? (char)c : '.';
-                } else {
-                    line_buf[pos++] = ' ';
-                }
-            }
-            if (pos + 1 <= limit) line_buf[pos++] = '|';
-
-            /* 尾部：颜色重置与换行 */
-            const int tail = snprintf_my(line_buf + pos, cap - pos, "%s\r\n", COLOR_RESET);
-            if (tail > 0) pos += (size_t)tail;
-            if (pos < cap) line_buf[pos] = '\0';
-            /* 调用收敛后的输出逻辑 */
-            OUTPUT_LOG_LINE(line_buf, pos);
+/**
+ * @brief 后端的一笔发送完成：释放已发送的记录并续发后面的记录
+ * @param id 后端编号
+ * @note  在发送完成中断中调用；跨越末尾的数据先接着发第二段
+ */
+void Log_BackendTxDoneISR(const uint8_t id) {
+#if LOG_ASYNC_ENABLE
+    if (id >= LOG_BACKEND_MAX) return;
+    log_sink_t* s = &s_log_sinks[id];
+    if (!s->busy) return;
+
+    if (s->stale) {
+        /* 已放弃的那一笔迟到的完成：游标已摘下，不提交；清状态后由 LogTask 重新挂接 */
+        s->stale   = false;
+        s->pending = 0;
+        s->n2      = 0;
+        s->busy    = false;
+        if (s_logTaskHandle != NULL) {
+            (void)OSAL_thread_flags_set(s_logTaskHandle, LOG_TX_DONE_FLAG);
         }
+        return;
     }
 
-    /* 9、释放互斥锁 */
-    if (!in_isr && OSAL_kernel_is_running() && s_logMutex != NULL) {
-        OSAL_mutex_unlock(s_logMutex);
+    if (s->n2 != 0) {
+        const uint8_t* p = s->p2;
+        const uint32_t n = s->n2;
+        s->n2            = 0;
+        if (s->b.send_async(p, (uint16_t)n, s->b.user) == RET_OK) return;
+    }
+    (void)BroadcastRing_ReadCommit(s->cur, s->pending);
+    s->pending = 0;
+
+    if (s->hold || !Log_SinkStart(s)) {
+        s->busy = false;
+        /* LogTask 可能正等着这个后端让出在途数据所在的空间 */
+        if (s_logTaskHandle != NULL) {
+            (void)OSAL_thread_flags_set(s_logTaskHandle, LOG_TX_DONE_FLAG);
+        }
     }
+#else
+    (void)id;
+#endif
+}
 
-#undef OUTPUT_LOG_LINE  // 宏仅在该函数内有效
+/**
+ * @brief 0 号后端的发送完成通知（兼容接口）
+ */
+void Log_OnTxDoneISR(void) {
+    Log_BackendTxDoneISR(0);
 }
 
 /**
- * @brief 注册日志后端（UART/RTT/USB/Flash 等）
- * @note  必须在 Log_Init() 之前调用；一般只调用一次
+ * @brief 设置 tag 的运行时等级
+ * @param tag tag ID (LOG_TAG_ID_xxx)
+ * @param level 只输出等级 <= level 的日志，LOG_LEVEL_OFF 关闭该 tag
+ * @return 参数非法返回 RET_E_INVALID_ARG
+ * @note  单字节写入，可在任意上下文调用，下一次 LOG_x 即生效
  */
-void Log_SetBackend(log_backend_t b) {
-    // 若传入无效后端，则清空并标记未就绪
-    if (b.send_async == NULL) {
-        memset(&s_log_backend, 0, sizeof(s_log_backend));
-        s_log_backend_ready = 0;
-        return;
-    }
+ret_code_t Log_SetTagLevel(const log_tag_t tag, const LogLevel_t level) {
+    if ((uint32_t)tag >= LOG_TAG_COUNT || level > LOG_LEVEL_ALL) return RET_E_INVALID_ARG;
+    g_log_tag_level[tag] = (uint8_t)level;
+    return RET_OK;
+}
 
-    /* 直接拷贝保存 */
-    s_log_backend       = b;
-    s_log_backend_ready = 1;
+/**
+ * @brief 查询 tag 的运行时等级
+ * @param tag tag ID
+ * @return 当前等级，tag 非法返回 LOG_LEVEL_OFF
+ */
+LogLevel_t Log_GetTagLevel(const log_tag_t tag) {
+    if ((uint32_t)tag >= LOG_TAG_COUNT) return LOG_LEVEL_OFF;
+    return (LogLevel_t)g_log_tag_level[tag];
 }
 
 /**
- * @brief 通知任务消息存储入缓冲区完成
+ * @brief 按名称设置 tag 的运行时等级
+ * @param name tag 名称 (与 log_tags.h 中一致，区分大小写)
+ * @param level 只输出等级 <= level 的日志
+ * @return 未注册的名称返回 RET_E_NOT_FOUND
  */
-void Log_OnTxDoneISR(void) {
-#if LOG_ASYNC_ENABLE
-    if (s_logTaskHandle != NULL) {
-        (void)OSAL_thread_flags_set(s_logTaskHandle, LOG_TX_DONE_FLAG);
+ret_code_t Log_SetTagLevelByName(const char* name, const LogLevel_t level) {
+    if (name == NULL) return RET_E_INVALID_ARG;
+    for (uint32_t i = 0; i < LOG_TAG_COUNT; i++) {
+        if (strcmp(s_log_tag_site[i].tag, name) == 0) return Log_SetTagLevel((log_tag_t)i, level);
     }
-#endif
+    return RET_E_NOT_FOUND;
 }
 
 #endif
@@ -1,6 +1,12 @@
 #ifndef LOG_H
 #define LOG_H
+#include <stdbool.h>
+#include <stddef.h>
 #include <stdint.h>
+
+#include "compiler_cus.h"
+#include "log_tags.h"
+#include "ret_code.h"
 /* ================= 配置区域 ================= */
 /* 日志控制宏可以控制调试信息的输出 全局*/
 #define G_LOG_ENABLE        1
@@ -8,8 +14,38 @@
 #define LOG_COLOR_ENABLE    1
 /*  启用异步缓冲(RTOS Task发送)  0: 使用阻塞发送 */
 #define LOG_ASYNC_ENABLE    1
-/* 定义日志缓冲区的总大小 (仅在异步模式下有效) */
-#define LOG_RB_SIZE         2048
+/* 调用方写入的日志缓冲区大小：LogTask 渲染后即释放 (仅在异步模式下有效，2 的幂) */
+#define LOG_RB_SIZE         1024
+/* 多后端分发环大小：各后端按自己的速度读取，落后太多的整条丢弃 (仅在异步模式下有效，2 的幂) */
+#define LOG_FANOUT_SIZE     2048
+/* 分发环最多容纳的记录条数 (记录描述符个数，2 的幂)：短记录很多时按条数先满 */
+#define LOG_FANOUT_RECORDS  128
+/* 最多同时注册的后端数 (<= BR_CURSOR_MAX) */
+#define LOG_BACKEND_MAX     3
+/* 慢后端的在途发送挡住分发时最多等待的时间 (ms)，超时放弃这笔发送 */
+#define LOG_BACKEND_STALL_MS 500
+/* 延迟格式化：调用方只压入 fmt 指针 + 原始参数，由后台任务格式化 (仅在异步模式下有效) */
+#define LOG_DEFERRED_ENABLE 1
+/* 延迟模式下单条日志参数区大小 (字节，%s 字符串内联拷贝) */
+#define LOG_DEFER_ARGS_MAX  96
+/* 延迟模式下单个 %s 参数最多拷贝的字符数 */
+#define LOG_DEFER_STR_MAX   48
+/*
+ * 令牌化日志 (需 LOG_ASYNC_ENABLE)：调用点在编译期化为 .log_dict 段中条目的地址 (ID)，
+ * 参数以 varint 发送，主机端 scripts/log_decode.py 按同一次构建的 ELF 还原文本；
+ * fmt/tag/文件名只存在于不加载的 .log_dict 段，不占 Flash
+ */
+#define LOG_TOKENIZED_ENABLE 0
+/*
+ * 限流 (按 tag)：令牌桶最多连续输出 LOG_RATE_BURST 条，之后每 LOG_RATE_REFILL_MS 补一条，
+ * 超出的整条丢弃并在恢复后报告条数，判定在求值参数之前完成；同一条消息 (调用点与参数都相同)
+ * 在 LOG_REPEAT_WINDOW_MS 内重复出现只计数，窗口结束后输出一条 "又重复了 N 次"，
+ * 判定在参数打包之后、格式化之前完成 (HEX 日志不折叠)。两者都只用 CAS，不关中断
+ */
+#define LOG_RATE_LIMIT_ENABLE 1
+#define LOG_RATE_BURST        16
+#define LOG_RATE_REFILL_MS    100
+#define LOG_REPEAT_WINDOW_MS  1000
 /* HEX一行打印的字节数 */
 #define LOG_HEX_BYTES_PER_LINE     16
 
@@ -27,11 +63,29 @@ typedef enum {
 /* 发送函数抽象 */
 typedef int (*log_send_async_fn_t)(const uint8_t *data, uint16_t len, void *user);
 
+/* 中止在途发送：返回 RET_OK 表示 DMA 已停止读取 data，且这笔不会再有完成通知 */
+typedef int (*log_abort_fn_t)(void *user);
+
+/*
+ * 发送后端：send_async 启动一笔非阻塞发送，data 在完成前保持有效（直接指向分发环）；
+ * 发送完成后调用 Log_BackendTxDoneISR(id)。返回 RET_E_BUSY 表示暂时不能发送，稍后重试
+ * 一笔发送超过 LOG_BACKEND_STALL_MS 未完成时先调用 abort 收回在途数据；没有 abort 或中止失败时
+ * 该后端被摘下，直到迟到的完成通知到来才重新挂接（期间的日志不再输出到该后端）
+ */
 typedef struct {
     log_send_async_fn_t send_async; // 启动发送（最终要DMA/IT非阻塞）
     void *user; // 例如 UART_HandleTypeDef*
+    const char *name; // 后端名称（可为 NULL）
+    log_abort_fn_t abort; // 中止在途发送（可为 NULL）
 } log_backend_t;
 
+/*
+ * 日志时间源：返回自由运行的计数值，按 2^32 回绕；任务和中断中都会调用，须可重入且开销小
+ * (默认 hal_get_cycles 只读 DWT->CYCCNT，不进临界区)。记录里只存原始计数，LogTask 参照
+ * 毫秒计数扩展成 64 位、折算成 us 并计算相邻日志的间隔，所以计数频率须不低于 1kHz
+ */
+typedef uint32_t (*log_clock_fn_t)(void);
+
 
 /* 设置当前系统的过滤等级 (小于此等级的日志不会打印) */
 // 这里默认设为 DEBUG，开发完后可以改成 INFO 或 ERROR
@@ -39,41 +93,189 @@ typedef struct {
 #define LOG_CURRENT_LEVEL   LOG_LEVEL_ALL
 #endif
 
+#define LOG_STR_(x)    #x
+#define LOG_STR(x)     LOG_STR_(x)
+#define LOG_CAT_(a, b) a##b
+#define LOG_CAT(a, b)  LOG_CAT_(a, b)
+
+/* tag ID：由 log_tags.h 的注册表生成 */
+#define LOG_TAG_ENUM(name, level) LOG_TAG_ID_##name,
+typedef enum { LOG_TAG_LIST(LOG_TAG_ENUM) LOG_TAG_COUNT } log_tag_t;
+#undef LOG_TAG_ENUM
+
+/* 各 tag 的运行时等级 (下标为 tag ID)，单字节读写，任务/中断中均可直接访问 */
+extern volatile uint8_t g_log_tag_level[LOG_TAG_COUNT];
+
+/* tag 参数先展开再拼接，允许 HFSM_LOG_TAG 这类别名 */
+#define LOG_TAG_ID(tag)   LOG_CAT(LOG_TAG_ID_, tag)
+#define LOG_TAG_NAME(tag) LOG_STR(tag)
+/* 编译期等级 + 运行时 tag 等级；关闭的 tag 只剩一次字节比较，参数不会被求值 */
+#define LOG_TAG_ON(tag, level) \
+    ((level) <= LOG_CURRENT_LEVEL && (level) <= g_log_tag_level[LOG_TAG_ID(tag)])
+
+/* 按 tag 的令牌桶限流判定 (无锁)；重复折叠要看参数，在参数打包之后由 log.c 判定 */
+bool Log_RateAllow(log_tag_t tag);
+
+/* 等级过滤通过后再做限流判定，两者都在参数求值之前 */
+#if LOG_RATE_LIMIT_ENABLE
+#define LOG_PASS(tag, level) (LOG_TAG_ON(tag, level) && Log_RateAllow(LOG_TAG_ID(tag)))
+#else
+#define LOG_PASS(tag, level) LOG_TAG_ON(tag, level)
+#endif
+
+
+/*
+ * 调用点文件名：优先用编译器给出的不含路径的 __FILE_NAME__ (GCC 12+ / Clang 9+)；
+ * 否则退回 __FILE__ (CMake 已用 -fmacro-prefix-map 去掉工程根路径)，输出时再去掉目录
+ */
+#if defined(__FILE_NAME__)
+#define LOG_FILE_NAME __FILE_NAME__
+#else
+#define LOG_FILE_NAME __FILE__
+#endif
+
+/* 调用点描述符：LOG_x 宏在每个调用点生成一个静态常量，日志只传递它的地址 */
+typedef struct {
+    const char *file;  // 文件名 (LOG_FILE_NAME)
+    const char *tag;   // tag 名称
+    uint16_t line;     // 行号
+    uint8_t level;     // LogLevel_t
+    uint8_t tag_id;    // log_tag_t
+} log_site_t;
+
+/* level 必须是常量表达式 */
+#define LOG_SITE_INIT(t, lvl)            \
+    {.file   = LOG_FILE_NAME,            \
+     .tag    = LOG_TAG_NAME(t),          \
+     .line   = (uint16_t)__LINE__,       \
+     .level  = (uint8_t)(lvl),           \
+     .tag_id = (uint8_t)LOG_TAG_ID(t)}
 
 /* 核心日志输出文件 */
-void Log_Printf(LogLevel_t level, const char *file, int line, const char *tag, const char *fmt, ...);
+void Log_Printf(const log_site_t *site, const char *fmt, ...);
+
+void Log_Hexdump(const log_site_t *site, const void *buf, uint32_t len);
 
-void Log_Hexdump(LogLevel_t level, const char *file, int line, const char *tag, const void *buf, uint32_t len);
+/* 令牌化日志输出 (由 LOG_x 宏调用)：id 为字典条目地址，types 每 4 位描述一个参数的类型 */
+void Log_Token(LogLevel_t level, log_tag_t tag, uint32_t id, uint32_t types, ...);
 
 /* 初始化日志系统 (RTOS模式下必须先调用) */
 void Log_Init(void);
 
+/* 替换时间源 (默认 hal_get_cycles，DWT 周期计数)，hz 为计数频率 (0 取 hal_get_cycles_hz)；
+ * NULL 恢复默认；应在输出第一条日志前调用 */
+void Log_SetClock(log_clock_fn_t clock, uint32_t hz);
+
 /* 发送函数抽象 */
+/* 注册一个后端，只输出等级 <= level 的日志；id 返回后端编号（完成通知用），槽满返回 RET_E_NO_MEM */
+ret_code_t Log_AddBackend(log_backend_t b, LogLevel_t level, uint8_t *id);
+ret_code_t Log_SetBackendLevel(uint8_t id, LogLevel_t level);
+/* 该后端因落后太多而丢弃的日志条数 */
+uint32_t Log_GetBackendDropped(uint8_t id);
+/* 后端的一笔发送完成（中断中调用） */
+void Log_BackendTxDoneISR(uint8_t id);
+
+/* 兼容接口：把 b 设为 0 号后端（输出全部等级），完成通知对应 0 号后端 */
 void Log_SetBackend(log_backend_t b);
 void Log_OnTxDoneISR(void);
 
+/* 运行时调整 tag 等级 (只输出等级 <= level 的日志)，立即生效 */
+ret_code_t Log_SetTagLevel(log_tag_t tag, LogLevel_t level);
+LogLevel_t Log_GetTagLevel(log_tag_t tag);
+/* 按名称调整 (供命令行/远程调试使用)，未注册返回 RET_E_NOT_FOUND */
+ret_code_t Log_SetTagLevelByName(const char *name, LogLevel_t level);
+
 /* ================= 宏定义封装  ================= */
 
-#if  (G_LOG_ENABLE==1)
+#if  (G_LOG_ENABLE==1) && (LOG_TOKENIZED_ENABLE==1)
+
+/* ================= 令牌化日志 ================= */
+/* 帧格式: 0xFF(UTF-8 中不会出现) | 负载长度 | varint(ID) | varint(tick) | 参数...
+ * 参数: 整数为 zigzag varint，浮点为 float32 小端，字符串为 varint(长度) + 字节 */
+#define LOG_TOKEN_SYNC 0xFFu
+
+/* 参数类型编码 (4 位) */
+#define LOG_TT_I32     1u
+#define LOG_TT_I64     2u
+#define LOG_TT_DOUBLE  3u
+#define LOG_TT_STR     4u
+
+/* 字典条目字段分隔符: 等级 | tag | 文件 | 行号 | fmt */
+#define LOG_DICT_SEP   "\x1f"
+
+/* 参数个数 (最多 8 个) */
+#define LOG_NARGS(...) LOG_NARGS_(0, ##__VA_ARGS__, 8, 7, 6, 5, 4, 3, 2, 1, 0)
+#define LOG_NARGS_(_0, _1, _2, _3, _4, _5, _6, _7, _8, N, ...) N
+
+/* 编译期按静态类型得到参数类型编码 */
+#define LOG_ARG_TYPE(x)                                                               \
+    _Generic((x),                                                                     \
+        float: LOG_TT_DOUBLE,                                                         \
+        double: LOG_TT_DOUBLE,                                                        \
+        char *: LOG_TT_STR,                                                           \
+        const char *: LOG_TT_STR,                                                     \
+        default: (sizeof(x) > 4 ? LOG_TT_I64 : LOG_TT_I32))
+
+#define LOG_TT_0()          0u
+#define LOG_TT_1(a)         LOG_ARG_TYPE(a)
+#define LOG_TT_2(a, ...)    (LOG_ARG_TYPE(a) | (LOG_TT_1(__VA_ARGS__) << 4))
+#define LOG_TT_3(a, ...)    (LOG_ARG_TYPE(a) | (LOG_TT_2(__VA_ARGS__) << 4))
+#define LOG_TT_4(a, ...)    (LOG_ARG_TYPE(a) | (LOG_TT_3(__VA_ARGS__) << 4))
+#define LOG_TT_5(a, ...)    (LOG_ARG_TYPE(a) | (LOG_TT_4(__VA_ARGS__) << 4))
+#define LOG_TT_6(a, ...)    (LOG_ARG_TYPE(a) | (LOG_TT_5(__VA_ARGS__) << 4))
+#define LOG_TT_7(a, ...)    (LOG_ARG_TYPE(a) | (LOG_TT_6(__VA_ARGS__) << 4))
+#define LOG_TT_8(a, ...)    (LOG_ARG_TYPE(a) | (LOG_TT_7(__VA_ARGS__) << 4))
+#define LOG_TOKEN_TYPES(...) LOG_CAT(LOG_TT_, LOG_NARGS(__VA_ARGS__))(__VA_ARGS__)
+
+/* tag 为注册表中的名称，fmt 必须是字符串字面量 */
+#define LOG_TOKEN(level, lch, tag, fmt, ...)                                           \
+    do {                                                                               \
+        static const char _log_entry[] CORE_SECTION(".log_dict") CORE_USED =           \
+            lch LOG_DICT_SEP LOG_TAG_NAME(tag) LOG_DICT_SEP LOG_FILE_NAME LOG_DICT_SEP \
+                LOG_STR(__LINE__) LOG_DICT_SEP fmt;                                    \
+        if (LOG_PASS(tag, level)) {                                                    \
+            Log_Token((level), LOG_TAG_ID(tag), (uint32_t)(uintptr_t)_log_entry,       \
+                      LOG_TOKEN_TYPES(__VA_ARGS__), ##__VA_ARGS__);                    \
+        }                                                                              \
+    } while (0)
+
+#define LOG_E(tag, fmt, ...) LOG_TOKEN(LOG_LEVEL_ERROR, "E", tag, fmt, ##__VA_ARGS__)
+#define LOG_W(tag, fmt, ...) LOG_TOKEN(LOG_LEVEL_WARN, "W", tag, fmt, ##__VA_ARGS__)
+#define LOG_I(tag, fmt, ...) LOG_TOKEN(LOG_LEVEL_INFO, "I", tag, fmt, ##__VA_ARGS__)
+#define LOG_D(tag, fmt, ...) LOG_TOKEN(LOG_LEVEL_DEBUG, "D", tag, fmt, ##__VA_ARGS__)
+/* 16进制输出信息 (仍以文本发送，主机端原样透传；不参与重复折叠) */
+#define LOG_HEX(tag, level, buf, len)                                              \
+    do {                                                                           \
+        static const log_site_t _log_site = LOG_SITE_INIT(tag, level);             \
+        if (LOG_PASS(tag, level)) Log_Hexdump(&_log_site, (buf), (uint32_t)(len)); \
+    } while (0)
+
+#elif  (G_LOG_ENABLE==1)
+
+/* 先按 tag 等级与限流过滤，再求值参数 */
+#define LOG_PRINT(level, tag, fmt, ...)                                       \
+    do {                                                                      \
+        static const log_site_t _log_site = LOG_SITE_INIT(tag, level);        \
+        if (LOG_PASS(tag, level)) Log_Printf(&_log_site, fmt, ##__VA_ARGS__); \
+    } while (0)
 
 /* ERROR: 严重错误 */
-#define LOG_E(tag, fmt, ...) \
-Log_Printf(LOG_LEVEL_ERROR, __FILE__, __LINE__, tag, fmt, ##__VA_ARGS__)
+#define LOG_E(tag, fmt, ...) LOG_PRINT(LOG_LEVEL_ERROR, tag, fmt, ##__VA_ARGS__)
 
 /* WARN: 警告，不影响运行但需注意 */
-#define LOG_W(tag, fmt, ...) \
-Log_Printf(LOG_LEVEL_WARN, __FILE__, __LINE__, tag, fmt, ##__VA_ARGS__)
+#define LOG_W(tag, fmt, ...) LOG_PRINT(LOG_LEVEL_WARN, tag, fmt, ##__VA_ARGS__)
 
 /* INFO: 关键流程信息 */
-#define LOG_I(tag, fmt, ...) \
-Log_Printf(LOG_LEVEL_INFO, __FILE__, __LINE__, tag, fmt, ##__VA_ARGS__)
+#define LOG_I(tag, fmt, ...) LOG_PRINT(LOG_LEVEL_INFO, tag, fmt, ##__VA_ARGS__)
 
 /* DEBUG: 调试数据，发布时可关闭 */
-#define LOG_D(tag, fmt, ...) \
-Log_Printf(LOG_LEVEL_DEBUG, __FILE__, __LINE__, tag, fmt, ##__VA_ARGS__)
+#define LOG_D(tag, fmt, ...) LOG_PRINT(LOG_LEVEL_DEBUG, tag, fmt, ##__VA_ARGS__)
 /* 16进制输出信息 */
-#define LOG_HEX(tag, level, buf, len) \
-Log_Hexdump((level), __FILE__, __LINE__, (tag), (buf), (uint32_t)(len))
+#define LOG_HEX(tag, level, buf, len)                                              \
+    do {                                                                           \
+        static const log_site_t _log_site = LOG_SITE_INIT(tag, level);             \
+        if (LOG_PASS(tag, level)) Log_Hexdump(&_log_site, (buf), (uint32_t)(len)); \
+    } while (0)
 #else
 /* 如果关闭日志，这些宏为空，编译时直接优化掉，不占空间 */
 #define LOG_E(tag, fmt, ...)
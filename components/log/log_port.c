@@ -30,11 +30,27 @@ static int Log_uart_send_async(const uint8_t *d, uint16_t n, void *user) {
     return RET_E_IO;
 }
 
+/**
+ * @brief 中止在途的 DMA 发送（阻塞版中止，不会再触发发送完成回调）
+ * @param user 串口句柄
+ * @return 返回是否中止成功
+ */
+static int Log_uart_abort(void *user) {
+    UART_HandleTypeDef *huart = (UART_HandleTypeDef *)user;
+    if (!huart) return RET_E_INVALID_ARG;
+    if (HAL_UART_AbortTransmit(huart) != HAL_OK) return RET_E_IO;
+    s_uart_tx_busy = 0;
+    return RET_OK;
+}
+
 /**
  * @brief 初始化LOG发送端配置
  */
 void Log_PortInit(void) {
-    Log_SetBackend((log_backend_t){.send_async = Log_uart_send_async, .user = &huart1});
+    Log_SetBackend((log_backend_t){.send_async = Log_uart_send_async,
+                                   .user       = &huart1,
+                                   .name       = "uart1",
+                                   .abort      = Log_uart_abort});
 }
 
 /**
@@ -0,0 +1,23 @@
+#ifndef LOG_TAGS_H
+#define LOG_TAGS_H
+
+/*
+ * 日志 tag 注册表：每个 tag 在编译期得到一个小整数 ID (LOG_TAG_ID_xxx)，
+ * 运行时等级保存在以 ID 为下标的数组里，LOG_x 宏在求值参数之前先查表过滤
+ *
+ * 新增 tag：在下表加一行 X(名称, 默认等级)
+ * - 名称是标识符，同时作为输出中的 tag 文本；不要与已有宏重名 (例如 CMSIS 的 DWT)
+ * - 调用处写 LOG_I(AT, "...")，未注册的 tag 编译报错
+ */
+#define LOG_TAG_LIST(X)          \
+    X(LOG, LOG_LEVEL_ALL)        \
+    X(HEAP, LOG_LEVEL_ALL)       \
+    X(TIME, LOG_LEVEL_ALL)       \
+    X(AT, LOG_LEVEL_ALL)         \
+    X(ESP01S, LOG_LEVEL_ALL)     \
+    X(HFSM, LOG_LEVEL_ALL)       \
+    X(KEY, LOG_LEVEL_ALL)        \
+    X(LIGHT, LOG_LEVEL_ALL)      \
+    X(APP, LOG_LEVEL_ALL)
+
+#endif  // LOG_TAGS_H
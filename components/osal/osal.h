@@ -117,6 +117,10 @@ ret_code_t OSAL_thread_flags_set(osal_thread_t t, osal_flags_t flags);
 
 osal_flags_t OSAL_thread_flags_wait(osal_flags_t flags, osal_flags_wait_t mode, uint32_t timeout_ms);
 
+/* 等到绝对 tick（不经 ms 换算，按 tick 精度）；deadline 已过时只检查一次不阻塞 */
+osal_flags_t OSAL_thread_flags_wait_until(osal_flags_t flags, osal_flags_wait_t mode,
+                                          osal_tick_t deadline);
+
 /* ============================================ Atomic原子操作 ====================================================== */
 
 static inline uint32_t OSAL_atomic_add_u32(volatile uint32_t *v, uint32_t delta) {
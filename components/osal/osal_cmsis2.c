@@ -610,4 +610,23 @@ osal_flags_t OSAL_thread_flags_wait(osal_flags_t flags, osal_flags_wait_t mode,
     if (r & 0x80000000u) return 0;
     return (osal_flags_t)r;
 }
+
+/**
+ * @brief 等待flag直到绝对时刻
+ * @param flags 要等待的flag
+ * @param mode  flag匹配模式
+ * @param deadline 截止 tick（与 OSAL_tick_get 同一时基，允许回绕）
+ * @return 截止前获取到的flag，超时返回 0
+ * @note  剩余时间直接以 tick 交给内核，不经 ms 换算的向上取整
+ */
+osal_flags_t OSAL_thread_flags_wait_until(osal_flags_t flags, osal_flags_wait_t mode,
+                                          osal_tick_t deadline) {
+    /* 有符号差处理回绕；已过期时以 0 超时只检查一次 */
+    const int32_t left = (int32_t)(deadline - OSAL_tick_get());
+    const uint32_t to  = (left > 0) ? (uint32_t)left : 0U;
+    const uint32_t opt = (mode == OSAL_FLAGS_WAIT_ALL) ? osFlagsWaitAll : osFlagsWaitAny;
+    const uint32_t r   = osThreadFlagsWait((uint32_t)flags, opt, to);
+    if (r & 0x80000000u) return 0;
+    return (osal_flags_t)r;
+}
 #endif
@@ -0,0 +1,314 @@
+#include "APP_config.h"
+/* 全局配置开启宏 */
+#if defined(ENABLE_RINGBUFFER_SYSTEM)
+#include "BroadcastRing.h"
+
+#include <stdbool.h>
+#include <string.h>
+
+#include "MemoryAllocation.h"
+#include "rb_port.h"
+#include "utils_def.h"
+
+/*
+ * 无锁协议（与 seqlock 类似）：
+ * - 生产者：先把要被覆盖的游标置 overrun，RB_FENCE 后再覆盖数据，最后 release 发布 rear
+ * - 消费者：acquire 读 rear 后拷贝/访问数据，RB_FENCE 后复查 overrun；置位说明数据可能已被覆盖，
+ *   丢弃本次结果并重同步到最新写位置
+ */
+
+/**
+ * @brief 从累计计数 index 处拷出 n 字节（可能跨越末尾）
+ * @param br 广播环
+ * @param index 累计计数
+ * @param dst 目标地址
+ * @param n 字节数
+ */
+static inline void BroadcastRing_CopyOut(const BroadcastRing* br, const uint32_t index,
+                                         uint8_t* dst, const uint32_t n) {
+    const uint32_t off   = index & br->mask;
+    const uint32_t first = MIN(n, br->size - off);
+    memcpy(dst, br->buffer + off, first);
+    if (n > first) memcpy(dst + first, br->buffer, n - first);
+}
+
+/**
+ * @brief 向累计计数 index 处拷入 n 字节（可能跨越末尾）
+ * @param br 广播环
+ * @param index 累计计数
+ * @param src 数据源
+ * @param n 字节数
+ */
+static inline void BroadcastRing_CopyIn(BroadcastRing* br, const uint32_t index, const uint8_t* src,
+                                        const uint32_t n) {
+    const uint32_t off   = index & br->mask;
+    const uint32_t first = MIN(n, br->size - off);
+    memcpy(br->buffer + off, src, first);
+    if (n > first) memcpy(br->buffer, src + first, n - first);
+}
+
+/**
+ * @brief 被甩开的游标跳到最新写位置并清除 overrun（仅该消费者调用）
+ * @param cur 游标
+ */
+static void BroadcastRing_Resync(BroadcastCursor* cur) {
+    const uint32_t rear = RB_LOAD_ACQUIRE(&cur->owner->rear);
+    cur->dropped += rear - cur->pos;
+    cur->overruns++;
+    RB_STORE_RELEASE(&cur->pos, rear);
+    /* 先让生产者看到新位置，再清除标记 */
+    RB_FENCE();
+    cur->overrun = false;
+}
+
+/**
+ * @brief 创建广播环
+ * @param br 广播环句柄
+ * @param name 名称
+ * @param size 缓冲区大小（必须为 2 的幂）
+ * @return 返回是否创建成功
+ */
+ret_code_t CreateBroadcastRing(BroadcastRing* br, const char* name, const uint32_t size) {
+    if (br == NULL || size < 2 || size > (UINT32_MAX >> 1) || (size & (size - 1)) != 0)
+        return RET_E_INVALID_ARG;
+
+    br->buffer = static_alloc(size, DEFAULT_ALIGNMENT);
+    if (br->buffer == NULL) {
+        br->size = 0;
+        return RET_E_NO_MEM;
+    }
+    br->name = name;
+    br->size = size;
+    br->mask = size - 1;
+    br->rear = 0;
+    for (uint32_t i = 0; i < BR_CURSOR_MAX; i++) {
+        memset(&br->cursors[i], 0, sizeof(br->cursors[i]));
+        br->cursors[i].owner = br;
+    }
+    return RET_OK;
+}
+
+/**
+ * @brief 挂接一个读游标
+ * @param br 广播环句柄
+ * @param name 消费者名称
+ * @param out 返回的游标
+ * @return 游标槽已满返回 RET_E_NO_MEM
+ * @note  从挂接时刻的写位置开始读取，之前的数据不可见
+ */
+ret_code_t BroadcastRing_Attach(BroadcastRing* br, const char* name, BroadcastCursor** out) {
+    if (br == NULL || br->buffer == NULL || out == NULL) return RET_E_INVALID_ARG;
+
+    ret_code_t rc = RET_E_NO_MEM;
+    /* 只保护槽分配；生产者不关心未激活的槽 */
+    RB_ENTER_CRITICAL();
+    for (uint32_t i = 0; i < BR_CURSOR_MAX; i++) {
+        BroadcastCursor* cur = &br->cursors[i];
+        if (cur->active) continue;
+        cur->name     = name;
+        cur->overrun  = false;
+        cur->overruns = 0;
+        cur->dropped  = 0;
+        RB_STORE_RELEASE(&cur->pos, br->rear);
+        RB_FENCE();
+        cur->active = true;
+        *out        = cur;
+        rc          = RET_OK;
+        break;
+    }
+    RB_EXIT_CRITICAL();
+    return rc;
+}
+
+/**
+ * @brief 摘除读游标（之后生产者不再为它保留空间）
+ * @param cur 游标
+ */
+void BroadcastRing_Detach(BroadcastCursor* cur) {
+    if (cur == NULL) return;
+    cur->active = false;
+}
+
+/**
+ * @brief 分散写入（唯一生产者）
+ * @param br 广播环句柄
+ * @param vec 数据段数组
+ * @param cnt 段数
+ * @return 总长为 0 或超过 size 返回 RET_E_INVALID_ARG
+ * @note  无锁，可在中断中调用；写不下时甩开积压过多的游标而不是失败
+ */
+ret_code_t BroadcastRing_WriteV(BroadcastRing* br, const RingBufferConstVec* vec,
+                                const uint32_t cnt) {
+    if (br == NULL || br->buffer == NULL || vec == NULL || cnt == 0) return RET_E_INVALID_ARG;
+
+    uint32_t total = 0;
+    for (uint32_t i = 0; i < cnt; i++) {
+        if (vec[i].len != 0 && vec[i].ptr == NULL) return RET_E_INVALID_ARG;
+        if (vec[i].len > br->size - total) return RET_E_INVALID_ARG;
+        total += vec[i].len;
+    }
+    if (total == 0) return RET_E_INVALID_ARG;
+
+    /* 1、积压 + 本次超过容量的游标：标记 overrun，不再等待它 */
+    const uint32_t rear = br->rear;
+    bool marked         = false;
+    for (uint32_t i = 0; i < BR_CURSOR_MAX; i++) {
+        BroadcastCursor* cur = &br->cursors[i];
+        if (!cur->active || cur->overrun) continue;
+        if (rear - RB_LOAD_ACQUIRE(&cur->pos) > br->size - total) {
+            cur->overrun = true;
+            marked       = true;
+        }
+    }
+    /* 标记必须先于覆盖数据被消费者看到 */
+    if (marked) RB_FENCE();
+
+    /* 2、只拷贝一次，所有游标共享 */
+    uint32_t idx = rear;
+    for (uint32_t i = 0; i < cnt; i++) {
+        if (vec[i].len == 0) continue;
+        BroadcastRing_CopyIn(br, idx, vec[i].ptr, vec[i].len);
+        idx += vec[i].len;
+    }
+
+    /* 3、发布 */
+    RB_STORE_RELEASE(&br->rear, idx);
+    return RET_OK;
+}
+
+/**
+ * @brief 写入（唯一生产者）
+ * @param br 广播环句柄
+ * @param data 数据源
+ * @param len 字节数（<= size）
+ * @return 返回是否成功
+ */
+ret_code_t BroadcastRing_Write(BroadcastRing* br, const uint8_t* data, const uint32_t len) {
+    const RingBufferConstVec v = {.ptr = data, .len = len};
+    return BroadcastRing_WriteV(br, &v, 1);
+}
+
+/**
+ * @brief 不甩开任何正常游标还能写入的字节数
+ * @param br 广播环句柄
+ * @return 字节数（没有游标时为 size）
+ */
+uint32_t BroadcastRing_GetRemainSize(const BroadcastRing* br) {
+    if (br == NULL || br->buffer == NULL) return 0;
+
+    const uint32_t rear = RB_LOAD_ACQUIRE(&br->rear);
+    uint32_t lag        = 0;
+    for (uint32_t i = 0; i < BR_CURSOR_MAX; i++) {
+        const BroadcastCursor* cur = &br->cursors[i];
+        if (!cur->active || cur->overrun) continue;
+        lag = MAX(lag, rear - RB_LOAD_ACQUIRE(&cur->pos));
+    }
+    return (lag >= br->size) ? 0 : (br->size - lag);
+}
+
+/**
+ * @brief 游标待读字节数
+ * @param cur 游标
+ * @return 字节数（被甩开时为 0）
+ */
+uint32_t BroadcastRing_GetUsedSize(const BroadcastCursor* cur) {
+    if (cur == NULL || !cur->active || cur->overrun) return 0;
+    const uint32_t used = RB_LOAD_ACQUIRE(&cur->owner->rear) - cur->pos;
+    return MIN(used, cur->owner->size);
+}
+
+/**
+ * @brief 读出最多 cap 字节
+ * @param cur 游标
+ * @param buf 接收地址
+ * @param cap 接收区容量
+ * @param n 实际读出字节数
+ * @return 为空返回 RET_E_DATA_NOT_ENOUGH；被甩开返回 RET_E_DATA_OVERFLOW
+ */
+ret_code_t BroadcastRing_Read(BroadcastCursor* cur, uint8_t* buf, const uint32_t cap, uint32_t* n) {
+    if (cur == NULL || !cur->active || buf == NULL || cap == 0 || n == NULL)
+        return RET_E_INVALID_ARG;
+    *n = 0;
+
+    if (cur->overrun) {
+        BroadcastRing_Resync(cur);
+        return RET_E_DATA_OVERFLOW;
+    }
+
+    const BroadcastRing* br = cur->owner;
+    const uint32_t pos      = cur->pos;
+    const uint32_t avail    = RB_LOAD_ACQUIRE(&br->rear) - pos;
+    if (avail == 0) return RET_E_DATA_NOT_ENOUGH;
+
+    const uint32_t c = MIN(avail, cap);
+    BroadcastRing_CopyOut(br, pos, buf, c);
+
+    /* 拷贝期间可能被覆盖：复查标记 */
+    RB_FENCE();
+    if (cur->overrun) {
+        BroadcastRing_Resync(cur);
+        return RET_E_DATA_OVERFLOW;
+    }
+    RB_STORE_RELEASE(&cur->pos, pos + c);
+    *n = c;
+    return RET_OK;
+}
+
+/**
+ * @brief 零拷贝访问待读数据
+ * @param cur 游标
+ * @param want 最多访问的字节数
+ * @param out 窗口（跨越末尾时 p2 非空）
+ * @param granted 实际窗口大小
+ * @return 为空返回 RET_E_DATA_NOT_ENOUGH；被甩开返回 RET_E_DATA_OVERFLOW
+ * @note  窗口内数据在 ReadCommit 返回 RET_OK 后才可信
+ */
+ret_code_t BroadcastRing_ReadReserve(BroadcastCursor* cur, const uint32_t want,
+                                     RingBufferSpan* out, uint32_t* granted) {
+    if (cur == NULL || !cur->active || out == NULL || granted == NULL) return RET_E_INVALID_ARG;
+    out->p1 = out->p2 = NULL;
+    out->n1 = out->n2 = 0;
+    *granted          = 0;
+
+    if (cur->overrun) {
+        BroadcastRing_Resync(cur);
+        return RET_E_DATA_OVERFLOW;
+    }
+
+    const BroadcastRing* br = cur->owner;
+    const uint32_t pos      = cur->pos;
+    const uint32_t g        = MIN(want, RB_LOAD_ACQUIRE(&br->rear) - pos);
+    if (g == 0) return RET_E_DATA_NOT_ENOUGH;
+
+    const uint32_t off = pos & br->mask;
+    out->p1            = br->buffer + off;
+    out->n1            = MIN(g, br->size - off);
+    if (g > out->n1) {
+        out->p2 = br->buffer;
+        out->n2 = g - out->n1;
+    }
+    *granted = g;
+    return RET_OK;
+}
+
+/**
+ * @brief 释放零拷贝窗口
+ * @param cur 游标
+ * @param commit 消费的字节数
+ * @return 访问期间被甩开（窗口数据已失效）返回 RET_E_DATA_OVERFLOW
+ */
+ret_code_t BroadcastRing_ReadCommit(BroadcastCursor* cur, const uint32_t commit) {
+    if (cur == NULL || !cur->active) return RET_E_INVALID_ARG;
+
+    RB_FENCE();
+    if (cur->overrun) {
+        BroadcastRing_Resync(cur);
+        return RET_E_DATA_OVERFLOW;
+    }
+    const uint32_t pos = cur->pos;
+    if (commit > RB_LOAD_ACQUIRE(&cur->owner->rear) - pos) return RET_E_INVALID_ARG;
+    RB_STORE_RELEASE(&cur->pos, pos + commit);
+    return RET_OK;
+}
+
+#endif
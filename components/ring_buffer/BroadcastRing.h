@@ -0,0 +1,77 @@
+#ifndef BROADCASTRING_H
+#define BROADCASTRING_H
+#include <stdbool.h>
+
+#include "RingBuffer.h"
+#include "ret_code.h"
+#include "stdint.h"
+
+/* 最多同时挂接的读游标数 */
+#define BR_CURSOR_MAX 4
+
+struct BroadcastRing;
+
+/* 读游标：每个消费者独立推进，互不影响 */
+typedef struct {
+    struct BroadcastRing *owner;  // 所属广播环
+    const char *name;             // 消费者名称
+    volatile uint32_t pos;        // 已读累计计数（仅该消费者推进）
+    volatile bool overrun;        // 被生产者甩开（生产者置位，消费者重同步后清除）
+    volatile bool active;         // 是否挂接
+    uint32_t overruns;            // 累计被甩开次数
+    uint32_t dropped;             // 累计因被甩开而丢失的字节数
+} BroadcastCursor;
+
+/*
+ * 单生产者/多消费者广播环
+ * - 生产者只写一份数据，各消费者通过自己的游标读取（或零拷贝访问）同一份字节流
+ * - 生产者看到的空闲空间 = size - 最慢的正常游标的积压；写不下时把积压过多的游标标记为
+ *   overrun 并不再等待它，生产者永不阻塞；该消费者下次读取时收到 RET_E_DATA_OVERFLOW 并跳到最新数据
+ * - 全程无锁：生产者可在中断中写入，消费者各在自己的任务中读取
+ * - size 必须为 2 的幂
+ */
+typedef struct BroadcastRing {
+    const char *name;
+    uint8_t *buffer;
+    uint32_t size;
+    uint32_t mask;
+    volatile uint32_t rear;                  // 已写入累计计数（仅生产者推进）
+    BroadcastCursor cursors[BR_CURSOR_MAX];  // 游标槽
+} BroadcastRing;
+
+ret_code_t CreateBroadcastRing(BroadcastRing *br, const char *name, uint32_t size);
+
+/* 挂接一个读游标，从当前写位置开始读取；游标已满返回 RET_E_NO_MEM */
+ret_code_t BroadcastRing_Attach(BroadcastRing *br, const char *name, BroadcastCursor **out);
+
+void BroadcastRing_Detach(BroadcastCursor *cur);
+
+/* ================= 生产者（唯一，可在中断中调用） ================= */
+
+/* 写入 len 字节（len <= size）；空间不足时甩开积压最多的游标，不会失败 */
+ret_code_t BroadcastRing_Write(BroadcastRing *br, const uint8_t *data, uint32_t len);
+
+ret_code_t BroadcastRing_WriteV(BroadcastRing *br, const RingBufferConstVec *vec, uint32_t cnt);
+
+/* 最慢的正常游标之后还能写入而不甩开任何人的字节数 */
+uint32_t BroadcastRing_GetRemainSize(const BroadcastRing *br);
+
+/* ================= 消费者（每个游标一个任务） ================= */
+
+/* 该游标待读字节数 */
+uint32_t BroadcastRing_GetUsedSize(const BroadcastCursor *cur);
+
+/*
+ * 读出最多 cap 字节，n 返回实际字节数
+ * 为空返回 RET_E_DATA_NOT_ENOUGH；被甩开返回 RET_E_DATA_OVERFLOW（游标已跳到最新数据，n 为 0）
+ */
+ret_code_t BroadcastRing_Read(BroadcastCursor *cur, uint8_t *buf, uint32_t cap, uint32_t *n);
+
+/* 零拷贝访问待读数据（最多 want 字节，跨越末尾时分 p1/p2 两段） */
+ret_code_t BroadcastRing_ReadReserve(BroadcastCursor *cur, uint32_t want, RingBufferSpan *out,
+                                     uint32_t *granted);
+
+/* 释放 ReadReserve 得到的窗口；若期间被甩开（窗口数据已失效）返回 RET_E_DATA_OVERFLOW */
+ret_code_t BroadcastRing_ReadCommit(BroadcastCursor *cur, uint32_t commit);
+
+#endif  // BROADCASTRING_H
@@ -0,0 +1,451 @@
+#include "APP_config.h"
+/* 全局配置开启宏 */
+#if defined(ENABLE_RINGBUFFER_SYSTEM)
+#include "RecordRing.h"
+
+#include <stdbool.h>
+#include <string.h>
+
+#include "rb_port.h"
+#include "utils_def.h"
+
+/* 覆盖模式下生产者会推进 front，整个记录操作需要放在同一临界区内（临界区可嵌套） */
+#define RR_LOCK(rr)                  \
+    do {                             \
+        if ((rr)->isOverwrite) {     \
+            RB_ENTER_CRITICAL();     \
+        }                            \
+    } while (0)
+
+#define RR_UNLOCK(rr)                \
+    do {                             \
+        if ((rr)->isOverwrite) {     \
+            RB_EXIT_CRITICAL();      \
+        }                            \
+    } while (0)
+
+#define RR_LOCK_FROM_ISR(rr, s)                \
+    do {                                       \
+        if ((rr)->isOverwrite) {               \
+            RB_ENTER_CRITICAL_FROM_ISR(s);     \
+        }                                      \
+    } while (0)
+
+#define RR_UNLOCK_FROM_ISR(rr, s)              \
+    do {                                       \
+        if ((rr)->isOverwrite) {               \
+            RB_EXIT_CRITICAL_FROM_ISR(s);      \
+        }                                      \
+    } while (0)
+
+/**
+ * @brief 向窗口中偏移 offset 处拷入 n 字节（窗口可能分 p1/p2 两段）
+ * @param span 写窗口
+ * @param offset 窗口内偏移
+ * @param src 数据源
+ * @param n 字节数
+ */
+static void RecordRing_SpanCopyIn(const RingBufferSpan* span, uint32_t offset, const uint8_t* src,
+                                  uint32_t n) {
+    if (offset < span->n1) {
+        const uint32_t c = MIN(n, span->n1 - offset);
+        memcpy(span->p1 + offset, src, c);
+        src += c;
+        n -= c;
+        offset = 0;
+    } else {
+        offset -= span->n1;
+    }
+    if (n > 0) memcpy(span->p2 + offset, src, n);
+}
+
+/**
+ * @brief 读窗口去掉前 skip 字节（记录头可能跨越末尾）
+ * @param span 读窗口
+ * @param skip 跳过的字节数
+ */
+static void RecordRing_SpanSkip(RingBufferSpan* span, const uint32_t skip) {
+    if (skip < span->n1) {
+        span->p1 += skip;
+        span->n1 -= skip;
+        return;
+    }
+    /* 头部占满 p1（或跨到 p2），负载全部在 p2 */
+    const uint32_t rest = skip - span->n1;
+    span->p1            = (span->n2 > rest) ? span->p2 + rest : NULL;
+    span->n1            = span->n2 - rest;
+    span->p2            = NULL;
+    span->n2            = 0;
+}
+
+/**
+ * @brief 创建记录环
+ * @param rr 记录环句柄
+ * @param name 名称
+ * @param size 底层缓冲区大小（建议 2 的幂）
+ * @return 返回是否创建成功
+ */
+ret_code_t CreateRecordRing(RecordRing* rr, const char* name, const uint32_t size) {
+    return CreateRecordRingEx(rr, name, size, RB_FLAG_NONE);
+}
+
+/**
+ * @brief 创建记录环（带模式标志）
+ * @param rr 记录环句柄
+ * @param name 名称
+ * @param size 底层缓冲区大小（建议 2 的幂）
+ * @param flags RB_FLAG_NONE / RB_FLAG_OVERWRITE
+ * @return 返回是否创建成功
+ */
+ret_code_t CreateRecordRingEx(RecordRing* rr, const char* name, const uint32_t size,
+                              const uint32_t flags) {
+    if (rr == NULL || size <= RR_HDR_SIZE || (flags & ~RB_FLAG_OVERWRITE) != 0u)
+        return RET_E_INVALID_ARG;
+    rr->pending         = 0;
+    rr->isOverwrite     = ((flags & RB_FLAG_OVERWRITE) != 0u);
+    rr->evicted_records = 0;
+    rr->evicted_bytes   = 0;
+    /* 覆盖按整条记录进行，底层不能按字节覆盖：覆盖模式用普通临界区模式，否则 SPSC 无锁 */
+    return CreateRingBufferEx(&rr->rb, name, size, rr->isOverwrite ? RB_FLAG_NONE : RB_FLAG_SPSC);
+}
+
+/**
+ * @brief 读取 front 处的记录头（不消费）
+ * @param rr 记录环句柄
+ * @param fromISR 是否中断上下文
+ * @param len 负载长度
+ * @return 为空返回 RET_E_DATA_NOT_ENOUGH
+ */
+static ret_code_t RecordRing_PeekHdr(RecordRing* rr, const bool fromISR, uint32_t* len) {
+    RingBufferSpan span;
+    uint32_t granted    = 0;
+    const ret_code_t rc =
+        fromISR ? RingBuffer_ReadReserveFromISR(&rr->rb, RR_HDR_SIZE, &span, &granted, false)
+                : RingBuffer_ReadReserve(&rr->rb, RR_HDR_SIZE, &span, &granted, false);
+    if (ret_is_err(rc)) return rc;
+
+    /* 头部本身也可能跨越末尾 */
+    const uint8_t lo = span.p1[0];
+    const uint8_t hi = (span.n1 > 1) ? span.p1[1] : span.p2[0];
+    *len             = (uint32_t)lo | ((uint32_t)hi << 8);
+    return RET_OK;
+}
+
+/**
+ * @brief 覆盖模式：按整条记录挤掉最旧记录，直到空闲 >= need（调用方持锁）
+ * @param rr 记录环句柄
+ * @param need 需要的空闲字节数
+ * @param fromISR 是否中断上下文
+ */
+static void RecordRing_Evict(RecordRing* rr, const uint32_t need, const bool fromISR) {
+    while ((fromISR ? RingBuffer_GetRemainSizeFromISR(&rr->rb)
+                    : RingBuffer_GetRemainSize(&rr->rb)) < need) {
+        uint32_t len = 0;
+        if (ret_is_err(RecordRing_PeekHdr(rr, fromISR, &len))) break;
+
+        uint32_t dropped = 0;
+        const ret_code_t rc =
+            fromISR ? RingBuffer_DropFromISR(&rr->rb, RR_HDR_SIZE + len, &dropped, false)
+                    : RingBuffer_Drop(&rr->rb, RR_HDR_SIZE + len, &dropped, false);
+        if (ret_is_err(rc)) break;
+        rr->evicted_records++;
+        rr->evicted_bytes += dropped;
+    }
+}
+
+/**
+ * @brief 向挂起记录追加负载（写到未发布区域，消费者不可见；调用方持锁）
+ * @param rr 记录环句柄
+ * @param data 数据源
+ * @param len 字节数
+ * @param fromISR 是否中断上下文
+ * @return 返回是否成功
+ */
+static ret_code_t RecordRing_Append_Internal(RecordRing* rr, const uint8_t* data,
+                                             const uint32_t len, const bool fromISR) {
+    if (rr == NULL || (data == NULL && len != 0)) return RET_E_INVALID_ARG;
+    if (len == 0) return RET_OK;
+    if (len > RR_RECORD_MAX - rr->pending) return RET_E_NO_MEM;
+
+    /* 申请 头 + 已挂起 + 本次 的连续空间，只在尾部拷贝本次数据，不提交 */
+    const uint32_t need = RR_HDR_SIZE + rr->pending + len;
+    // 整个环都装不下的记录直接失败，不能先把已有记录全部挤掉
+    if (need > rr->rb.size) return RET_E_NO_MEM;
+    if (rr->isOverwrite) RecordRing_Evict(rr, need, fromISR);
+    RingBufferSpan span;
+    uint32_t granted = 0;
+    const ret_code_t rc =
+        fromISR ? RingBuffer_WriteReserveFromISR(&rr->rb, need, &span, &granted, false)
+                : RingBuffer_WriteReserve(&rr->rb, need, &span, &granted, false);
+    if (ret_is_err(rc)) return rc;
+
+    RecordRing_SpanCopyIn(&span, RR_HDR_SIZE + rr->pending, data, len);
+    rr->pending += len;
+    return RET_OK;
+}
+
+/**
+ * @brief 提交挂起记录：补写头部后一次性发布（调用方持锁）
+ * @param rr 记录环句柄
+ * @param fromISR 是否中断上下文
+ * @return 返回是否成功
+ */
+static ret_code_t RecordRing_Commit_Internal(RecordRing* rr, const bool fromISR) {
+    if (rr == NULL) return RET_E_INVALID_ARG;
+
+    const uint32_t total = RR_HDR_SIZE + rr->pending;
+    if (rr->isOverwrite) RecordRing_Evict(rr, total, fromISR);
+    RingBufferSpan span;
+    uint32_t granted = 0;
+    ret_code_t rc =
+        fromISR ? RingBuffer_WriteReserveFromISR(&rr->rb, total, &span, &granted, false)
+                : RingBuffer_WriteReserve(&rr->rb, total, &span, &granted, false);
+    if (ret_is_err(rc)) return rc;
+
+    const uint8_t hdr[RR_HDR_SIZE] = {(uint8_t)(rr->pending & 0xFFu),
+                                      (uint8_t)((rr->pending >> 8) & 0xFFu)};
+    RecordRing_SpanCopyIn(&span, 0, hdr, RR_HDR_SIZE);
+
+    rc = fromISR ? RingBuffer_WriteCommitFromISR(&rr->rb, total)
+                 : RingBuffer_WriteCommit(&rr->rb, total);
+    if (ret_is_ok(rc)) rr->pending = 0;
+    return rc;
+}
+
+/**
+ * @brief 向挂起记录追加负载
+ * @param rr 记录环句柄
+ * @param data 数据源
+ * @param len 字节数
+ * @return 返回是否成功
+ */
+ret_code_t RecordRing_Append(RecordRing* rr, const uint8_t* data, uint32_t len) {
+    if (rr == NULL) return RET_E_INVALID_ARG;
+    RR_LOCK(rr);
+    const ret_code_t rc = RecordRing_Append_Internal(rr, data, len, false);
+    RR_UNLOCK(rr);
+    return rc;
+}
+
+/**
+ * @brief 向挂起记录追加负载 中断版本
+ * @param rr 记录环句柄
+ * @param data 数据源
+ * @param len 字节数
+ * @return 返回是否成功
+ */
+ret_code_t RecordRing_AppendFromISR(RecordRing* rr, const uint8_t* data, uint32_t len) {
+    if (rr == NULL) return RET_E_INVALID_ARG;
+    rb_isr_state_t saved = 0;
+    RR_LOCK_FROM_ISR(rr, saved);
+    const ret_code_t rc = RecordRing_Append_Internal(rr, data, len, true);
+    RR_UNLOCK_FROM_ISR(rr, saved);
+    return rc;
+}
+
+/**
+ * @brief 提交挂起记录
+ * @param rr 记录环句柄
+ * @return 返回是否成功
+ */
+ret_code_t RecordRing_Commit(RecordRing* rr) {
+    if (rr == NULL) return RET_E_INVALID_ARG;
+    RR_LOCK(rr);
+    const ret_code_t rc = RecordRing_Commit_Internal(rr, false);
+    RR_UNLOCK(rr);
+    return rc;
+}
+
+/**
+ * @brief 提交挂起记录 中断版本
+ * @param rr 记录环句柄
+ * @return 返回是否成功
+ */
+ret_code_t RecordRing_CommitFromISR(RecordRing* rr) {
+    if (rr == NULL) return RET_E_INVALID_ARG;
+    rb_isr_state_t saved = 0;
+    RR_LOCK_FROM_ISR(rr, saved);
+    const ret_code_t rc = RecordRing_Commit_Internal(rr, true);
+    RR_UNLOCK_FROM_ISR(rr, saved);
+    return rc;
+}
+
+/**
+ * @brief 放弃挂起记录（已追加的字节从未发布，直接丢弃计数即可）
+ * @param rr 记录环句柄
+ */
+void RecordRing_Abort(RecordRing* rr) {
+    if (rr != NULL) rr->pending = 0;
+}
+
+/**
+ * @brief 一次写入整条记录
+ * @param rr 记录环句柄
+ * @param data 数据源
+ * @param len 负载长度
+ * @return 返回是否成功
+ */
+ret_code_t RecordRing_Write(RecordRing* rr, const uint8_t* data, uint32_t len) {
+    if (rr == NULL) return RET_E_INVALID_ARG;
+    if (rr->pending != 0) return RET_E_BUSY;
+
+    RR_LOCK(rr);
+    ret_code_t rc = RecordRing_Append_Internal(rr, data, len, false);
+    if (ret_is_ok(rc)) rc = RecordRing_Commit_Internal(rr, false);
+    RR_UNLOCK(rr);
+    return rc;
+}
+
+/**
+ * @brief 一次写入整条记录 中断版本
+ * @param rr 记录环句柄
+ * @param data 数据源
+ * @param len 负载长度
+ * @return 返回是否成功
+ */
+ret_code_t RecordRing_WriteFromISR(RecordRing* rr, const uint8_t* data, uint32_t len) {
+    if (rr == NULL) return RET_E_INVALID_ARG;
+    if (rr->pending != 0) return RET_E_BUSY;
+
+    rb_isr_state_t saved = 0;
+    RR_LOCK_FROM_ISR(rr, saved);
+    ret_code_t rc = RecordRing_Append_Internal(rr, data, len, true);
+    if (ret_is_ok(rc)) rc = RecordRing_Commit_Internal(rr, true);
+    RR_UNLOCK_FROM_ISR(rr, saved);
+    return rc;
+}
+
+/**
+ * @brief 获取下一条记录的负载长度
+ * @param rr 记录环句柄
+ * @param len 负载长度
+ * @return 为空返回 RET_E_DATA_NOT_ENOUGH
+ */
+ret_code_t RecordRing_Peek(const RecordRing* rr, uint32_t* len) {
+    if (rr == NULL || len == NULL) return RET_E_INVALID_ARG;
+
+    uint8_t hdr[RR_HDR_SIZE];
+    uint32_t n          = RR_HDR_SIZE;
+    const ret_code_t rc = PeekRingBuffer(&rr->rb, hdr, &n, 0);
+    if (ret_is_err(rc)) return rc;
+
+    *len = (uint32_t)hdr[0] | ((uint32_t)hdr[1] << 8);
+    return RET_OK;
+}
+
+/**
+ * @brief 零拷贝访问下一条记录的负载（调用方持锁）
+ * @param rr 记录环句柄
+ * @param out 负载窗口
+ * @return 为空返回 RET_E_DATA_NOT_ENOUGH
+ */
+static ret_code_t RecordRing_ReadReserve_Internal(RecordRing* rr, RingBufferSpan* out) {
+    uint32_t len  = 0;
+    ret_code_t rc = RecordRing_PeekHdr(rr, false, &len);
+    if (ret_is_err(rc)) return rc;
+
+    /* 头部已提交即意味着整条记录已发布 */
+    uint32_t granted = 0;
+    rc               = RingBuffer_ReadReserve(&rr->rb, RR_HDR_SIZE + len, out, &granted, false);
+    if (ret_is_err(rc)) return rc;
+
+    RecordRing_SpanSkip(out, RR_HDR_SIZE);
+    return RET_OK;
+}
+
+/**
+ * @brief 跳过下一条记录（调用方持锁）
+ * @param rr 记录环句柄
+ * @return 为空返回 RET_E_DATA_NOT_ENOUGH
+ */
+static ret_code_t RecordRing_Skip_Internal(RecordRing* rr) {
+    uint32_t len        = 0;
+    const ret_code_t rc = RecordRing_PeekHdr(rr, false, &len);
+    if (ret_is_err(rc)) return rc;
+
+    uint32_t dropped = 0;
+    return RingBuffer_Drop(&rr->rb, RR_HDR_SIZE + len, &dropped, false);
+}
+
+/**
+ * @brief 读出并消费下一条记录
+ * @param rr 记录环句柄
+ * @param buf 接收地址
+ * @param cap 接收区容量
+ * @param len 记录的完整负载长度
+ * @return cap 不足时拷贝 cap 字节并返回 RET_E_DATA_OVERFLOW（记录仍被整条消费）
+ */
+ret_code_t RecordRing_Read(RecordRing* rr, uint8_t* buf, uint32_t cap, uint32_t* len) {
+    if (rr == NULL || len == NULL || (buf == NULL && cap != 0)) return RET_E_INVALID_ARG;
+
+    RR_LOCK(rr);
+    RingBufferSpan span;
+    ret_code_t rc = RecordRing_ReadReserve_Internal(rr, &span);
+    if (ret_is_ok(rc)) {
+        const uint32_t c1 = MIN(cap, span.n1);
+        const uint32_t c2 = MIN(cap - c1, span.n2);
+        if (c1 > 0) memcpy(buf, span.p1, c1);
+        if (c2 > 0) memcpy(buf + c1, span.p2, c2);
+
+        *len = span.n1 + span.n2;
+        rc   = RecordRing_Skip_Internal(rr);
+    }
+    RR_UNLOCK(rr);
+
+    if (ret_is_err(rc)) return rc;
+    return (*len > cap) ? RET_E_DATA_OVERFLOW : RET_OK;
+}
+
+/**
+ * @brief 跳过下一条记录
+ * @param rr 记录环句柄
+ * @return 为空返回 RET_E_DATA_NOT_ENOUGH
+ */
+ret_code_t RecordRing_Skip(RecordRing* rr) {
+    if (rr == NULL) return RET_E_INVALID_ARG;
+
+    RR_LOCK(rr);
+    const ret_code_t rc = RecordRing_Skip_Internal(rr);
+    RR_UNLOCK(rr);
+    return rc;
+}
+
+/**
+ * @brief 零拷贝访问下一条记录的负载
+ * @param rr 记录环句柄
+ * @param out 负载窗口（跨越末尾时 p2 非空）
+ * @return 为空返回 RET_E_DATA_NOT_ENOUGH
+ * @note  窗口在调用 RecordRing_Skip 之前一直有效（覆盖模式除外）
+ */
+ret_code_t RecordRing_ReadReserve(RecordRing* rr, RingBufferSpan* out) {
+    if (rr == NULL || out == NULL) return RET_E_INVALID_ARG;
+
+    RR_LOCK(rr);
+    const ret_code_t rc = RecordRing_ReadReserve_Internal(rr, out);
+    RR_UNLOCK(rr);
+    return rc;
+}
+
+/**
+ * @brief 覆盖模式下累计被挤掉的记录条数/字节数
+ * @param rr 记录环句柄
+ * @param records 记录条数（可为 NULL）
+ * @param bytes 字节数（可为 NULL）
+ */
+void RecordRing_GetEvicted(const RecordRing* rr, uint32_t* records, uint32_t* bytes) {
+    if (rr == NULL) return;
+    if (records) *records = rr->evicted_records;
+    if (bytes) *bytes = rr->evicted_bytes;
+}
+
+/**
+ * @brief 已提交记录占用的字节数（含头）
+ * @param rr 记录环句柄
+ * @return 字节数
+ */
+uint32_t RecordRing_GetUsedSize(const RecordRing* rr) {
+    if (rr == NULL) return 0;
+    return RingBuffer_GetUsedSize(&rr->rb);
+}
+
+#endif
@@ -0,0 +1,80 @@
+#ifndef RECORDRING_H
+#define RECORDRING_H
+#include <stdbool.h>
+
+#include "RingBuffer.h"
+#include "ret_code.h"
+#include "stdint.h"
+
+/* 每条记录的内联头：2 字节小端负载长度 */
+#define RR_HDR_SIZE   2u
+/* 单条记录最大负载长度 */
+#define RR_RECORD_MAX 0xFFFFu
+
+/*
+ * 记录环（长度帧环形缓冲区）
+ * - 底层为 SPSC 模式的 RingBuffer，每条记录 = [len_lo][len_hi][payload...]
+ * - 生产者可以分多次 Append 组装一条“挂起记录”，Commit 时写入头部并一次性发布；
+ *   Commit 之前消费者看不到这条记录，因此读侧总是整条、原子地读出/跳过
+ * - 只允许一个生产者和一个消费者（与 RB_FLAG_SPSC 相同的约束）
+ * - RB_FLAG_OVERWRITE：空间不足时按整条记录挤掉最旧记录，生产者永不阻塞；
+ *   此时底层改为临界区模式，每个操作在同一临界区内完成
+ */
+typedef struct {
+    RingBuffer rb;                     /* 底层字节环 */
+    uint32_t pending;                  /* 挂起记录已追加的负载字节数（仅生产者访问） */
+    bool isOverwrite;                  /* 覆盖最旧记录模式 */
+    volatile uint32_t evicted_records; /* 覆盖模式下累计被挤掉的记录条数 */
+    volatile uint32_t evicted_bytes;   /* 覆盖模式下累计被挤掉的字节数（含头） */
+} RecordRing;
+
+ret_code_t CreateRecordRing(RecordRing *rr, const char *name, uint32_t size);
+
+/* flags 仅支持 RB_FLAG_NONE / RB_FLAG_OVERWRITE */
+ret_code_t CreateRecordRingEx(RecordRing *rr, const char *name, uint32_t size, uint32_t flags);
+
+/* ================= 生产者 ================= */
+
+/* 向挂起记录追加负载；空间不足或超出 RR_RECORD_MAX 返回 RET_E_NO_MEM，挂起记录保持不变 */
+ret_code_t RecordRing_Append(RecordRing *rr, const uint8_t *data, uint32_t len);
+
+ret_code_t RecordRing_AppendFromISR(RecordRing *rr, const uint8_t *data, uint32_t len);
+
+/* 提交挂起记录（允许 0 长度） */
+ret_code_t RecordRing_Commit(RecordRing *rr);
+
+ret_code_t RecordRing_CommitFromISR(RecordRing *rr);
+
+/* 放弃挂起记录 */
+void RecordRing_Abort(RecordRing *rr);
+
+/* 一次写入整条记录（要求当前没有挂起记录，否则返回 RET_E_BUSY） */
+ret_code_t RecordRing_Write(RecordRing *rr, const uint8_t *data, uint32_t len);
+
+ret_code_t RecordRing_WriteFromISR(RecordRing *rr, const uint8_t *data, uint32_t len);
+
+/* ================= 消费者 ================= */
+
+/* 下一条记录的负载长度；为空返回 RET_E_DATA_NOT_ENOUGH */
+ret_code_t RecordRing_Peek(const RecordRing *rr, uint32_t *len);
+
+/*
+ * 读出并消费下一条记录
+ * len 返回记录的完整长度；若 cap 不足则只拷贝 cap 字节、整条消费并返回 RET_E_DATA_OVERFLOW
+ */
+ret_code_t RecordRing_Read(RecordRing *rr, uint8_t *buf, uint32_t cap, uint32_t *len);
+
+/* 跳过（消费）下一条记录 */
+ret_code_t RecordRing_Skip(RecordRing *rr);
+
+/* 零拷贝访问下一条记录的负载（跨越末尾时分 p1/p2 两段），用完后调用 RecordRing_Skip 释放
+ * 覆盖模式下窗口可能被生产者改写，只适合生产者停止后的事后读取 */
+ret_code_t RecordRing_ReadReserve(RecordRing *rr, RingBufferSpan *out);
+
+/* 覆盖模式下累计被挤掉的记录条数/字节数（任一指针可为 NULL） */
+void RecordRing_GetEvicted(const RecordRing *rr, uint32_t *records, uint32_t *bytes);
+
+/* 已提交记录占用的字节数（含头） */
+uint32_t RecordRing_GetUsedSize(const RecordRing *rr);
+
+#endif  // RECORDRING_H
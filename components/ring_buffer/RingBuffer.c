@@ -2,60 +2,422 @@
 /* 全局配置开启宏 */
 #if defined(ENABLE_RINGBUFFER_SYSTEM)
 #include <stdbool.h>
+#include <stdio.h>
 #include <string.h>
 
 #include "MemoryAllocation.h"
 #include "RingBuffer.h"
 #include "rb_port.h"
+#include "utils_def.h"
+
+/* 临界区封装：SPSC 模式下两侧各自只推进自己的索引，不需要关中断 */
+#define RB_LOCK(rb)                  \
+    do {                             \
+        if (!(rb)->isSpsc) {         \
+            RB_ENTER_CRITICAL();     \
+        }                            \
+    } while (0)
+
+#define RB_UNLOCK(rb)                \
+    do {                             \
+        if (!(rb)->isSpsc) {         \
+            RB_EXIT_CRITICAL();      \
+        }                            \
+    } while (0)
+
+#define RB_LOCK_FROM_ISR(rb, s)                \
+    do {                                       \
+        if (!(rb)->isSpsc) {                   \
+            RB_ENTER_CRITICAL_FROM_ISR(s);     \
+        }                                      \
+    } while (0)
+
+#define RB_UNLOCK_FROM_ISR(rb, s)              \
+    do {                                       \
+        if (!(rb)->isSpsc) {                   \
+            RB_EXIT_CRITICAL_FROM_ISR(s);      \
+        }                                      \
+    } while (0)
 
 static inline uint32_t RingBuffer_GetUsedSize_Internal(const RingBuffer* rb);
 
 static inline uint32_t RingBuffer_GetRemainSize_Internal(const RingBuffer* rb);
 
+static ret_code_t RingBuffer_WriteV_Internal(RingBuffer* rb, const RingBufferConstVec* vec,
+                                             uint32_t cnt, uint32_t total, uint32_t* written,
+                                             bool isForceWrite);
+
+#if defined(ENABLE_RINGBUFFER_STATS)
+/* 全局登记表（按创建顺序） */
+static RingBuffer* s_rb_list = NULL;
+
+/**
+ * @brief 记录一次成功写入（调用方负责临界区 / SPSC 生产者身份）
+ * @param rb 环形缓冲区句柄
+ * @param n 写入字节数
+ */
+static inline void RingBuffer_StatIn(RingBuffer* rb, const uint32_t n) {
+    rb->stats.bytes_in += n;
+    // 外部写入方覆盖未读数据时 used 会超过 size，按 size 计
+    const uint32_t used = MIN(RingBuffer_GetUsedSize_Internal(rb), rb->size);
+    if (used > rb->stats.peak) rb->stats.peak = used;
+}
+
+#define RB_STAT_IN(rb, n)    RingBuffer_StatIn((rb), (n))
+#define RB_STAT_OUT(rb, n)   ((rb)->stats.bytes_out += (n))
+#define RB_STAT_FAIL(rb)     ((rb)->stats.write_fail++)
+#define RB_STAT_TRUNC(rb, n) ((rb)->stats.truncated += (n))
+#else
+#define RB_STAT_IN(rb, n)    ((void)0)
+#define RB_STAT_OUT(rb, n)   ((void)0)
+#define RB_STAT_FAIL(rb)     ((void)0)
+#define RB_STAT_TRUNC(rb, n) ((void)0)
+#endif
+
+/**
+ * @brief 判断句柄是否可用
+ * @param rb 环形缓冲区句柄
+ * @return 可用返回 true
+ */
+static inline bool RingBuffer_IsValid(const RingBuffer* rb) {
+    return (rb != NULL && rb->buffer != NULL && rb->size >= 2);
+}
+
+/**
+ * @brief 计数器前移 n 字节（n <= size）
+ * @param rb 环形缓冲区句柄
+ * @param index 当前计数
+ * @param n 前移的字节数
+ * @return 新计数
+ */
+static inline uint32_t RingBuffer_Advance(const RingBuffer* rb, const uint32_t index,
+                                          const uint32_t n) {
+    // 2 的幂：自然回绕
+    if (rb->isPowerOfTwo_Size) return index + n;
+    // 镜像：[0, 2*size) 内回绕，一次减法即可
+    uint32_t next = index + n;
+    if (next >= (rb->size << 1)) next -= (rb->size << 1);
+    return next;
+}
+
+/**
+ * @brief 计数器对应的物理偏移
+ * @param rb 环形缓冲区句柄
+ * @param index 计数
+ * @return [0, size) 内的偏移
+ */
+static inline uint32_t RingBuffer_Offset(const RingBuffer* rb, const uint32_t index) {
+    if (rb->isPowerOfTwo_Size) return index & rb->mask;
+    return (index >= rb->size) ? (index - rb->size) : index;
+}
+
+/**
+ * @brief 从计数 index 对应的位置拷入 n 字节（处理回绕，n <= size）
+ * @param rb 环形缓冲区句柄
+ * @param index 起始计数
+ * @param src 数据源
+ * @param n 字节数
+ */
+static inline void RingBuffer_CopyIn(RingBuffer* rb, const uint32_t index, const uint8_t* src,
+                                     const uint32_t n) {
+    const uint32_t offset   = RingBuffer_Offset(rb, index);
+    const uint32_t end_size = rb->size - offset;
+    if (end_size >= n) {
+        memcpy(rb->buffer + offset, src, n);
+    } else {
+        // 分两段分别写入
+        memcpy(rb->buffer + offset, src, end_size);
+        memcpy(rb->buffer, src + end_size, n - end_size);
+    }
+}
+
+/**
+ * @brief 从计数 index 对应的位置拷出 n 字节（处理回绕，n <= size）
+ * @param rb 环形缓冲区句柄
+ * @param index 起始计数
+ * @param dst 接收地址
+ * @param n 字节数
+ */
+static inline void RingBuffer_CopyOut(const RingBuffer* rb, const uint32_t index, uint8_t* dst,
+                                      const uint32_t n) {
+    const uint32_t offset   = RingBuffer_Offset(rb, index);
+    const uint32_t end_size = rb->size - offset;
+    if (end_size >= n) {
+        memcpy(dst, rb->buffer + offset, n);
+    } else {
+        // 分两段分别读取写入
+        memcpy(dst, rb->buffer + offset, end_size);
+        memcpy(dst + end_size, rb->buffer, n - end_size);
+    }
+}
+
+/**
+ * @brief 将窗口清零
+ * @param out 输出窗口
+ * @param granted 实际大小
+ */
+static inline void RingBuffer_SpanClear(RingBufferSpan* out, uint32_t* granted) {
+    out->p1  = NULL;
+    out->n1  = 0;
+    out->p2  = NULL;
+    out->n2  = 0;
+    *granted = 0;
+}
+
+/**
+ * @brief 生产者发布数据后检查读等待者，已用达到阈值时唤醒（在临界区外调用）
+ * @param rb 句柄
+ * @param fromISR 是否中断上下文
+ */
+static inline void RingBuffer_NotifyReader(RingBuffer* rb, const bool fromISR) {
+#if RB_WAIT_SUPPORTED
+    if (rb->rd_waiter == NULL) return;
+    RB_FENCE();
+    const uint32_t need = rb->rd_need;
+    if (need == 0 || RingBuffer_GetUsedSize_Internal(rb) < need) return;
+    rb->rd_need = 0;
+    (void)(fromISR ? RB_SEM_GIVE_FROM_ISR(rb->rd_waiter) : RB_SEM_GIVE(rb->rd_waiter));
+#else
+    (void)rb;
+    (void)fromISR;
+#endif
+}
+
+/**
+ * @brief 消费者释放空间后检查写等待者，空闲达到阈值时唤醒（在临界区外调用）
+ * @param rb 句柄
+ * @param fromISR 是否中断上下文
+ */
+static inline void RingBuffer_NotifyWriter(RingBuffer* rb, const bool fromISR) {
+#if RB_WAIT_SUPPORTED
+    if (rb->wr_waiter == NULL) return;
+    RB_FENCE();
+    const uint32_t need = rb->wr_need;
+    if (need == 0 || RingBuffer_GetRemainSize_Internal(rb) < need) return;
+    rb->wr_need = 0;
+    (void)(fromISR ? RB_SEM_GIVE_FROM_ISR(rb->wr_waiter) : RB_SEM_GIVE(rb->wr_waiter));
+#else
+    (void)rb;
+    (void)fromISR;
+#endif
+}
+
 /**
  * @brief  创建一个指定大小的环形缓冲区
  * @param rb 环形缓冲区句柄
  * @param name 缓冲区的名称
- * @param size 要分配的缓冲区大小 （有效空间 size-1）
+ * @param size 要分配的缓冲区大小 （有效空间 size，建议 2 的幂）
  * @return 返回是否创建成功
  */
 ret_code_t CreateRingBuffer(RingBuffer* rb, const char* name, const uint32_t size) {
-    // 1、检擦输入参数的合法性
-    if (rb == NULL || size < 2) return RET_E_INVALID_ARG;
+    return CreateRingBufferEx(rb, name, size, RB_FLAG_NONE);
+}
 
-    // 2、动态分配内存
-    rb->buffer = static_alloc(size, DEFAULT_ALIGNMENT);
+/**
+ * @brief 校验创建参数
+ * @param rb 环形缓冲区句柄
+ * @param size 缓冲区大小
+ * @param flags RB_FLAG_xxx 组合
+ * @return 返回参数是否合法
+ */
+static ret_code_t RingBuffer_CheckCreateArgs(const RingBuffer* rb, const uint32_t size,
+                                             const uint32_t flags) {
+    // 非 2 的幂走镜像计数，需要 2*size 不溢出
+    if (rb == NULL || size < 2 || size > (UINT32_MAX >> 1)) return RET_E_INVALID_ARG;
+    // 覆盖模式下生产者要推进 front，与 SPSC 的单写者约束冲突
+    if ((flags & RB_FLAG_SPSC) && (flags & RB_FLAG_OVERWRITE)) return RET_E_INVALID_ARG;
+    // MPSC：索引按 2 的幂自然回绕，认领计数只有 24 位；生产者之间不能挤掉彼此的数据
+    if (flags & RB_FLAG_MPSC) {
+        if ((size & (size - 1)) != 0 || size > RB_MPSC_SIZE_MAX) return RET_E_INVALID_ARG;
+        if (flags & (RB_FLAG_SPSC | RB_FLAG_OVERWRITE)) return RET_E_INVALID_ARG;
+    }
+#if !RB_WAIT_SUPPORTED
+    if (flags & RB_FLAG_WAIT) return RET_E_UNSUPPORTED;
+#endif
+    return RET_OK;
+}
 
-    // 3、检查分配是否成功
-    if (rb->buffer == NULL) {
-        rb->front_index = rb->rear_index = 0;
-        rb->size                         = 0;
-        rb->isPowerOfTwo_Size            = false;
-        return RET_E_NO_MEM;
+#if defined(ENABLE_RINGBUFFER_STATS)
+/**
+ * @brief 挂入全局登记表（已登记则跳过，重复创建同一句柄不会成环）
+ * @param rb 环形缓冲区句柄
+ */
+static void RingBuffer_Register(RingBuffer* rb) {
+    RB_ENTER_CRITICAL();
+    RingBuffer** pp = &s_rb_list;
+    while (*pp != NULL && *pp != rb) pp = &(*pp)->next;
+    if (*pp == NULL) {
+        rb->next = NULL;
+        *pp      = rb;
     }
+    RB_EXIT_CRITICAL();
+}
 
-    // 4、分配成功
+/**
+ * @brief 从全局登记表摘除（未登记则什么也不做）
+ * @param rb 环形缓冲区句柄
+ */
+static void RingBuffer_Unregister(RingBuffer* rb) {
+    RB_ENTER_CRITICAL();
+    RingBuffer** pp = &s_rb_list;
+    while (*pp != NULL && *pp != rb) pp = &(*pp)->next;
+    if (*pp != NULL) *pp = rb->next;
+    RB_EXIT_CRITICAL();
+}
+#endif
+
+#if RB_WAIT_SUPPORTED
+/**
+ * @brief 释放句柄上的等待信号量（没有则什么也不做）
+ * @param rb 环形缓冲区句柄
+ */
+static void RingBuffer_ReleaseWaiters(RingBuffer* rb) {
+    if (rb->rd_waiter != NULL) (void)RB_SEM_DELETE(rb->rd_waiter);
+    if (rb->wr_waiter != NULL) (void)RB_SEM_DELETE(rb->wr_waiter);
+    rb->rd_waiter = NULL;
+    rb->wr_waiter = NULL;
+}
+
+/**
+ * @brief 准备一个等待信号量：已有则清掉残留的信号后沿用，没有则新建
+ * @param waiter 信号量句柄
+ * @param name 名称
+ * @return 是否成功（失败时 *waiter 为 NULL）
+ */
+static bool RingBuffer_PrepareWaiter(void** waiter, const char* name) {
+    if (*waiter != NULL) {
+        (void)RB_SEM_TAKE(*waiter, 0);
+        return true;
+    }
+    if (ret_is_ok(RB_SEM_CREATE(waiter, name))) return true;
+    *waiter = NULL;
+    return false;
+}
+#endif
+
+/**
+ * @brief 在已就绪的存储区上初始化句柄
+ * @param rb 环形缓冲区句柄
+ * @param name 缓冲区的名称
+ * @param buffer 存储区
+ * @param size 存储区大小
+ * @param flags RB_FLAG_xxx 组合
+ * @return 返回是否成功
+ */
+static ret_code_t RingBuffer_Setup(RingBuffer* rb, const char* name, uint8_t* buffer,
+                                   const uint32_t size, const uint32_t flags) {
     rb->name              = name;
+    rb->buffer            = buffer;
     rb->front_index       = 0;
     rb->rear_index        = 0;
     rb->size              = size;
     rb->isPowerOfTwo_Size = (rb->size != 0) && ((rb->size & (rb->size - 1)) == 0);
     // 简洁且安全地判断是否是2的幂; //判断缓冲区大小是不是2得幂 用于高效判断
+    rb->mask              = rb->isPowerOfTwo_Size ? (size - 1) : 0;
+    rb->isMpsc            = ((flags & RB_FLAG_MPSC) != 0u);
+    // MPSC 的消费者侧与 SPSC 相同，只推进 front，不需要临界区
+    rb->isSpsc            = ((flags & (RB_FLAG_SPSC | RB_FLAG_MPSC)) != 0u);
+    rb->mp_state          = 0;
+    rb->isOverwrite       = ((flags & RB_FLAG_OVERWRITE) != 0u);
+    rb->isExternal        = false;
+    rb->evicted           = 0;
+    rb->overruns          = 0;
+    rb->overruns_seen     = 0;
+    rb->rd_need           = 0;
+    rb->wr_need           = 0;
+
+#if defined(ENABLE_RINGBUFFER_STATS)
+    memset(&rb->stats, 0, sizeof(rb->stats));
+    RingBuffer_Register(rb);
+#endif
+
+#if RB_WAIT_SUPPORTED
+    // 阻塞读写需要的等待信号量；重复创建时沿用已有的，不需要时释放
+    if ((flags & RB_FLAG_WAIT) == 0u) {
+        RingBuffer_ReleaseWaiters(rb);
+        return RET_OK;
+    }
+    if (!RingBuffer_PrepareWaiter(&rb->rd_waiter, name) ||
+        !RingBuffer_PrepareWaiter(&rb->wr_waiter, name)) {
+        RingBuffer_ReleaseWaiters(rb);
+        return RET_E_NO_MEM;
+    }
+#else
+    rb->rd_waiter = NULL;
+    rb->wr_waiter = NULL;
+#endif
     return RET_OK;
 }
 
+/**
+ * @brief  创建一个指定大小的环形缓冲区（带模式标志）
+ * @param rb 环形缓冲区句柄
+ * @param name 缓冲区的名称
+ * @param size 要分配的缓冲区大小 （有效空间 size，建议 2 的幂）
+ * @param flags RB_FLAG_xxx 组合
+ * @return 返回是否创建成功
+ */
+ret_code_t CreateRingBufferEx(RingBuffer* rb, const char* name, const uint32_t size,
+                              const uint32_t flags) {
+    // 1、检擦输入参数的合法性
+    const ret_code_t rc = RingBuffer_CheckCreateArgs(rb, size, flags);
+    if (ret_is_err(rc)) return rc;
+
+    // 2、动态分配内存
+    uint8_t* buffer = static_alloc(size, DEFAULT_ALIGNMENT);
+
+    // 3、检查分配是否成功
+    if (buffer == NULL) {
+#if defined(ENABLE_RINGBUFFER_STATS)
+        // 句柄之前可能已登记，清零前先摘除，避免截断登记表
+        RingBuffer_Unregister(rb);
+#endif
+#if RB_WAIT_SUPPORTED
+        RingBuffer_ReleaseWaiters(rb);
+#endif
+        memset(rb, 0, sizeof(*rb));
+        return RET_E_NO_MEM;
+    }
+
+    // 4、分配成功
+    return RingBuffer_Setup(rb, name, buffer, size, flags);
+}
+
+/**
+ * @brief  在调用方提供的存储区上创建环形缓冲区（不分配内存）
+ * @param rb 环形缓冲区句柄
+ * @param name 缓冲区的名称
+ * @param buffer 存储区（生命周期需覆盖 rb，例如静态数组或 DMA 循环缓冲）
+ * @param size 存储区大小
+ * @param flags RB_FLAG_xxx 组合
+ * @return 返回是否创建成功
+ * @note  存储区作为外设（DMA）循环缓冲时，由 RingBuffer_PublishWritePos 发布写位置，
+ *        不要再调用 Write/WriteV/WriteReserve
+ */
+ret_code_t CreateRingBufferStatic(RingBuffer* rb, const char* name, uint8_t* buffer,
+                                  const uint32_t size, const uint32_t flags) {
+    const ret_code_t rc = RingBuffer_CheckCreateArgs(rb, size, flags);
+    if (ret_is_err(rc)) return rc;
+    if (buffer == NULL) return RET_E_INVALID_ARG;
+
+    const ret_code_t setup = RingBuffer_Setup(rb, name, buffer, size, flags);
+    // MPSC 的写位置只由生产者 CAS 发布，不接受外部写入方
+    rb->isExternal         = !rb->isMpsc;
+    return setup;
+}
+
 /**
  * @brief  获取环形缓冲区中已存储的数据量
  * @param  rb 指向 RingBuffer 结构体的指针
  * @return 返回已存储的数据量 (字节数)。如果 rb 为 NULL，返回 0。
  */
 uint32_t RingBuffer_GetUsedSize(const RingBuffer* rb) {
-    if (rb == NULL || rb->size < 2 || rb->buffer == NULL) return 0;
+    if (!RingBuffer_IsValid(rb)) return 0;
     // 进入临界区
-    RB_ENTER_CRITICAL();
+    RB_LOCK(rb);
     const uint32_t used_size = RingBuffer_GetUsedSize_Internal(rb);
     // 退出临界区
-    RB_EXIT_CRITICAL();
+    RB_UNLOCK(rb);
     return used_size;
 }
 
@@ -65,13 +427,13 @@ uint32_t RingBuffer_GetUsedSize(const RingBuffer* rb) {
  * @return 返回已存储的数据量 (字节数)。如果 rb 为 NULL，返回 0。
  */
 uint32_t RingBuffer_GetUsedSizeFromISR(const RingBuffer* rb) {
+    if (!RingBuffer_IsValid(rb)) return 0;
     // 进入临界区
-    if (rb == NULL || rb->size < 2 || rb->buffer == NULL) return 0;
-    rb_isr_state_t saved;
-    RB_ENTER_CRITICAL_FROM_ISR(saved);
+    rb_isr_state_t saved = 0;
+    RB_LOCK_FROM_ISR(rb, saved);
     const uint32_t used_size = RingBuffer_GetUsedSize_Internal(rb);
     // 退出临界区
-    RB_EXIT_CRITICAL_FROM_ISR(saved);
+    RB_UNLOCK_FROM_ISR(rb, saved);
 
     return used_size;
 }
@@ -80,23 +442,26 @@ uint32_t RingBuffer_GetUsedSizeFromISR(const RingBuffer* rb) {
  * @brief  获取环形缓冲区中已存储的数据量
  * @param  rb 指向 RingBuffer 结构体的指针
  * @return 返回已存储的数据量 (字节数)。如果 rb 为 NULL，返回 0。
+ * @note   SPSC 模式下 rear/front 各读一次快照（acquire），结果对调用方而言是保守值；
+ *         先读 front 再读 rear，保证第三方观察者不会看到 front 越过 rear
  */
 static inline uint32_t RingBuffer_GetUsedSize_Internal(const RingBuffer* rb) {
     if (rb == NULL || rb->size < 2) return 0;
 
-    const uint32_t rear  = rb->rear_index;
+    const uint32_t front = RB_LOAD_ACQUIRE(&rb->front_index);
 
-    const uint32_t front = rb->front_index;
+    const uint32_t rear  = RB_LOAD_ACQUIRE(&rb->rear_index);
 
-    const uint32_t size  = rb->size;
     uint32_t used_size;
     if (rb->isPowerOfTwo_Size) {
-        used_size = (rear - front + size) & (size - 1);
+        // 2 的幂：无符号差值天然处理回绕
+        used_size = rear - front;
     } else {
-        used_size = (rear - front + size) % size;
+        // 镜像计数：rear 已回绕而 front 尚未回绕时补 2*size
+        used_size = (rear >= front) ? (rear - front) : (rear + (rb->size << 1) - front);
     }
-
-    return used_size;
+    // 两次快照之间对端可能又推进了，最多按满处理
+    return (used_size > rb->size) ? rb->size : used_size;
 }
 
 /**
@@ -105,12 +470,12 @@ static inline uint32_t RingBuffer_GetUsedSize_Internal(const RingBuffer* rb) {
  * @return 返回可使用的数据量 (字节数)。如果 rb 为 NULL，返回 0。
  */
 uint32_t RingBuffer_GetRemainSize(const RingBuffer* rb) {
-    if (rb == NULL || rb->size < 2 || rb->buffer == NULL) return 0;
+    if (!RingBuffer_IsValid(rb)) return 0;
     // 进入临界区
-    RB_ENTER_CRITICAL();
+    RB_LOCK(rb);
     const uint32_t size = RingBuffer_GetRemainSize_Internal(rb);
     // 退出临界区
-    RB_EXIT_CRITICAL();
+    RB_UNLOCK(rb);
     // 未可使用空间
     return size;
 }
@@ -121,13 +486,13 @@ uint32_t RingBuffer_GetRemainSize(const RingBuffer* rb) {
  * @return 返回可使用的数据量 (字节数)。如果 rb 为 NULL，返回 0。
  */
 uint32_t RingBuffer_GetRemainSizeFromISR(const RingBuffer* rb) {
-    if (rb == NULL || rb->size < 2 || rb->buffer == NULL) return 0;
+    if (!RingBuffer_IsValid(rb)) return 0;
     // 进入临界区
-    rb_isr_state_t saved;
-    RB_ENTER_CRITICAL_FROM_ISR(saved);
+    rb_isr_state_t saved = 0;
+    RB_LOCK_FROM_ISR(rb, saved);
     const uint32_t size = RingBuffer_GetRemainSize_Internal(rb);
     // 退出临界区
-    RB_EXIT_CRITICAL_FROM_ISR(saved);
+    RB_UNLOCK_FROM_ISR(rb, saved);
     // 未可使用空间
     return size;
 }
@@ -139,120 +504,145 @@ uint32_t RingBuffer_GetRemainSizeFromISR(const RingBuffer* rb) {
  */
 static inline uint32_t RingBuffer_GetRemainSize_Internal(const RingBuffer* rb) {
     if (rb == NULL || rb->size < 2) return 0;
-    return rb->size - RingBuffer_GetUsedSize_Internal(rb) - 1;
+    return rb->size - RingBuffer_GetUsedSize_Internal(rb);
 }
 
 /**
- * @brief  添加数据到环形缓冲区
+ * @brief 覆盖模式：挤掉最旧数据，保证至少有 need 字节空闲（调用方负责临界区）
+ * @param rb 环形缓冲区指针
+ * @param need 需要的空闲字节数（<= size）
+ */
+static inline void RingBuffer_Evict_Internal(RingBuffer* rb, const uint32_t need) {
+    const uint32_t remain = RingBuffer_GetRemainSize_Internal(rb);
+    if (need <= remain) return;
+
+    const uint32_t drop = need - remain;
+    rb->front_index     = RingBuffer_Advance(rb, rb->front_index, drop);
+    rb->evicted += drop;
+}
+
+/**
+ * @brief 写入数据（调用方负责临界区 / SPSC 生产者身份）
  * @param rb 环形缓冲区指针
  * @param add 数据源地址
  * @param size 添加的数据大小（字节）
  * @param isForceWrite 是否强制写入可写入得长度数据剩余丢弃
  * @return 返回是否成功
  */
-ret_code_t WriteRingBuffer(RingBuffer* rb, const uint8_t* add, uint32_t* size,
-                           const uint8_t isForceWrite) {
-    // 1、参数合法性检查
-    if (rb == NULL || add == NULL || size == NULL || *size == 0 || rb->buffer == NULL ||
-        rb->size < 2)
-        return RET_E_INVALID_ARG;
-    // --- 进入临界区，保护所有对 rb 成员的访问 ---
-    RB_ENTER_CRITICAL();
-    // 2、检查当前缓冲区的大小是否能够装入
+static ret_code_t RingBuffer_Write_Internal(RingBuffer* rb, const uint8_t* add, uint32_t* size,
+                                            const uint8_t isForceWrite) {
+    // 覆盖模式（含超长截头与挤掉最旧数据）与 MPSC 统一走分散写入路径
+    if (rb->isOverwrite || rb->isMpsc) {
+        const RingBufferConstVec v = {.ptr = add, .len = *size};
+        return RingBuffer_WriteV_Internal(rb, &v, 1, *size, size,
+                                          rb->isOverwrite || isForceWrite);
+    }
+
+    // 1、检查当前缓冲区的大小是否能够装入
     const uint32_t remain_size = RingBuffer_GetRemainSize_Internal(rb);
     if (remain_size < *size) {
         if (isForceWrite) {
+            RB_STAT_TRUNC(rb, *size - remain_size);
             *size = remain_size;
         } else {
-            // --- 在返回前，退出临界区 ---
-            RB_EXIT_CRITICAL();
+            RB_STAT_FAIL(rb);
             return RET_E_NO_MEM;
         }
     }
 
-    // 如果窥视大小为0（可能在isForcePeek后发生），则直接成功返回
-    if (*size == 0) {
-        RB_EXIT_CRITICAL();
-        return RET_OK;
-    }
+    // 如果写入大小为0（可能在isForceWrite后发生），则直接成功返回
+    if (*size == 0) return RET_OK;
 
-    // 3、写入缓冲区
+    // 2、写入缓冲区
     // 判断当前的空间是否足够一次性写入
-    const uint32_t end_size = rb->size - rb->rear_index;
-    if (end_size >= *size) {
-        memcpy(rb->buffer + rb->rear_index, add, *size);
-    } else {
-        // 分两段分别写入
-        memcpy(rb->buffer + rb->rear_index, add, end_size);
-        memcpy(rb->buffer, add + end_size, *size - end_size);
-    }
-    // 幂运算优化取余运算
-    if (rb->isPowerOfTwo_Size) {
-        rb->rear_index = (rb->rear_index + *size) & (rb->size - 1);
-    } else {
-        rb->rear_index = (rb->rear_index + *size) % rb->size;
-    }
-
-    // --- 在返回前，退出临界区 ---
-    RB_EXIT_CRITICAL();
+    const uint32_t rear = rb->rear_index;
+    RingBuffer_CopyIn(rb, rear, add, *size);
+    // 3、数据写完后再发布 rear（release）
+    RB_STORE_RELEASE(&rb->rear_index, RingBuffer_Advance(rb, rear, *size));
+    RB_STAT_IN(rb, *size);
     return RET_OK;
 }
 
 /**
- *
+ * @brief 读取/窥视数据（调用方负责临界区 / SPSC 消费者身份）
  * @param rb 环形缓冲区指针
  * @param add 接收数据的地址
- * @param size 要获取的数据大小（字节
- * @param isForceRead 是否在数据不足 @param size 大小时候强制读取已有的全部数据
+ * @param size 要获取的数据大小（字节）
+ * @param isForce 数据不足时是否读取已有的全部数据
+ * @param consume true: 读取后推进 front；false: 仅窥视
  * @return 返回是否读取成功
  */
-ret_code_t ReadRingBuffer(RingBuffer* rb, uint8_t* add, uint32_t* size, const uint8_t isForceRead) {
-    // 1、参数合法性检查
-    if (rb == NULL || add == NULL || size == NULL || *size == 0 || rb->buffer == NULL ||
-        rb->size < 2)
-        return RET_E_INVALID_ARG;
-    // --- 进入临界区，保护所有对 rb 成员的访问 ---
-    RB_ENTER_CRITICAL();
+static ret_code_t RingBuffer_Read_Internal(RingBuffer* rb, uint8_t* add, uint32_t* size,
+                                           const uint8_t isForce, const bool consume) {
     const uint32_t usedSize = RingBuffer_GetUsedSize_Internal(rb);
-    // 2、检查当前缓冲区的大小是否能够装入
+    // 1、检查当前缓冲区的数据是否足够
     if (usedSize < *size) {
         // 强制读取剩余的
-        if (isForceRead) {
+        if (isForce) {
             *size = usedSize;
         } else {
-            // --- 在返回前，退出临界区 ---
-            RB_EXIT_CRITICAL();
             // 不强制读取当前数据不足就不读取
             return RET_E_DATA_NOT_ENOUGH;
         }
     }
 
-    // 如果窥视大小为0（可能在isForcePeek后发生），则直接成功返回
-    if (*size == 0) {
-        RB_EXIT_CRITICAL();
-        return RET_OK;
-    }
+    // 如果读取大小为0（可能在isForce后发生），则直接成功返回
+    if (*size == 0) return RET_OK;
 
-    // 3、写入缓冲区
+    // 2、从缓冲区复制数据
     // 判断当前的空间是否足够一次性读取
-    const uint32_t end_size = rb->size - rb->front_index;
-    if (end_size >= *size) {
-        memcpy(add, rb->buffer + rb->front_index, *size);
-    } else {
-        // 分两段分别读取写入
-        memcpy(add, rb->buffer + rb->front_index, end_size);
-        memcpy(add + end_size, rb->buffer, *size - end_size);
-    }
-    // 幂运算优化取余运算
-    if (rb->isPowerOfTwo_Size) {
-        rb->front_index = (rb->front_index + *size) & (rb->size - 1);
-    } else {
-        rb->front_index = (rb->front_index + *size) % rb->size;
+    const uint32_t front = rb->front_index;
+    RingBuffer_CopyOut(rb, front, add, *size);
+
+    // 3、数据读完后再发布 front（release），生产者此后才能复用这段空间
+    if (consume) {
+        RB_STORE_RELEASE(&rb->front_index, RingBuffer_Advance(rb, front, *size));
+        RB_STAT_OUT(rb, *size);
     }
+    return RET_OK;
+}
+
+/**
+ * @brief  添加数据到环形缓冲区
+ * @param rb 环形缓冲区指针
+ * @param add 数据源地址
+ * @param size 添加的数据大小（字节）
+ * @param isForceWrite 是否强制写入可写入得长度数据剩余丢弃
+ * @return 返回是否成功
+ */
+ret_code_t WriteRingBuffer(RingBuffer* rb, const uint8_t* add, uint32_t* size,
+                           const uint8_t isForceWrite) {
+    // 1、参数合法性检查
+    if (!RingBuffer_IsValid(rb) || add == NULL || size == NULL || *size == 0)
+        return RET_E_INVALID_ARG;
+    // --- 进入临界区，保护所有对 rb 成员的访问 ---
+    RB_LOCK(rb);
+    const ret_code_t rc = RingBuffer_Write_Internal(rb, add, size, isForceWrite);
+    // --- 在返回前，退出临界区 ---
+    RB_UNLOCK(rb);
+    if (ret_is_ok(rc)) RingBuffer_NotifyReader(rb, false);
+    return rc;
+}
 
+/**
+ *
+ * @param rb 环形缓冲区指针
+ * @param add 接收数据的地址
+ * @param size 要获取的数据大小（字节
+ * @param isForceRead 是否在数据不足 @param size 大小时候强制读取已有的全部数据
+ * @return 返回是否读取成功
+ */
+ret_code_t ReadRingBuffer(RingBuffer* rb, uint8_t* add, uint32_t* size, const uint8_t isForceRead) {
+    // 1、参数合法性检查
+    if (!RingBuffer_IsValid(rb) || add == NULL || size == NULL || *size == 0)
+        return RET_E_INVALID_ARG;
+    // --- 进入临界区，保护所有对 rb 成员的访问 ---
+    RB_LOCK(rb);
+    const ret_code_t rc = RingBuffer_Read_Internal(rb, add, size, isForceRead, true);
     // --- 在返回前，退出临界区 ---
-    RB_EXIT_CRITICAL();
-    return RET_OK;
+    RB_UNLOCK(rb);
+    if (ret_is_ok(rc)) RingBuffer_NotifyWriter(rb, false);
+    return rc;
 }
 
 /**
@@ -266,48 +656,16 @@ ret_code_t ReadRingBuffer(RingBuffer* rb, uint8_t* add, uint32_t* size, const ui
 ret_code_t PeekRingBuffer(const RingBuffer* rb, uint8_t* add, uint32_t* size,
                           const uint8_t isForcePeek) {
     // 1、参数合法性检查
-    if (rb == NULL || add == NULL || size == NULL || *size == 0 || rb->buffer == NULL ||
-        rb->size < 2)
+    if (!RingBuffer_IsValid(rb) || add == NULL || size == NULL || *size == 0)
         return RET_E_INVALID_ARG;
 
     // --- 进入临界区，保护所有对 rb 成员的访问 ---
-    RB_ENTER_CRITICAL();  // 注意：如果是在任务中调用，应使用 taskENTER_CRITICAL()
-
-    const uint32_t usedSize = RingBuffer_GetUsedSize_Internal(rb);
-
-    // 2、检查当前缓冲区中是否有足够的数据
-    if (usedSize < *size) {
-        // 强制窥视剩余的
-        if (isForcePeek) {
-            *size = usedSize;
-        } else {
-            // --- 在返回前，退出临界区 ---
-            RB_EXIT_CRITICAL();
-            // 不强制窥视，且数据不足，则操作失败
-            return RET_E_DATA_NOT_ENOUGH;
-        }
-    }
-
-    // 如果窥视大小为0（可能在isForcePeek后发生），则直接成功返回
-    if (*size == 0) {
-        RB_EXIT_CRITICAL();
-        return RET_OK;
-    }
-
-    // 3、从缓冲区复制数据
-    // 判断当前的空间是否足够一次性复制
-    const uint32_t end_size = rb->size - rb->front_index;
-    if (end_size >= *size) {
-        memcpy(add, rb->buffer + rb->front_index, *size);
-    } else {
-        // 分两段分别复制
-        memcpy(add, rb->buffer + rb->front_index, end_size);
-        memcpy(add + end_size, rb->buffer, *size - end_size);
-    }
-
+    RB_LOCK(rb);
+    /* consume=false 时不会写 rb */
+    const ret_code_t rc = RingBuffer_Read_Internal((RingBuffer*)rb, add, size, isForcePeek, false);
     // --- 在返回前，退出临界区 ---
-    RB_EXIT_CRITICAL();
-    return RET_OK;
+    RB_UNLOCK(rb);
+    return rc;
 }
 
 /**
@@ -321,50 +679,16 @@ ret_code_t PeekRingBuffer(const RingBuffer* rb, uint8_t* add, uint32_t* size,
 ret_code_t WriteRingBufferFromISR(RingBuffer* rb, const uint8_t* add, uint32_t* size,
                                   const uint8_t isForceWrite) {
     // 1、参数合法性检查
-    if (rb == NULL || add == NULL || size == NULL || *size == 0 || rb->buffer == NULL ||
-        rb->size < 2)
+    if (!RingBuffer_IsValid(rb) || add == NULL || size == NULL || *size == 0)
         return RET_E_INVALID_ARG;
     // --- 进入临界区，保护所有对 rb 成员的访问 ---
-    rb_isr_state_t saved;
-    RB_ENTER_CRITICAL_FROM_ISR(saved);
-    // 2、检查当前缓冲区的大小是否能够装入
-    const uint32_t remain_size = RingBuffer_GetRemainSize_Internal(rb);
-    if (remain_size < *size) {
-        if (isForceWrite) {
-            *size = remain_size;
-        } else {
-            // --- 在返回前，退出临界区 ---
-            RB_EXIT_CRITICAL_FROM_ISR(saved);
-            return RET_E_NO_MEM;
-        }
-    }
-
-    // 如果窥视大小为0（可能在isForcePeek后发生），则直接成功返回
-    if (*size == 0) {
-        RB_EXIT_CRITICAL_FROM_ISR(saved);
-        return RET_OK;
-    }
-
-    // 3、写入缓冲区
-    // 判断当前的空间是否足够一次性写入
-    const uint32_t end_size = rb->size - rb->rear_index;
-    if (end_size >= *size) {
-        memcpy(rb->buffer + rb->rear_index, add, *size);
-    } else {
-        // 分两段分别写入
-        memcpy(rb->buffer + rb->rear_index, add, end_size);
-        memcpy(rb->buffer, add + end_size, *size - end_size);
-    }
-    // 幂运算优化取余运算
-    if (rb->isPowerOfTwo_Size) {
-        rb->rear_index = (rb->rear_index + *size) & (rb->size - 1);
-    } else {
-        rb->rear_index = (rb->rear_index + *size) % rb->size;
-    }
-
+    rb_isr_state_t saved = 0;
+    RB_LOCK_FROM_ISR(rb, saved);
+    const ret_code_t rc = RingBuffer_Write_Internal(rb, add, size, isForceWrite);
     // --- 在返回前，退出临界区 ---
-    RB_EXIT_CRITICAL_FROM_ISR(saved);
-    return RET_OK;
+    RB_UNLOCK_FROM_ISR(rb, saved);
+    if (ret_is_ok(rc)) RingBuffer_NotifyReader(rb, true);
+    return rc;
 }
 
 /**
@@ -379,52 +703,31 @@ ret_code_t WriteRingBufferFromISR(RingBuffer* rb, const uint8_t* add, uint32_t*
 ret_code_t ReadRingBufferFromISR(RingBuffer* rb, uint8_t* add, uint32_t* size,
                                  const uint8_t isForceRead) {
     // 1、参数合法性检查
-    if (rb == NULL || add == NULL || size == NULL || *size == 0 || rb->buffer == NULL ||
-        rb->size < 2)
+    if (!RingBuffer_IsValid(rb) || add == NULL || size == NULL || *size == 0)
         return RET_E_INVALID_ARG;
     // --- 进入临界区，保护所有对 rb 成员的访问 ---
-    rb_isr_state_t saved;
-    RB_ENTER_CRITICAL_FROM_ISR(saved);
-    const uint32_t usedSize = RingBuffer_GetUsedSize_Internal(rb);
-    // 2、检查当前缓冲区的大小是否能够装入
-    if (usedSize < *size) {
-        // 强制读取剩余的
-        if (isForceRead) {
-            *size = usedSize;
-        } else {
-            // --- 在返回前，退出临界区 ---
-            RB_EXIT_CRITICAL_FROM_ISR(saved);
-            // 不强制读取当前数据不足就不读取
-            return RET_E_DATA_NOT_ENOUGH;
-        }
-    }
-
-    // 如果窥视大小为0（可能在isForcePeek后发生），则直接成功返回
-    if (*size == 0) {
-        RB_EXIT_CRITICAL_FROM_ISR(saved);
-        return RET_OK;
-    }
+    rb_isr_state_t saved = 0;
+    RB_LOCK_FROM_ISR(rb, saved);
+    const ret_code_t rc = RingBuffer_Read_Internal(rb, add, size, isForceRead, true);
+    // --- 在返回前，退出临界区 ---
+    RB_UNLOCK_FROM_ISR(rb, saved);
+    if (ret_is_ok(rc)) RingBuffer_NotifyWriter(rb, true);
+    return rc;
+}
 
-    // 3、写入缓冲区
-    // 判断当前的空间是否足够一次性读取
-    const uint32_t end_size = rb->size - rb->front_index;
-    if (end_size >= *size) {
-        memcpy(add, rb->buffer + rb->front_index, *size);
-    } else {
-        // 分两段分别读取写入
-        memcpy(add, rb->buffer + rb->front_index, end_size);
-        memcpy(add + end_size, rb->buffer, *size - end_size);
-    }
-    // 幂运算优化取余运算
-    if (rb->isPowerOfTwo_Size) {
-        rb->front_index = (rb->front_index + *size) & (rb->size - 1);
-    } else {
-        rb->front_index = (rb->front_index + *size) % rb->size;
+/**
+ * @brief 重置缓冲区（调用方负责临界区）
+ * @param rb 句柄
+ * @note  SPSC 模式下生产者可能正在并发写入，只能由消费者把 front 追到 rear（清空已有数据）；
+ *        外部存储（DMA）的物理写位置不能归零，同样只追平 front
+ */
+static inline void RingBuffer_Reset_Internal(RingBuffer* rb) {
+    if (rb->isSpsc || rb->isExternal) {
+        RB_STORE_RELEASE(&rb->front_index, RB_LOAD_ACQUIRE(&rb->rear_index));
+        return;
     }
-
-    // --- 在返回前，退出临界区 ---
-    RB_EXIT_CRITICAL_FROM_ISR(saved);
-    return RET_OK;
+    rb->front_index = 0;
+    rb->rear_index  = 0;
 }
 
 /**
@@ -434,10 +737,10 @@ ret_code_t ReadRingBufferFromISR(RingBuffer* rb, uint8_t* add, uint32_t* size,
  */
 ret_code_t ResetRingBuffer(RingBuffer* rb) {
     if (rb == NULL) return RET_E_INVALID_ARG;
-    RB_ENTER_CRITICAL();
-    rb->front_index = 0;
-    rb->rear_index  = 0;
-    RB_EXIT_CRITICAL();
+    RB_LOCK(rb);
+    RingBuffer_Reset_Internal(rb);
+    RB_UNLOCK(rb);
+    RingBuffer_NotifyWriter(rb, false);
     return RET_OK;
 }
 
@@ -450,16 +753,16 @@ ret_code_t ResetRingBufferFromISR(RingBuffer* rb) {
     if (rb == NULL) {
         return RET_E_INVALID_ARG;
     }
-    rb_isr_state_t saved;
-    RB_ENTER_CRITICAL_FROM_ISR(saved);
-    rb->front_index = 0;
-    rb->rear_index  = 0;
-    RB_EXIT_CRITICAL_FROM_ISR(saved);
+    rb_isr_state_t saved = 0;
+    RB_LOCK_FROM_ISR(rb, saved);
+    RingBuffer_Reset_Internal(rb);
+    RB_UNLOCK_FROM_ISR(rb, saved);
+    RingBuffer_NotifyWriter(rb, true);
     return RET_OK;
 }
 
 /**
- *
+ * @brief 申请写窗口（调用方负责临界区 / SPSC 生产者身份）
  * @param rb 缓冲区句柄
  * @param want 想要获取的大小
  * @param out  实际输出的窗口
@@ -467,94 +770,58 @@ ret_code_t ResetRingBufferFromISR(RingBuffer* rb) {
  * @param isCompatible  是否部分存入
  * @return 是否成功
  */
-ret_code_t RingBuffer_WriteReserve(RingBuffer* rb, uint32_t want, RingBufferSpan* out,
-                                   uint32_t* granted, bool isCompatible) {
-    if (!rb || !out || !granted || !rb->buffer || rb->size < 2) return RET_E_INVALID_ARG;
-
-    RB_ENTER_CRITICAL();
-
+static ret_code_t RingBuffer_WriteReserve_Internal(RingBuffer* rb, const uint32_t want,
+                                                   RingBufferSpan* out, uint32_t* granted,
+                                                   const bool isCompatible) {
+    // MPSC 的认领与提交是一次写入内部的事，不能把窗口交给调用方长期持有
+    if (rb->isMpsc) return RET_E_UNSUPPORTED;
     /* 1、获取剩余空间大小 */
-    const uint32_t remain = RingBuffer_GetRemainSize_Internal(rb);
-
-    uint32_t g            = want;
-
-    if (g == 0) {
-        out->p1  = NULL;
-        out->n1  = 0;
-        out->p2  = NULL;
-        out->n2  = 0;
-        *granted = 0;
-        RB_EXIT_CRITICAL();
+    if (want == 0) {
+        RingBuffer_SpanClear(out, granted);
         return RET_OK;
     }
 
+    uint32_t g = want;
+    // 覆盖模式：先挤掉最旧数据腾出空间（want 超过 size 时仍按普通规则处理）
+    if (rb->isOverwrite) RingBuffer_Evict_Internal(rb, MIN(g, rb->size));
+
+    const uint32_t remain = RingBuffer_GetRemainSize_Internal(rb);
     if (g > remain) {
-        if (isCompatible)
+        if (isCompatible) {
             g = remain;
-        else {
-            RB_EXIT_CRITICAL();
+        } else {
+            RB_STAT_FAIL(rb);
             return RET_E_NO_MEM;
         }
     }
 
-    const uint32_t rear  = rb->rear_index;
-    const uint32_t front = rb->front_index;
-    const uint32_t size  = rb->size;
-
-    uint32_t n1 = 0, n2 = 0;
-
-    if (rear < front) {
-        // 可写连续段：rear .. front-1 之间（预留 1 字节区分满/空）
-        const uint32_t seg = front - rear - 1;
-        n1                 = (g < seg) ? g : seg;
-        n2                 = 0;
-
-        out->p1            = (n1 > 0) ? (rb->buffer + rear) : NULL;
-        out->n1            = n1;
-        out->p2            = NULL;
-        out->n2            = 0;
-        *granted           = n1 + n2;  // 注意：这里最多只能给 n1（因为不允许跨 front）
-        RB_EXIT_CRITICAL();
-        return RET_OK;
-    } else {
-        // 空洞跨越末尾：先尾段再头段
-        const uint32_t tailFree = (front == 0) ? (size - rear - 1) : (size - rear);
-        n1                      = (g < tailFree) ? g : tailFree;
-        n2                      = g - n1;
-
-        out->p1                 = (n1 > 0) ? (rb->buffer + rear) : NULL;
-        out->n1                 = n1;
-        out->p2                 = (n2 > 0) ? (rb->buffer) : NULL;
-        out->n2                 = n2;
-        *granted                = n1 + n2;
-
-        RB_EXIT_CRITICAL();
-        return RET_OK;
-    }
+    /* g <= remain，因此从 rear 起的 g 字节一定空闲：先写到末尾，再从头写 */
+    const uint32_t offset   = RingBuffer_Offset(rb, rb->rear_index);
+    const uint32_t tailFree = rb->size - offset;
+    const uint32_t n1       = (g < tailFree) ? g : tailFree;
+    const uint32_t n2       = g - n1;
+
+    out->p1  = (n1 > 0) ? (rb->buffer + offset) : NULL;
+    out->n1  = n1;
+    out->p2  = (n2 > 0) ? (rb->buffer) : NULL;
+    out->n2  = n2;
+    *granted = n1 + n2;
+    return RET_OK;
 }
 
 /**
- *
+ * @brief 提交写窗口（调用方负责临界区 / SPSC 生产者身份）
  * @param rb 操作句柄
- * @param commit 实际写入的次数
+ * @param commit 实际写入的字节数
  * @return 成功或者失败
  */
-ret_code_t RingBuffer_WriteCommit(RingBuffer* rb, uint32_t commit) {
-    if (!rb || !rb->buffer || rb->size < 2) return RET_E_INVALID_ARG;
-
-    RB_ENTER_CRITICAL();
+static ret_code_t RingBuffer_WriteCommit_Internal(RingBuffer* rb, const uint32_t commit) {
+    if (rb->isMpsc) return RET_E_UNSUPPORTED;
     const uint32_t remain = RingBuffer_GetRemainSize_Internal(rb);
-    if (commit > remain) {
-        RB_EXIT_CRITICAL();
-        return RET_E_NO_MEM;
-    }
-
-    if (rb->isPowerOfTwo_Size)
-        rb->rear_index = (rb->rear_index + commit) & (rb->size - 1);
-    else
-        rb->rear_index = (rb->rear_index + commit) % rb->size;
+    if (commit > remain) return RET_E_NO_MEM;
 
-    RB_EXIT_CRITICAL();
+    RB_STORE_RELEASE(&rb->rear_index, RingBuffer_Advance(rb, rb->rear_index, commit));
+    RB_STAT_IN(rb, commit);
     return RET_OK;
 }
 
@@ -566,73 +833,52 @@ ret_code_t RingBuffer_WriteCommit(RingBuffer* rb, uint32_t commit) {
  * @param granted 实际大小
  * @param isCompatible  是否部分存入
  * @return 是否成功
- * @note DMA使用只能使用p1得长度禁止一次性使用 p1 + p2
  */
-ret_code_t RingBuffer_WriteReserveFromISR(RingBuffer* rb, uint32_t want, RingBufferSpan* out,
-                                          uint32_t* granted, bool isCompatible) {
-    if (!rb || !out || !granted || !rb->buffer || rb->size < 2) return RET_E_INVALID_ARG;
-
-    rb_isr_state_t saved;
-    RB_ENTER_CRITICAL_FROM_ISR(saved);
+ret_code_t RingBuffer_WriteReserve(RingBuffer* rb, uint32_t want, RingBufferSpan* out,
+                                   uint32_t* granted, bool isCompatible) {
+    if (!RingBuffer_IsValid(rb) || !out || !granted) return RET_E_INVALID_ARG;
 
-    /* 1、获取剩余空间大小 */
-    const uint32_t remain = RingBuffer_GetRemainSize_Internal(rb);
+    RB_LOCK(rb);
+    const ret_code_t rc = RingBuffer_WriteReserve_Internal(rb, want, out, granted, isCompatible);
+    RB_UNLOCK(rb);
+    return rc;
+}
 
-    uint32_t g            = want;
+/**
+ *
+ * @param rb 操作句柄
+ * @param commit 实际写入的次数
+ * @return 成功或者失败
+ */
+ret_code_t RingBuffer_WriteCommit(RingBuffer* rb, uint32_t commit) {
+    if (!RingBuffer_IsValid(rb)) return RET_E_INVALID_ARG;
 
-    if (g == 0) {
-        out->p1  = NULL;
-        out->n1  = 0;
-        out->p2  = NULL;
-        out->n2  = 0;
-        *granted = 0;
-        RB_EXIT_CRITICAL_FROM_ISR(saved);
-        return RET_OK;  // 或 return false; 取决于你接口约定
-    }
+    RB_LOCK(rb);
+    const ret_code_t rc = RingBuffer_WriteCommit_Internal(rb, commit);
+    RB_UNLOCK(rb);
+    if (ret_is_ok(rc)) RingBuffer_NotifyReader(rb, false);
+    return rc;
+}
 
-    if (g > remain) {
-        if (isCompatible)
-            g = remain;
-        else {
-            RB_EXIT_CRITICAL_FROM_ISR(saved);
-            return RET_E_NO_MEM;
-        }
-    }
+/**
+ *
+ * @param rb 缓冲区句柄
+ * @param want 想要获取的大小
+ * @param out  实际输出的窗口
+ * @param granted 实际大小
+ * @param isCompatible  是否部分存入
+ * @return 是否成功
+ * @note DMA使用只能使用p1得长度禁止一次性使用 p1 + p2
+ */
+ret_code_t RingBuffer_WriteReserveFromISR(RingBuffer* rb, uint32_t want, RingBufferSpan* out,
+                                          uint32_t* granted, bool isCompatible) {
+    if (!RingBuffer_IsValid(rb) || !out || !granted) return RET_E_INVALID_ARG;
 
-    const uint32_t rear  = rb->rear_index;
-    const uint32_t front = rb->front_index;
-    const uint32_t size  = rb->size;
-
-    uint32_t n1 = 0, n2 = 0;
-
-    if (rear < front) {
-        // 可写连续段：rear .. front-1 之间（预留 1 字节区分满/空）
-        const uint32_t seg = front - rear - 1;
-        n1                 = (g < seg) ? g : seg;
-        n2                 = 0;
-
-        out->p1            = (n1 > 0) ? (rb->buffer + rear) : NULL;
-        out->n1            = n1;
-        out->p2            = NULL;
-        out->n2            = 0;
-        *granted           = n1 + n2;  // 注意：这里最多只能给 n1（因为不允许跨 front）
-        RB_EXIT_CRITICAL_FROM_ISR(saved);
-        return RET_OK;
-    } else {
-        // 空洞跨越末尾：先尾段再头段
-        const uint32_t tailFree = (front == 0) ? (size - rear - 1) : (size - rear);
-        n1                      = (g < tailFree) ? g : tailFree;
-        n2                      = g - n1;
-
-        out->p1                 = (n1 > 0) ? (rb->buffer + rear) : NULL;
-        out->n1                 = n1;
-        out->p2                 = (n2 > 0) ? (rb->buffer) : NULL;
-        out->n2                 = n2;
-        *granted                = n1 + n2;
-
-        RB_EXIT_CRITICAL_FROM_ISR(saved);
-        return RET_OK;
-    }
+    rb_isr_state_t saved = 0;
+    RB_LOCK_FROM_ISR(rb, saved);
+    const ret_code_t rc = RingBuffer_WriteReserve_Internal(rb, want, out, granted, isCompatible);
+    RB_UNLOCK_FROM_ISR(rb, saved);
+    return rc;
 }
 
 /**
@@ -642,105 +888,99 @@ ret_code_t RingBuffer_WriteReserveFromISR(RingBuffer* rb, uint32_t want, RingBuf
  * @return 成功或者失败
  */
 ret_code_t RingBuffer_WriteCommitFromISR(RingBuffer* rb, uint32_t commit) {
-    if (!rb || !rb->buffer || rb->size < 2) return RET_E_INVALID_ARG;
-
-    rb_isr_state_t saved;
-    RB_ENTER_CRITICAL_FROM_ISR(saved);
-
-    const uint32_t remain = RingBuffer_GetRemainSize_Internal(rb);
-    if (commit > remain) {
-        RB_EXIT_CRITICAL_FROM_ISR(saved);
-        return RET_E_NO_MEM;
-    }
-
-    if (rb->isPowerOfTwo_Size)
-        rb->rear_index = (rb->rear_index + commit) & (rb->size - 1);
-    else
-        rb->rear_index = (rb->rear_index + commit) % rb->size;
-
-    RB_EXIT_CRITICAL_FROM_ISR(saved);
-    return RET_OK;
+    if (!RingBuffer_IsValid(rb)) return RET_E_INVALID_ARG;
+
+    rb_isr_state_t saved = 0;
+    RB_LOCK_FROM_ISR(rb, saved);
+    const ret_code_t rc = RingBuffer_WriteCommit_Internal(rb, commit);
+    RB_UNLOCK_FROM_ISR(rb, saved);
+    if (ret_is_ok(rc)) RingBuffer_NotifyReader(rb, true);
+    return rc;
 }
 
 /**
- *
+ * @brief 申请读窗口（调用方负责临界区 / SPSC 消费者身份）
  * @param rb 创作句柄
  * @param want 想要多少空间
  * @param out 返回的窗口
  * @param granted 实际获得多少空间
  * @param isCompatible 是否启用兼容模式
  * @return 成功或者失败
- * @note DMA使用只能使用p1得长度禁止一次性使用 p1 + p2
  */
-ret_code_t RingBuffer_ReadReserve(RingBuffer* rb, uint32_t want, RingBufferSpan* out,
-                                  uint32_t* granted, bool isCompatible) {
-    if (!rb || !out || !granted || !rb->buffer || rb->size < 2) return RET_E_INVALID_ARG;
-
-    // 约定：want==0 直接视为成功但授予0（你也可以选择直接 return false，但要一致）
-    if (want == 0) {
-        out->p1  = NULL;
-        out->n1  = 0;
-        out->p2  = NULL;
-        out->n2  = 0;
-        *granted = 0;
-        return RET_OK;
-    }
-
-    RB_ENTER_CRITICAL();
-
+static ret_code_t RingBuffer_ReadReserve_Internal(RingBuffer* rb, const uint32_t want,
+                                                  RingBufferSpan* out, uint32_t* granted,
+                                                  const bool isCompatible) {
     const uint32_t used = RingBuffer_GetUsedSize_Internal(rb);
 
     uint32_t g          = want;
     if (g > used) {
         if (isCompatible)
             g = used;
-        else {
-            RB_EXIT_CRITICAL();
+        else
             return RET_E_DATA_NOT_ENOUGH;
-        }
     }
 
     /* 若 used==0 且兼容模式，则 g 可能变为0：按成功但授予0处理 */
     if (g == 0) {
-        out->p1  = NULL;
-        out->n1  = 0;
-        out->p2  = NULL;
-        out->n2  = 0;
-        *granted = 0;
-        RB_EXIT_CRITICAL();
+        RingBuffer_SpanClear(out, granted);
         return RET_OK;
     }
 
-    const uint32_t front = rb->front_index;
-    const uint32_t rear  = rb->rear_index;
-    const uint32_t size  = rb->size;
-
-    if (front < rear) {
-        /* 连续可读：front..rear-1 */
-        const uint32_t seg = rear - front;
-        const uint32_t n1  = (g < seg) ? g : seg;
-        out->p1            = rb->buffer + front;
-        out->n1            = n1;
-        out->p2            = NULL;
-        out->n2            = 0;
-        *granted           = out->n1 + out->n2;  // == n1
-    } else {
-        /* 跨尾：先读到末尾，再从头读到 rear-1 */
-        const uint32_t tailAvail = size - front;
-        const uint32_t n1        = (g < tailAvail) ? g : tailAvail;
-        const uint32_t n2        = g - n1;
+    /* g <= used，因此从 front 起的 g 字节一定是有效数据：先读到末尾，再从头读 */
+    const uint32_t offset    = RingBuffer_Offset(rb, rb->front_index);
+    const uint32_t tailAvail = rb->size - offset;
+    const uint32_t n1        = (g < tailAvail) ? g : tailAvail;
+    const uint32_t n2        = g - n1;
+
+    out->p1                  = rb->buffer + offset;
+    out->n1                  = n1;
+    out->p2                  = (n2 > 0) ? rb->buffer : NULL;
+    out->n2                  = n2;
+    *granted                 = n1 + n2;
+    return RET_OK;
+}
 
-        out->p1                  = (n1 > 0) ? (rb->buffer + front) : NULL;
-        out->n1                  = n1;
-        out->p2                  = (n2 > 0) ? rb->buffer : NULL;
-        out->n2                  = n2;
-        *granted                 = n1 + n2;
-    }
+/**
+ * @brief 提交读窗口（调用方负责临界区 / SPSC 消费者身份）
+ * @param rb 操作句柄
+ * @param commit 提交读取的字节数
+ * @return 成功或者失败
+ */
+static ret_code_t RingBuffer_ReadCommit_Internal(RingBuffer* rb, const uint32_t commit) {
+    const uint32_t used = RingBuffer_GetUsedSize_Internal(rb);
+    if (commit > used) return RET_E_DATA_NOT_ENOUGH;
 
-    RB_EXIT_CRITICAL();
+    RB_STORE_RELEASE(&rb->front_index, RingBuffer_Advance(rb, rb->front_index, commit));
+    RB_STAT_OUT(rb, commit);
     return RET_OK;
 }
 
+/**
+ *
+ * @param rb 创作句柄
+ * @param want 想要多少空间
+ * @param out 返回的窗口
+ * @param granted 实际获得多少空间
+ * @param isCompatible 是否启用兼容模式
+ * @return 成功或者失败
+ * @note DMA使用只能使用p1得长度禁止一次性使用 p1 + p2
+ */
+ret_code_t RingBuffer_ReadReserve(RingBuffer* rb, uint32_t want, RingBufferSpan* out,
+                                  uint32_t* granted, bool isCompatible) {
+    if (!RingBuffer_IsValid(rb) || !out || !granted) return RET_E_INVALID_ARG;
+
+    // 约定：want==0 直接视为成功但授予0（你也可以选择直接 return false，但要一致）
+    if (want == 0) {
+        RingBuffer_SpanClear(out, granted);
+        return RET_OK;
+    }
+
+    RB_LOCK(rb);
+    const ret_code_t rc = RingBuffer_ReadReserve_Internal(rb, want, out, granted, isCompatible);
+    RB_UNLOCK(rb);
+    return rc;
+}
+
 /**
  *
  * @param rb 创作句柄
@@ -752,168 +992,626 @@ ret_code_t RingBuffer_ReadReserve(RingBuffer* rb, uint32_t want, RingBufferSpan*
  */
 ret_code_t RingBuffer_ReadReserveFromISR(RingBuffer* rb, uint32_t want, RingBufferSpan* out,
                                          uint32_t* granted, bool isCompatible) {
-    if (!rb || !out || !granted || !rb->buffer || rb->size < 2) return RET_E_INVALID_ARG;
+    if (!RingBuffer_IsValid(rb) || !out || !granted) return RET_E_INVALID_ARG;
 
     // 约定：want==0 直接视为成功但授予0（你也可以选择直接 return false，但要一致）
     if (want == 0) {
-        out->p1  = NULL;
-        out->n1  = 0;
-        out->p2  = NULL;
-        out->n2  = 0;
-        *granted = 0;
+        RingBuffer_SpanClear(out, granted);
         return RET_OK;
     }
 
-    rb_isr_state_t saved;
-    RB_ENTER_CRITICAL_FROM_ISR(saved);
+    rb_isr_state_t saved = 0;
+    RB_LOCK_FROM_ISR(rb, saved);
+    const ret_code_t rc = RingBuffer_ReadReserve_Internal(rb, want, out, granted, isCompatible);
+    RB_UNLOCK_FROM_ISR(rb, saved);
+    return rc;
+}
 
-    const uint32_t used = RingBuffer_GetUsedSize_Internal(rb);
+/**
+ *
+ * @param rb 操作句柄
+ * @param commit 提交读取的字节数
+ * @return 成功或者失败
+ */
+ret_code_t RingBuffer_ReadCommit(RingBuffer* rb, uint32_t commit) {
+    if (!RingBuffer_IsValid(rb)) return RET_E_INVALID_ARG;
 
-    uint32_t g          = want;
-    if (g > used) {
-        if (isCompatible)
-            g = used;
-        else {
-            RB_EXIT_CRITICAL_FROM_ISR(saved);
-            return RET_E_DATA_NOT_ENOUGH;
+    RB_LOCK(rb);
+    const ret_code_t rc = RingBuffer_ReadCommit_Internal(rb, commit);
+    RB_UNLOCK(rb);
+    if (ret_is_ok(rc)) RingBuffer_NotifyWriter(rb, false);
+    return rc;
+}
+
+/**
+ *
+ * @param rb 操作句柄
+ * @param commit 提交读取的字节数
+ * @return 成功或者失败
+ */
+ret_code_t RingBuffer_ReadCommitFromISR(RingBuffer* rb, uint32_t commit) {
+    if (!RingBuffer_IsValid(rb)) return RET_E_INVALID_ARG;
+
+    rb_isr_state_t saved = 0;
+    RB_LOCK_FROM_ISR(rb, saved);
+    const ret_code_t rc = RingBuffer_ReadCommit_Internal(rb, commit);
+    RB_UNLOCK_FROM_ISR(rb, saved);
+    if (ret_is_ok(rc)) RingBuffer_NotifyWriter(rb, true);
+    return rc;
+}
+
+/**
+ * @brief 计算写入段数组总长度
+ * @param vec 段数组
+ * @param cnt 段数
+ * @param total 总长度
+ * @return 段非法（len>0 但 ptr 为空）或总长溢出时返回 false
+ */
+static inline bool RingBuffer_ConstVecTotal(const RingBufferConstVec* vec, const uint32_t cnt,
+                                            uint32_t* total) {
+    uint32_t sum = 0;
+    for (uint32_t i = 0; i < cnt; i++) {
+        if ((vec[i].len != 0 && vec[i].ptr == NULL) || sum + vec[i].len < sum) return false;
+        sum += vec[i].len;
+    }
+    *total = sum;
+    return true;
+}
+
+/**
+ * @brief 计算读取段数组总长度
+ * @param vec 段数组
+ * @param cnt 段数
+ * @param total 总长度
+ * @return 段非法（len>0 但 ptr 为空）或总长溢出时返回 false
+ */
+static inline bool RingBuffer_VecTotal(const RingBufferVec* vec, const uint32_t cnt,
+                                       uint32_t* total) {
+    uint32_t sum = 0;
+    for (uint32_t i = 0; i < cnt; i++) {
+        if ((vec[i].len != 0 && vec[i].ptr == NULL) || sum + vec[i].len < sum) return false;
+        sum += vec[i].len;
+    }
+    *total = sum;
+    return true;
+}
+
+/*
+ * MPSC 无锁写入：
+ * - mp_state 打包 [31:24] 未完成的写入方个数与 [23:0] 已认领计数，
+ *   一次 CAS 同时完成“认领空间”和“登记在写”
+ * - 写完数据后一次 CAS 注销；注销后没有其他写入方在写的那一位，把 rear 发布到当时的认领计数
+ * - 先认领的写入方被抢占时，后来者的数据也要等它写完才可见：按认领顺序发布，无需自旋等待
+ */
+#define RB_MP_IDX_MASK ((1u << 24) - 1u)
+#define RB_MP_ONE      (1u << 24)
+
+/**
+ * @brief MPSC：认领一段连续空间并登记为在写（可被任务/中断并发调用）
+ * @param rb 环形缓冲区句柄
+ * @param want 想要的字节数（<= size）
+ * @param isForceWrite 空间不足时是否只认领剩余部分
+ * @param start 认领起点（24 位计数）
+ * @return 实际认领的字节数，0 表示失败
+ */
+static uint32_t RingBuffer_MpClaim(RingBuffer* rb, const uint32_t want, const bool isForceWrite,
+                                   uint32_t* start) {
+    uint32_t st = RB_LOAD_ACQUIRE(&rb->mp_state);
+    for (;;) {
+        // 在写个数已满（255 层嵌套）时按空间不足处理
+        if ((st >> 24) == 0xFFu) return 0;
+        const uint32_t claim  = st & RB_MP_IDX_MASK;
+        const uint32_t front  = RB_LOAD_ACQUIRE(&rb->front_index);
+        const uint32_t remain = rb->size - ((claim - front) & RB_MP_IDX_MASK);
+        uint32_t g            = want;
+        if (g > remain) {
+            if (!isForceWrite) return 0;
+            g = remain;
+        }
+        if (g == 0) return 0;
+
+        const uint32_t next = ((st & ~RB_MP_IDX_MASK) + RB_MP_ONE) | ((claim + g) & RB_MP_IDX_MASK);
+        if (RB_CAS(&rb->mp_state, &st, next)) {
+            *start = claim;
+            return g;
         }
     }
+}
 
-    /* 若 used==0 且兼容模式，则 g 可能变为0：按成功但授予0处理 */
+/**
+ * @brief MPSC：注销在写，最后一个完成的写入方发布 rear
+ * @param rb 环形缓冲区句柄
+ */
+static void RingBuffer_MpCommit(RingBuffer* rb) {
+    uint32_t st = RB_LOAD_ACQUIRE(&rb->mp_state);
+    while (!RB_CAS(&rb->mp_state, &st, st - RB_MP_ONE)) {
+    }
+    const uint32_t left = st - RB_MP_ONE;
+    if ((left >> 24) != 0u) return;  // 仍有写入方未完成，由它负责发布
+
+    // 此刻所有已认领的数据都已写完；rear 只前移，比较时处理 24 位回绕
+    const uint32_t claim = left & RB_MP_IDX_MASK;
+    uint32_t rear        = RB_LOAD_ACQUIRE(&rb->rear_index);
+    for (;;) {
+        const uint32_t d = (claim - rear) & RB_MP_IDX_MASK;
+        // d > size：更晚的发布者已经推进过了
+        if (d == 0 || d > rb->size) return;
+        if (RB_CAS(&rb->rear_index, &rear, rear + d)) return;
+    }
+}
+
+/**
+ * @brief MPSC：分散写入（任务与中断共用，不进临界区）
+ * @param rb 环形缓冲区句柄
+ * @param vec 数据段数组
+ * @param cnt 段数
+ * @param total 段总长度
+ * @param written 实际写入的字节数
+ * @param isForceWrite 空间不足时是否按段顺序写入能写下的部分
+ * @return 返回是否成功
+ * @note  统计字段由多个写入方并发累加，只是近似值
+ */
+static ret_code_t RingBuffer_MpWriteV(RingBuffer* rb, const RingBufferConstVec* vec,
+                                      const uint32_t cnt, const uint32_t total, uint32_t* written,
+                                      const bool isForceWrite) {
+    // 非强制写入要么全写要么不写：超过容量直接失败，只有强制模式才截到 size
+    if (!isForceWrite && total > rb->size) {
+        RB_STAT_FAIL(rb);
+        return RET_E_NO_MEM;
+    }
+    uint32_t start   = 0;
+    const uint32_t g = RingBuffer_MpClaim(rb, MIN(total, rb->size), isForceWrite, &start);
     if (g == 0) {
-        out->p1  = NULL;
-        out->n1  = 0;
-        out->p2  = NULL;
-        out->n2  = 0;
-        *granted = 0;
-        RB_EXIT_CRITICAL_FROM_ISR(saved);
+        if (!isForceWrite) {
+            RB_STAT_FAIL(rb);
+            return RET_E_NO_MEM;
+        }
+        RB_STAT_TRUNC(rb, total);
+        *written = 0;
         return RET_OK;
     }
+    if (g < total) RB_STAT_TRUNC(rb, total - g);
+
+    uint32_t done = 0;
+    for (uint32_t i = 0; i < cnt && done < g; i++) {
+        const uint32_t n = MIN(vec[i].len, g - done);
+        if (n == 0) continue;
+        RingBuffer_CopyIn(rb, start + done, vec[i].ptr, n);
+        done += n;
+    }
+    RingBuffer_MpCommit(rb);
+    RB_STAT_IN(rb, done);
+    *written = done;
+    return RET_OK;
+}
 
-    const uint32_t front = rb->front_index;
-    const uint32_t rear  = rb->rear_index;
-    const uint32_t size  = rb->size;
-
-    if (front < rear) {
-        /* 连续可读：front..rear-1 */
-        const uint32_t seg = rear - front;
-        const uint32_t n1  = (g < seg) ? g : seg;
-
-        out->p1            = rb->buffer + front;
-        out->n1            = n1;
-        out->p2            = NULL;
-        out->n2            = 0;
-        *granted           = out->n1 + out->n2;  // == n1
+/**
+ * @brief 分散写入（调用方负责临界区 / SPSC 生产者身份）
+ * @param rb 环形缓冲区指针
+ * @param vec 数据段数组
+ * @param cnt 段数
+ * @param total 段总长度
+ * @param written 实际写入的字节数
+ * @param isForceWrite 空间不足时是否按段顺序写入能写下的部分
+ * @return 返回是否成功
+ */
+static ret_code_t RingBuffer_WriteV_Internal(RingBuffer* rb, const RingBufferConstVec* vec,
+                                             const uint32_t cnt, const uint32_t total,
+                                             uint32_t* written, const bool isForceWrite) {
+    if (rb->isMpsc) return RingBuffer_MpWriteV(rb, vec, cnt, total, written, isForceWrite);
+
+    uint32_t budget = total;
+    uint32_t skip   = 0;
+    if (rb->isOverwrite) {
+        // 覆盖模式：超过 size 的部分从头丢弃，只保留最新的 size 字节；再挤出所需空间
+        if (budget > rb->size) {
+            skip   = budget - rb->size;
+            budget = rb->size;
+            rb->evicted += skip;
+        }
+        RingBuffer_Evict_Internal(rb, budget);
     } else {
-        /* 跨尾：先读到末尾，再从头读到 rear-1 */
-        const uint32_t tailAvail = size - front;
-        const uint32_t n1        = (g < tailAvail) ? g : tailAvail;
-        const uint32_t n2        = g - n1;
-
-        out->p1                  = (n1 > 0) ? (rb->buffer + front) : NULL;
-        out->n1                  = n1;
-        out->p2                  = (n2 > 0) ? rb->buffer : NULL;
-        out->n2                  = n2;
-        *granted                 = n1 + n2;
+        const uint32_t remain = RingBuffer_GetRemainSize_Internal(rb);
+        if (remain < budget) {
+            if (!isForceWrite) {
+                RB_STAT_FAIL(rb);
+                return RET_E_NO_MEM;
+            }
+            RB_STAT_TRUNC(rb, budget - remain);
+            budget = remain;
+        }
     }
 
-    RB_EXIT_CRITICAL_FROM_ISR(saved);
+    // 逐段拷贝，最后统一发布 rear：消费者只会看到完整的一条记录
+    const uint32_t rear = rb->rear_index;
+    uint32_t done       = 0;
+    for (uint32_t i = 0; i < cnt && done < budget; i++) {
+        const uint8_t* src = vec[i].ptr;
+        uint32_t len       = vec[i].len;
+        if (skip >= len) {
+            skip -= len;
+            continue;
+        }
+        src += skip;
+        len -= skip;
+        skip             = 0;
+
+        const uint32_t n = MIN(len, budget - done);
+        // 段起点按计数前移：非 2 的幂时 rear + done 可能越过 2*size 镜像范围
+        RingBuffer_CopyIn(rb, RingBuffer_Advance(rb, rear, done), src, n);
+        done += n;
+    }
+    if (done > 0) {
+        RB_STORE_RELEASE(&rb->rear_index, RingBuffer_Advance(rb, rear, done));
+        RB_STAT_IN(rb, done);
+    }
+    *written = done;
     return RET_OK;
 }
 
 /**
- *
- * @param rb 操作句柄
- * @param commit 提交读取的字节数
- * @return 成功或者失败
+ * @brief 聚集读取（调用方负责临界区 / SPSC 消费者身份）
+ * @param rb 环形缓冲区指针
+ * @param vec 接收段数组
+ * @param cnt 段数
+ * @param total 段总长度
+ * @param nread 实际读取的字节数
+ * @param isForceRead 数据不足时是否按段顺序读出已有的数据
+ * @return 返回是否成功
  */
-ret_code_t RingBuffer_ReadCommit(RingBuffer* rb, uint32_t commit) {
-    if (!rb || !rb->buffer || rb->size < 2) return RET_E_INVALID_ARG;
-
-    RB_ENTER_CRITICAL();
+static ret_code_t RingBuffer_ReadV_Internal(RingBuffer* rb, const RingBufferVec* vec,
+                                            const uint32_t cnt, const uint32_t total,
+                                            uint32_t* nread, const bool isForceRead) {
+    uint32_t budget     = total;
     const uint32_t used = RingBuffer_GetUsedSize_Internal(rb);
-    if (commit > used) {
-        RB_EXIT_CRITICAL();
-        return RET_E_DATA_NOT_ENOUGH;
+    if (used < budget) {
+        if (!isForceRead) return RET_E_DATA_NOT_ENOUGH;
+        budget = used;
     }
 
-    if (rb->isPowerOfTwo_Size)
-        rb->front_index = (rb->front_index + commit) & (rb->size - 1);
-    else
-        rb->front_index = (rb->front_index + commit) % rb->size;
-
-    RB_EXIT_CRITICAL();
+    const uint32_t front = rb->front_index;
+    uint32_t done        = 0;
+    for (uint32_t i = 0; i < cnt && done < budget; i++) {
+        const uint32_t n = MIN(vec[i].len, budget - done);
+        RingBuffer_CopyOut(rb, RingBuffer_Advance(rb, front, done), vec[i].ptr, n);
+        done += n;
+    }
+    if (done > 0) {
+        RB_STORE_RELEASE(&rb->front_index, RingBuffer_Advance(rb, front, done));
+        RB_STAT_OUT(rb, done);
+    }
+    *nread = done;
     return RET_OK;
 }
 
 /**
- *
- * @param rb 操作句柄
- * @param commit 提交读取的字节数
- * @return 成功或者失败
+ * @brief 分散写入：多个段作为一条记录整体写入
+ * @param rb 环形缓冲区指针
+ * @param vec 数据段数组
+ * @param cnt 段数
+ * @param written 实际写入的字节数
+ * @param isForceWrite 空间不足时是否按段顺序写入能写下的部分
+ * @return 返回是否成功
  */
-ret_code_t RingBuffer_ReadCommitFromISR(RingBuffer* rb, uint32_t commit) {
-    if (!rb || !rb->buffer || rb->size < 2) return RET_E_INVALID_ARG;
+ret_code_t RingBuffer_WriteV(RingBuffer* rb, const RingBufferConstVec* vec, uint32_t cnt,
+                             uint32_t* written, bool isForceWrite) {
+    uint32_t total = 0;
+    if (!RingBuffer_IsValid(rb) || vec == NULL || cnt == 0 || written == NULL ||
+        !RingBuffer_ConstVecTotal(vec, cnt, &total) || total == 0)
+        return RET_E_INVALID_ARG;
 
-    rb_isr_state_t saved;
-    RB_ENTER_CRITICAL_FROM_ISR(saved);
-    const uint32_t used = RingBuffer_GetUsedSize_Internal(rb);
-    if (commit > used) {
-        RB_EXIT_CRITICAL_FROM_ISR(saved);
-        return RET_E_DATA_NOT_ENOUGH;
+    RB_LOCK(rb);
+    const ret_code_t rc = RingBuffer_WriteV_Internal(rb, vec, cnt, total, written, isForceWrite);
+    RB_UNLOCK(rb);
+    if (ret_is_ok(rc)) RingBuffer_NotifyReader(rb, false);
+    return rc;
+}
+
+/**
+ * @brief 分散写入 中断版本
+ * @param rb 环形缓冲区指针
+ * @param vec 数据段数组
+ * @param cnt 段数
+ * @param written 实际写入的字节数
+ * @param isForceWrite 空间不足时是否按段顺序写入能写下的部分
+ * @return 返回是否成功
+ */
+ret_code_t RingBuffer_WriteVFromISR(RingBuffer* rb, const RingBufferConstVec* vec, uint32_t cnt,
+                                    uint32_t* written, bool isForceWrite) {
+    uint32_t total = 0;
+    if (!RingBuffer_IsValid(rb) || vec == NULL || cnt == 0 || written == NULL ||
+        !RingBuffer_ConstVecTotal(vec, cnt, &total) || total == 0)
+        return RET_E_INVALID_ARG;
+
+    rb_isr_state_t saved = 0;
+    RB_LOCK_FROM_ISR(rb, saved);
+    const ret_code_t rc = RingBuffer_WriteV_Internal(rb, vec, cnt, total, written, isForceWrite);
+    RB_UNLOCK_FROM_ISR(rb, saved);
+    if (ret_is_ok(rc)) RingBuffer_NotifyReader(rb, true);
+    return rc;
+}
+
+/**
+ * @brief 聚集读取：一次读出并依次填充多个段
+ * @param rb 环形缓冲区指针
+ * @param vec 接收段数组
+ * @param cnt 段数
+ * @param nread 实际读取的字节数
+ * @param isForceRead 数据不足时是否按段顺序读出已有的数据
+ * @return 返回是否成功
+ */
+ret_code_t RingBuffer_ReadV(RingBuffer* rb, const RingBufferVec* vec, uint32_t cnt,
+                            uint32_t* nread, bool isForceRead) {
+    uint32_t total = 0;
+    if (!RingBuffer_IsValid(rb) || vec == NULL || cnt == 0 || nread == NULL ||
+        !RingBuffer_VecTotal(vec, cnt, &total) || total == 0)
+        return RET_E_INVALID_ARG;
+
+    RB_LOCK(rb);
+    const ret_code_t rc = RingBuffer_ReadV_Internal(rb, vec, cnt, total, nread, isForceRead);
+    RB_UNLOCK(rb);
+    if (ret_is_ok(rc)) RingBuffer_NotifyWriter(rb, false);
+    return rc;
+}
+
+/**
+ * @brief 聚集读取 中断版本
+ * @param rb 环形缓冲区指针
+ * @param vec 接收段数组
+ * @param cnt 段数
+ * @param nread 实际读取的字节数
+ * @param isForceRead 数据不足时是否按段顺序读出已有的数据
+ * @return 返回是否成功
+ */
+ret_code_t RingBuffer_ReadVFromISR(RingBuffer* rb, const RingBufferVec* vec, uint32_t cnt,
+                                   uint32_t* nread, bool isForceRead) {
+    uint32_t total = 0;
+    if (!RingBuffer_IsValid(rb) || vec == NULL || cnt == 0 || nread == NULL ||
+        !RingBuffer_VecTotal(vec, cnt, &total) || total == 0)
+        return RET_E_INVALID_ARG;
+
+    rb_isr_state_t saved = 0;
+    RB_LOCK_FROM_ISR(rb, saved);
+    const ret_code_t rc = RingBuffer_ReadV_Internal(rb, vec, cnt, total, nread, isForceRead);
+    RB_UNLOCK_FROM_ISR(rb, saved);
+    if (ret_is_ok(rc)) RingBuffer_NotifyWriter(rb, true);
+    return rc;
+}
+
+/* SWAR：一次比较 4 个字节 */
+#define RB_SWAR_ONES  0x01010101u
+#define RB_SWAR_HIGHS 0x80808080u
+
+/**
+ * @brief 字中是否含 0 字节（最低的命中字节一定是真命中）
+ * @param v 32 位字
+ * @return 非 0 表示含 0 字节
+ */
+static inline uint32_t RingBuffer_SwarHasZero(const uint32_t v) {
+    return (v - RB_SWAR_ONES) & ~v & RB_SWAR_HIGHS;
+}
+
+/**
+ * @brief 字节是否在集合中
+ * @param b 字节
+ * @param set 字节集合
+ * @param set_len 集合大小
+ * @return 在集合中返回 true
+ */
+static inline bool RingBuffer_ByteInSet(const uint8_t b, const uint8_t* set,
+                                        const uint32_t set_len) {
+    for (uint32_t k = 0; k < set_len; k++) {
+        if (b == set[k]) return true;
+    }
+    return false;
+}
+
+/**
+ * @brief 在线性内存中查找集合内任一字节
+ * @param p 起始地址
+ * @param n 长度
+ * @param set 字节集合
+ * @param pat 集合中每个字节广播到 4 字节后的模式
+ * @param set_len 集合大小
+ * @return 命中位置相对 p 的偏移；未找到返回 n
+ */
+static uint32_t RingBuffer_ScanLinear(const uint8_t* p, const uint32_t n, const uint8_t* set,
+                                      const uint32_t* pat, const uint32_t set_len) {
+    uint32_t i = 0;
+
+    /* 1、逐字节走到 4 字节对齐 */
+    while (i < n && ((uintptr_t)(p + i) & 3u) != 0u) {
+        if (RingBuffer_ByteInSet(p[i], set, set_len)) return i;
+        i++;
     }
 
-    if (rb->isPowerOfTwo_Size)
-        rb->front_index = (rb->front_index + commit) & (rb->size - 1);
-    else
-        rb->front_index = (rb->front_index + commit) % rb->size;
+    /* 2、按字比较：与模式异或后含 0 字节即命中 */
+    for (; i + 4u <= n; i += 4u) {
+        uint32_t w;
+        memcpy(&w, p + i, sizeof(w)); /* 已对齐，编译为单条 LDR */
+        uint32_t hit = 0;
+        for (uint32_t k = 0; k < set_len; k++) hit |= RingBuffer_SwarHasZero(w ^ pat[k]);
+        if (hit != 0u) break;
+    }
+
+    /* 3、命中字 / 尾部逐字节确认 */
+    for (; i < n; i++) {
+        if (RingBuffer_ByteInSet(p[i], set, set_len)) return i;
+    }
+    return n;
+}
 
-    RB_EXIT_CRITICAL_FROM_ISR(saved);
+/**
+ * @brief 查找实现：持锁时只取快照，扫描在锁外进行
+ * @param rb 环形缓冲区指针
+ * @param set 字节集合
+ * @param set_len 集合大小
+ * @param from 起始偏移（相对 front）
+ * @param offset 命中偏移（相对 front）
+ * @param front 快照：front 计数
+ * @param used 快照：已用字节数
+ * @return 未找到返回 RET_E_NOT_FOUND
+ * @note  [front, front+used) 内的数据生产者不会改动，只有消费者自己会推进 front
+ */
+static ret_code_t RingBuffer_Find_Internal(const RingBuffer* rb, const uint8_t* set,
+                                           const uint32_t set_len, const uint32_t from,
+                                           uint32_t* offset, const uint32_t front,
+                                           const uint32_t used) {
+    if (from >= used) return RET_E_NOT_FOUND;
+
+    uint32_t pat[RB_FIND_SET_MAX];
+    for (uint32_t k = 0; k < set_len; k++) pat[k] = (uint32_t)set[k] * RB_SWAR_ONES;
+
+    /* 搜索区 [from, used) 最多分为尾段 + 头段两段 */
+    const uint32_t start = RingBuffer_Offset(rb, RingBuffer_Advance(rb, front, from));
+    const uint32_t total = used - from;
+    const uint32_t n1    = MIN(total, rb->size - start);
+
+    uint32_t pos         = RingBuffer_ScanLinear(rb->buffer + start, n1, set, pat, set_len);
+    if (pos == n1 && total > n1) {
+        pos = n1 + RingBuffer_ScanLinear(rb->buffer, total - n1, set, pat, set_len);
+    }
+    if (pos == total) return RET_E_NOT_FOUND;
+
+    *offset = from + pos;
     return RET_OK;
 }
 
 /**
- * @brief 丢弃指定字节数据
+ * @brief 查找集合内任一字节
+ * @param rb 环形缓冲区指针
+ * @param set 字节集合
+ * @param set_len 集合大小（1..RB_FIND_SET_MAX）
+ * @param from 起始偏移（相对 front）
+ * @param offset 命中偏移（相对 front）
+ * @return 未找到返回 RET_E_NOT_FOUND
+ */
+ret_code_t RingBuffer_FindAny(const RingBuffer* rb, const uint8_t* set, uint32_t set_len,
+                              uint32_t from, uint32_t* offset) {
+    if (!RingBuffer_IsValid(rb) || set == NULL || set_len == 0 || set_len > RB_FIND_SET_MAX ||
+        offset == NULL)
+        return RET_E_INVALID_ARG;
+
+    RB_LOCK(rb);
+    const uint32_t front = RB_LOAD_ACQUIRE(&rb->front_index);
+    const uint32_t used  = RingBuffer_GetUsedSize_Internal(rb);
+    RB_UNLOCK(rb);
+    return RingBuffer_Find_Internal(rb, set, set_len, from, offset, front, used);
+}
+
+/**
+ * @brief 查找集合内任一字节 中断版本
+ * @param rb 环形缓冲区指针
+ * @param set 字节集合
+ * @param set_len 集合大小（1..RB_FIND_SET_MAX）
+ * @param from 起始偏移（相对 front）
+ * @param offset 命中偏移（相对 front）
+ * @return 未找到返回 RET_E_NOT_FOUND
+ */
+ret_code_t RingBuffer_FindAnyFromISR(const RingBuffer* rb, const uint8_t* set, uint32_t set_len,
+                                     uint32_t from, uint32_t* offset) {
+    if (!RingBuffer_IsValid(rb) || set == NULL || set_len == 0 || set_len > RB_FIND_SET_MAX ||
+        offset == NULL)
+        return RET_E_INVALID_ARG;
+
+    rb_isr_state_t saved = 0;
+    RB_LOCK_FROM_ISR(rb, saved);
+    const uint32_t front = RB_LOAD_ACQUIRE(&rb->front_index);
+    const uint32_t used  = RingBuffer_GetUsedSize_Internal(rb);
+    RB_UNLOCK_FROM_ISR(rb, saved);
+    return RingBuffer_Find_Internal(rb, set, set_len, from, offset, front, used);
+}
+
+/**
+ * @brief 查找单个字节（如 '\n'）
+ * @param rb 环形缓冲区指针
+ * @param byte 目标字节
+ * @param from 起始偏移（相对 front）
+ * @param offset 命中偏移（相对 front）
+ * @return 未找到返回 RET_E_NOT_FOUND
+ */
+ret_code_t RingBuffer_FindByte(const RingBuffer* rb, uint8_t byte, uint32_t from,
+                               uint32_t* offset) {
+    return RingBuffer_FindAny(rb, &byte, 1, from, offset);
+}
+
+/**
+ * @brief 查找单个字节 中断版本
+ * @param rb 环形缓冲区指针
+ * @param byte 目标字节
+ * @param from 起始偏移（相对 front）
+ * @param offset 命中偏移（相对 front）
+ * @return 未找到返回 RET_E_NOT_FOUND
+ */
+ret_code_t RingBuffer_FindByteFromISR(const RingBuffer* rb, uint8_t byte, uint32_t from,
+                                      uint32_t* offset) {
+    return RingBuffer_FindAnyFromISR(rb, &byte, 1, from, offset);
+}
+
+/**
+ * @brief 覆盖模式下累计被挤掉的字节数
+ * @param rb 环形缓冲区指针
+ * @return 字节数
+ */
+uint32_t RingBuffer_GetEvicted(const RingBuffer* rb) {
+    if (rb == NULL) return 0;
+    return rb->evicted;
+}
+
+/**
+ * @brief 丢弃指定字节数据（调用方负责临界区 / SPSC 消费者身份）
  * @param rb 操作句柄
  * @param drop 期望丢弃字节数
  * @param dropped 实际丢弃字节数
  * @param isCompatible 是否开启兼容模式
  * @return 成功或者失败
- * @note  兼容模式下 used为0会返回true
  */
-ret_code_t RingBuffer_Drop(RingBuffer* rb, uint32_t drop, uint32_t* dropped, bool isCompatible) {
-    if (!rb || !rb->buffer || rb->size < 2 || !dropped) return RET_E_INVALID_ARG;
-
+static ret_code_t RingBuffer_Drop_Internal(RingBuffer* rb, const uint32_t drop,
+                                           uint32_t* dropped, const bool isCompatible) {
     /* 1、判断剩余的存储字节数 */
-    RB_ENTER_CRITICAL();
-    const uint32_t used = RingBuffer_GetUsedSize_Internal(rb);
     if (drop == 0) {
         *dropped = 0;
-        RB_EXIT_CRITICAL();
         return RET_OK;
     }
+    const uint32_t used = RingBuffer_GetUsedSize_Internal(rb);
+
     /* 2、实际要丢失多少字节 */
-    uint32_t g = drop;
+    uint32_t g          = drop;
     if (g > used) {
         if (isCompatible)
             g = used;
         else {
             *dropped = 0;
-            RB_EXIT_CRITICAL();
             return RET_E_DATA_NOT_ENOUGH;
         }
     }
 
     /* 3、开始丢弃 */
-    if (rb->isPowerOfTwo_Size)
-        rb->front_index = (rb->front_index + g) & (rb->size - 1);
-    else
-        rb->front_index = (rb->front_index + g) % rb->size;
+    RB_STORE_RELEASE(&rb->front_index, RingBuffer_Advance(rb, rb->front_index, g));
+    RB_STAT_OUT(rb, g);
     *dropped = g;
-    RB_EXIT_CRITICAL();
     return RET_OK;
 }
 
+/**
+ * @brief 丢弃指定字节数据
+ * @param rb 操作句柄
+ * @param drop 期望丢弃字节数
+ * @param dropped 实际丢弃字节数
+ * @param isCompatible 是否开启兼容模式
+ * @return 成功或者失败
+ * @note  兼容模式下 used为0会返回true
+ */
+ret_code_t RingBuffer_Drop(RingBuffer* rb, uint32_t drop, uint32_t* dropped, bool isCompatible) {
+    if (!RingBuffer_IsValid(rb) || !dropped) return RET_E_INVALID_ARG;
+
+    RB_LOCK(rb);
+    const ret_code_t rc = RingBuffer_Drop_Internal(rb, drop, dropped, isCompatible);
+    RB_UNLOCK(rb);
+    if (ret_is_ok(rc)) RingBuffer_NotifyWriter(rb, false);
+    return rc;
+}
+
 /**
  * @brief 丢弃指定字节数据
  * @param rb 操作句柄
@@ -925,38 +1623,330 @@ ret_code_t RingBuffer_Drop(RingBuffer* rb, uint32_t drop, uint32_t* dropped, boo
  */
 ret_code_t RingBuffer_DropFromISR(RingBuffer* rb, uint32_t drop, uint32_t* dropped,
                                   bool isCompatible) {
-    if (!rb || !rb->buffer || rb->size < 2 || !dropped) return RET_E_INVALID_ARG;
+    if (!RingBuffer_IsValid(rb) || !dropped) return RET_E_INVALID_ARG;
+
+    rb_isr_state_t saved = 0;
+    RB_LOCK_FROM_ISR(rb, saved);
+    const ret_code_t rc = RingBuffer_Drop_Internal(rb, drop, dropped, isCompatible);
+    RB_UNLOCK_FROM_ISR(rb, saved);
+    if (ret_is_ok(rc)) RingBuffer_NotifyWriter(rb, true);
+    return rc;
+}
 
-    /* 1、判断剩余的存储字节数 */
 
-    rb_isr_state_t saved;
-    RB_ENTER_CRITICAL_FROM_ISR(saved);
+/**
+ * @brief 发布外部写入方（DMA）的物理写位置（调用方负责临界区 / SPSC 生产者身份）
+ * @param rb 句柄
+ * @param pos 外部写入方下一次要写的物理偏移 [0, size)
+ * @param delta 本次新增的字节数
+ * @return 新数据覆盖了未读数据时返回 RET_E_DATA_OVERFLOW（rear 仍然推进）
+ */
+static ret_code_t RingBuffer_PublishWritePos_Internal(RingBuffer* rb, const uint32_t pos,
+                                                      uint32_t* delta) {
+    const uint32_t rear = rb->rear_index;
+    const uint32_t off  = RingBuffer_Offset(rb, rear);
+    const uint32_t d    = (pos >= off) ? (pos - off) : (pos + rb->size - off);
+    *delta              = d;
+    if (d == 0) return RET_OK;
+
+    /* 数据已由外设写入存储区，这里只发布索引 */
     const uint32_t used = RingBuffer_GetUsedSize_Internal(rb);
-    if (drop == 0) {
-        *dropped = 0;
-        RB_EXIT_CRITICAL_FROM_ISR(saved);
-        return RET_OK;
+    RB_STORE_RELEASE(&rb->rear_index, RingBuffer_Advance(rb, rear, d));
+    RB_STAT_IN(rb, d);
+    if (used + d > rb->size) {
+        rb->overruns++;
+        return RET_E_DATA_OVERFLOW;
     }
-    /* 2、实际要丢失多少字节 */
-    uint32_t g = drop;
-    if (g > used) {
-        if (isCompatible)
-            g = used;
-        else {
-            *dropped = 0;
-            RB_EXIT_CRITICAL_FROM_ISR(saved);
-            return RET_E_DATA_NOT_ENOUGH;
+    return RET_OK;
+}
+
+/**
+ * @brief 发布外部写入方的物理写位置
+ * @param rb 句柄（CreateRingBufferStatic 创建）
+ * @param pos 外部写入方下一次要写的物理偏移 [0, size)
+ * @param delta 本次新增的字节数
+ * @return 覆盖了未读数据返回 RET_E_DATA_OVERFLOW，消费者应调用 RingBuffer_CheckOverrun 重同步
+ * @note  只能识别不足一圈的增量：两次发布之间外设写入超过 size 字节无法察觉，
+ *        需保证发布频率（IDLE + 半满/全满中断）
+ */
+ret_code_t RingBuffer_PublishWritePos(RingBuffer* rb, uint32_t pos, uint32_t* delta) {
+    if (!RingBuffer_IsValid(rb) || !rb->isExternal || pos >= rb->size || delta == NULL)
+        return RET_E_INVALID_ARG;
+
+    RB_LOCK(rb);
+    const ret_code_t rc = RingBuffer_PublishWritePos_Internal(rb, pos, delta);
+    RB_UNLOCK(rb);
+    if (*delta > 0) RingBuffer_NotifyReader(rb, false);
+    return rc;
+}
+
+/**
+ * @brief 发布外部写入方的物理写位置 中断版本
+ * @param rb 句柄（CreateRingBufferStatic 创建）
+ * @param pos 外部写入方下一次要写的物理偏移 [0, size)
+ * @param delta 本次新增的字节数
+ * @return 覆盖了未读数据返回 RET_E_DATA_OVERFLOW
+ */
+ret_code_t RingBuffer_PublishWritePosFromISR(RingBuffer* rb, uint32_t pos, uint32_t* delta) {
+    if (!RingBuffer_IsValid(rb) || !rb->isExternal || pos >= rb->size || delta == NULL)
+        return RET_E_INVALID_ARG;
+
+    rb_isr_state_t saved = 0;
+    RB_LOCK_FROM_ISR(rb, saved);
+    const ret_code_t rc = RingBuffer_PublishWritePos_Internal(rb, pos, delta);
+    RB_UNLOCK_FROM_ISR(rb, saved);
+    if (*delta > 0) RingBuffer_NotifyReader(rb, true);
+    return rc;
+}
+
+/**
+ * @brief 外部写入方从物理偏移 0 重新开始（如 DMA 出错重启）
+ * @param rb 句柄（CreateRingBufferStatic 创建）
+ * @return 返回是否成功
+ * @note  rear 跳到下一圈起点，中间的旧字节无效，因此记一次 overrun 让消费者重同步
+ */
+ret_code_t RingBuffer_PublishRestartFromISR(RingBuffer* rb) {
+    if (!RingBuffer_IsValid(rb) || !rb->isExternal) return RET_E_INVALID_ARG;
+
+    rb_isr_state_t saved = 0;
+    RB_LOCK_FROM_ISR(rb, saved);
+    const uint32_t rear = rb->rear_index;
+    const uint32_t off  = RingBuffer_Offset(rb, rear);
+    if (off != 0) {
+        RB_STORE_RELEASE(&rb->rear_index, RingBuffer_Advance(rb, rear, rb->size - off));
+    }
+    rb->overruns++;
+    RB_UNLOCK_FROM_ISR(rb, saved);
+    return RET_OK;
+}
+
+/**
+ * @brief 外部写入方从物理偏移 0 重新开始（任务版本）
+ * @param rb 句柄（CreateRingBufferStatic 创建）
+ * @return 返回是否成功
+ */
+ret_code_t RingBuffer_PublishRestart(RingBuffer* rb) {
+    if (!RingBuffer_IsValid(rb) || !rb->isExternal) return RET_E_INVALID_ARG;
+
+    RB_LOCK(rb);
+    const uint32_t rear = rb->rear_index;
+    const uint32_t off  = RingBuffer_Offset(rb, rear);
+    if (off != 0) {
+        RB_STORE_RELEASE(&rb->rear_index, RingBuffer_Advance(rb, rear, rb->size - off));
+    }
+    rb->overruns++;
+    RB_UNLOCK(rb);
+    return RET_OK;
+}
+
+/**
+ * @brief 消费者检查外部写入方是否覆盖过未读数据，是则丢弃全部积压重新同步
+ * @param rb 句柄
+ * @return 发生过覆盖返回 true（积压数据已丢弃）
+ */
+bool RingBuffer_CheckOverrun(RingBuffer* rb) {
+    if (!RingBuffer_IsValid(rb)) return false;
+    const uint32_t overruns = rb->overruns;
+    if (overruns == rb->overruns_seen) return false;
+
+    rb->overruns_seen = overruns;
+    (void)ResetRingBuffer(rb);
+    return true;
+}
+
+#if RB_WAIT_SUPPORTED
+/**
+ * @brief 计算剩余等待时间
+ * @param start 开始等待的 tick
+ * @param timeout_ms 总超时
+ * @return 剩余毫秒数，0 表示已超时
+ */
+static uint32_t RingBuffer_WaitLeft(const uint32_t start, const uint32_t timeout_ms) {
+    if (timeout_ms == RB_WAIT_FOREVER) return RB_WAIT_FOREVER;
+    const uint32_t elapsed = RB_TICK_TO_MS(RB_TICK_NOW() - start);
+    return (elapsed >= timeout_ms) ? 0 : (timeout_ms - elapsed);
+}
+#endif
+
+/**
+ * @brief 阻塞读取：已用达到 min 字节后读出最多 *size 字节
+ * @param rb 环形缓冲区指针
+ * @param add 接收数据的地址
+ * @param size 输入接收区大小，输出实际读出字节数
+ * @param min 唤醒阈值（1 <= min <= *size 且 min <= rb->size）
+ * @param timeout_ms 超时时间（OSAL_WAIT_FOREVER 永久等待）
+ * @return 超时返回 RET_E_TIMEOUT（*size 置 0）
+ * @note  仅任务上下文；先登记阈值再复查已用，与生产者“先发布再检查阈值”配对，不会丢唤醒
+ */
+ret_code_t RingBuffer_ReadWait(RingBuffer* rb, uint8_t* add, uint32_t* size, const uint32_t min,
+                               const uint32_t timeout_ms) {
+    if (!RingBuffer_IsValid(rb) || add == NULL || size == NULL || *size == 0 || min == 0 ||
+        min > *size || min > rb->size)
+        return RET_E_INVALID_ARG;
+#if RB_WAIT_SUPPORTED
+    if (rb->rd_waiter == NULL) return RET_E_UNSUPPORTED;
+
+    const uint32_t cap   = *size;
+    const uint32_t start = RB_TICK_NOW();
+    for (;;) {
+        if (RingBuffer_GetUsedSize(rb) >= min) {
+            *size = cap;
+            return ReadRingBuffer(rb, add, size, true);
         }
+
+        const uint32_t left = RingBuffer_WaitLeft(start, timeout_ms);
+        if (left == 0) break;
+
+        rb->rd_need = min;
+        RB_FENCE();
+        if (RingBuffer_GetUsedSize(rb) < min) (void)RB_SEM_TAKE(rb->rd_waiter, left);
+        rb->rd_need = 0;
     }
+    *size = 0;
+    return RET_E_TIMEOUT;
+#else
+    (void)timeout_ms;
+    return RET_E_UNSUPPORTED;
+#endif
+}
 
-    /* 3、开始丢弃 */
-    if (rb->isPowerOfTwo_Size)
-        rb->front_index = (rb->front_index + g) & (rb->size - 1);
-    else
-        rb->front_index = (rb->front_index + g) % rb->size;
-    *dropped = g;
-    RB_EXIT_CRITICAL_FROM_ISR(saved);
+/**
+ * @brief 阻塞写入：空闲达到 *size 字节后整体写入
+ * @param rb 环形缓冲区指针
+ * @param add 数据源地址
+ * @param size 输入写入字节数（<= rb->size），输出实际写入字节数
+ * @param timeout_ms 超时时间（OSAL_WAIT_FOREVER 永久等待）
+ * @return 超时返回 RET_E_TIMEOUT（*size 置 0）
+ * @note  仅任务上下文；覆盖模式写入永不失败，直接写入不等待
+ */
+ret_code_t RingBuffer_WriteWait(RingBuffer* rb, const uint8_t* add, uint32_t* size,
+                                const uint32_t timeout_ms) {
+    if (!RingBuffer_IsValid(rb) || add == NULL || size == NULL || *size == 0 || *size > rb->size)
+        return RET_E_INVALID_ARG;
+    if (rb->isOverwrite) return WriteRingBuffer(rb, add, size, false);
+#if RB_WAIT_SUPPORTED
+    if (rb->wr_waiter == NULL) return RET_E_UNSUPPORTED;
+
+    const uint32_t want  = *size;
+    const uint32_t start = RB_TICK_NOW();
+    for (;;) {
+        if (RingBuffer_GetRemainSize(rb) >= want) {
+            *size               = want;
+            /* 多生产者时空间可能被抢走，失败则继续等待 */
+            const ret_code_t rc = WriteRingBuffer(rb, add, size, false);
+            if (!ret_is_no_mem(rc)) return rc;
+        }
+
+        const uint32_t left = RingBuffer_WaitLeft(start, timeout_ms);
+        if (left == 0) break;
+
+        rb->wr_need = want;
+        RB_FENCE();
+        if (RingBuffer_GetRemainSize(rb) < want) (void)RB_SEM_TAKE(rb->wr_waiter, left);
+        rb->wr_need = 0;
+    }
+    *size = 0;
+    return RET_E_TIMEOUT;
+#else
+    (void)timeout_ms;
+    return RET_E_UNSUPPORTED;
+#endif
+}
+
+#if defined(ENABLE_RINGBUFFER_STATS)
+/**
+ * @brief 获取统计快照
+ * @param rb 环形缓冲区句柄
+ * @param out 快照输出
+ * @return 返回是否成功
+ * @note  SPSC 模式下不关中断，各字段分别一致，字段之间可能相差一次操作
+ */
+ret_code_t RingBuffer_GetStats(const RingBuffer* rb, RingBufferStats* out) {
+    if (!RingBuffer_IsValid(rb) || out == NULL) return RET_E_INVALID_ARG;
+
+    RB_LOCK(rb);
+    *out = rb->stats;
+    RB_UNLOCK(rb);
     return RET_OK;
 }
 
+/**
+ * @brief 清零统计，高水位从当前已用重新开始
+ * @param rb 环形缓冲区句柄
+ * @return 返回是否成功
+ */
+ret_code_t RingBuffer_ResetStats(RingBuffer* rb) {
+    if (!RingBuffer_IsValid(rb)) return RET_E_INVALID_ARG;
+
+    RB_LOCK(rb);
+    memset(&rb->stats, 0, sizeof(rb->stats));
+    rb->stats.peak = MIN(RingBuffer_GetUsedSize_Internal(rb), rb->size);
+    RB_UNLOCK(rb);
+    return RET_OK;
+}
+
+/**
+ * @brief 按名称查找已登记的实例
+ * @param name 创建时传入的名称
+ * @return 找不到返回 NULL
+ */
+RingBuffer* RingBuffer_Find(const char* name) {
+    if (name == NULL) return NULL;
+
+    RingBuffer* found = NULL;
+    RB_ENTER_CRITICAL();
+    for (RingBuffer* rb = s_rb_list; rb != NULL; rb = rb->next) {
+        if (rb->name != NULL && strcmp(rb->name, name) == 0) {
+            found = rb;
+            break;
+        }
+    }
+    RB_EXIT_CRITICAL();
+    return found;
+}
+
+/**
+ * @brief 按创建顺序遍历所有已登记的实例
+ * @param visitor 回调
+ * @param user 透传给回调的参数
+ * @note  回调在临界区外执行；实例创建后不会被销毁，链表只会在尾部增长
+ */
+void RingBuffer_ForEach(const RingBufferVisitor visitor, void* user) {
+    if (visitor == NULL) return;
+
+    RB_ENTER_CRITICAL();
+    const RingBuffer* rb = s_rb_list;
+    RB_EXIT_CRITICAL();
+    while (rb != NULL) {
+        visitor(rb, user);
+        rb = rb->next;
+    }
+}
+
+/**
+ * @brief 打印单个实例的统计
+ * @param rb 环形缓冲区句柄
+ * @param user 未使用
+ */
+static void RingBuffer_DumpOne(const RingBuffer* rb, void* user) {
+    (void)user;
+    RingBufferStats st;
+    if (ret_is_err(RingBuffer_GetStats(rb, &st))) return;
+
+    printf("%-12s size=%5lu peak=%5lu(%3lu%%) in=%lu out=%lu fail=%lu trunc=%lu evict=%lu "
+           "ovr=%lu\r\n",
+           rb->name ? rb->name : "?", (unsigned long)rb->size, (unsigned long)st.peak,
+           (unsigned long)((uint64_t)st.peak * 100u / rb->size), (unsigned long)st.bytes_in,
+           (unsigned long)st.bytes_out, (unsigned long)st.write_fail, (unsigned long)st.truncated,
+           (unsigned long)rb->evicted, (unsigned long)rb->overruns);
+}
+
+/**
+ * @brief 打印所有已登记实例的统计
+ */
+void RingBuffer_DumpStats(void) {
+    RingBuffer_ForEach(RingBuffer_DumpOne, NULL);
+}
+#endif
+
 #endif
@@ -6,18 +6,70 @@
 #define RINGBUFFER_H
 #include <stdbool.h>
 
+#include "APP_config.h"
 #include "ret_code.h"
 #include "stdint.h"
 #define RING_BUFF_DEF_SIZE 1024  // 单位字节
 #define DEFAULT_ALIGNMENT  4
 
+/* 创建标志（CreateRingBufferEx） */
+#define RB_FLAG_NONE 0u
+/* 单生产者/单消费者无锁模式：不关中断，依靠 acquire/release 顺序的 rear/front 索引 */
+#define RB_FLAG_SPSC (1u << 0)
+/* 覆盖最旧模式（飞行记录仪）：空间不足时在同一临界区内推进 front 丢弃最旧数据，写入永不失败；
+ * 生产者会改写 front，因此不能与 RB_FLAG_SPSC 同时使用 */
+#define RB_FLAG_OVERWRITE (1u << 1)
+/* 阻塞读写：创建读/写两个二值信号量，支持 RingBuffer_ReadWait/WriteWait（需要 OSAL） */
+#define RB_FLAG_WAIT (1u << 2)
+/* 多生产者/单消费者无锁模式：生产者以 CAS 认领空间、写完后提交，最后一个完成的写入方按序发布 rear；
+ * 任务与中断走同一路径，不关中断也不加锁。size 必须为 2 的幂且 <= RB_MPSC_SIZE_MAX */
+#define RB_FLAG_MPSC (1u << 3)
+#define RB_MPSC_SIZE_MAX (1u << 23)
+
+#if defined(ENABLE_RINGBUFFER_STATS)
+/*
+ * 运行统计（ENABLE_RINGBUFFER_STATS 开启时才占用空间和周期）
+ * 生产者侧字段只由生产者更新，bytes_out 只由消费者更新，SPSC 模式下同样无需加锁
+ */
 typedef struct {
+    uint32_t peak;        // 已用字节数的历史最大值（高水位）
+    uint32_t write_fail;  // 空间不足而整体失败的写入次数（含 WriteReserve）
+    uint32_t truncated;   // 强制写入时被截掉、未能写入的字节数
+    uint32_t bytes_in;    // 累计写入字节数（含外部写入方发布的字节）
+    uint32_t bytes_out;   // 累计读出/丢弃的字节数
+} RingBufferStats;
+#endif
+
+/*
+ * 索引为自由运行计数器，容量恰好为 size（不再预留 1 字节区分满/空）：
+ * - size 为 2 的幂：计数器按 2^32 自然回绕，物理偏移 = index & mask
+ * - 其他 size：计数器在 [0, 2*size) 内镜像回绕，物理偏移 = index 或 index - size
+ * 两条路径都只有加减/比较，热路径不做除法。
+ */
+typedef struct RingBuffer {
     const char *name;
-    volatile uint32_t rear_index;   // 表示可以添加数据的头地址
-    volatile uint32_t front_index;  // 表示可以被删除的头地址
-    volatile uint32_t size;         // 缓冲区大小
+    volatile uint32_t rear_index;   // 已写入的累计计数（仅生产者推进）
+    volatile uint32_t front_index;  // 已读出的累计计数（仅消费者推进）
+    volatile uint32_t size;         // 缓冲区大小（即可用容量）
     uint8_t *buffer;                // 缓冲区头地址
+    uint32_t mask;                  // 2 的幂时为 size-1，否则为 0
     bool isPowerOfTwo_Size;
+    bool isSpsc;                    // 索引无锁访问（SPSC，或 MPSC 的消费者侧；创建时确定）
+    bool isMpsc;                    // MPSC 无锁多生产者模式（创建时确定）
+    volatile uint32_t mp_state;     // MPSC：[31:24] 未完成的写入方个数，[23:0] 已认领计数
+    bool isOverwrite;               // 覆盖最旧模式（创建时确定，运行期不可更改）
+    volatile uint32_t evicted;      // 覆盖模式下累计被挤掉的字节数
+    bool isExternal;                // 存储区由调用方提供（可作为 DMA 循环缓冲直接写入）
+    volatile uint32_t overruns;     // 外部写入方覆盖未读数据的次数（生产者推进）
+    uint32_t overruns_seen;         // 消费者已处理的 overruns
+    void *rd_waiter;                // RB_FLAG_WAIT：读等待信号量（否则为 NULL）
+    void *wr_waiter;                // RB_FLAG_WAIT：写等待信号量（否则为 NULL）
+    volatile uint32_t rd_need;      // 读等待阈值：已用 >= rd_need 时唤醒，0 表示无人等待
+    volatile uint32_t wr_need;      // 写等待阈值：空闲 >= wr_need 时唤醒，0 表示无人等待
+#if defined(ENABLE_RINGBUFFER_STATS)
+    RingBufferStats stats;          // 运行统计
+    struct RingBuffer *next;        // 全局登记表链接（创建时挂入）
+#endif
 } RingBuffer;
 
 typedef struct {
@@ -27,8 +79,44 @@ typedef struct {
     uint32_t n2;
 } RingBufferSpan;
 
+/* 分散/聚集段：WriteV 的数据源 */
+typedef struct {
+    const uint8_t *ptr;
+    uint32_t len;
+} RingBufferConstVec;
+
+/* 分散/聚集段：ReadV 的接收区 */
+typedef struct {
+    uint8_t *ptr;
+    uint32_t len;
+} RingBufferVec;
+
 ret_code_t CreateRingBuffer(RingBuffer *rb, const char *name, uint32_t size);
 
+/**
+ * @brief 带创建标志的版本
+ * @note  RB_FLAG_SPSC：只允许一个生产者（写/WriteReserve/WriteCommit）和一个消费者
+ *        （读/Peek/ReadReserve/ReadCommit/Drop/Reset）并发，两侧均不进入临界区；
+ *        任务版与 FromISR 版行为一致。
+ * @note  RB_FLAG_OVERWRITE：Write/WriteV/WriteReserve 空间不足时挤掉最旧的字节（计入 evicted），
+ *        超过 size 的单次写入只保留最后 size 字节；与 RB_FLAG_SPSC 组合返回 RET_E_INVALID_ARG。
+ * @note  RB_FLAG_WAIT：可与其他标志组合；每个方向同一时刻只支持一个阻塞等待者。
+ *        同一句柄重复创建时沿用已有的等待信号量，不再带 RB_FLAG_WAIT 时释放；
+ *        因此句柄首次创建前须为全 0（静态/全局变量天然满足，栈上句柄先清零）。
+ * @note  RB_FLAG_MPSC：Write/WriteV（含 FromISR）可被任意任务和中断并发调用，消费者只有一个；
+ *        所有已认领的写入都完成后数据才对消费者可见。不支持 WriteReserve/WriteCommit 与外部写入方，
+ *        不能与 RB_FLAG_SPSC / RB_FLAG_OVERWRITE 组合。
+ */
+ret_code_t CreateRingBufferEx(RingBuffer *rb, const char *name, uint32_t size, uint32_t flags);
+
+/**
+ * @brief 在调用方提供的存储区上创建（不分配内存）
+ * @note  存储区可以直接作为外设 DMA 循环接收缓冲：外设写数据，中断里只用
+ *        RingBuffer_PublishWritePosFromISR 发布写位置，读侧照常 Read/ReadReserve，省去一次拷贝
+ */
+ret_code_t CreateRingBufferStatic(RingBuffer *rb, const char *name, uint8_t *buffer, uint32_t size,
+                                  uint32_t flags);
+
 uint32_t RingBuffer_GetUsedSize(const RingBuffer *rb);
 
 uint32_t RingBuffer_GetUsedSizeFromISR(const RingBuffer *rb);
@@ -75,10 +163,102 @@ ret_code_t RingBuffer_ReadCommit(RingBuffer *rb, uint32_t commit);
 
 ret_code_t RingBuffer_ReadCommitFromISR(RingBuffer *rb, uint32_t commit);
 
+/*
+ * 分散/聚集 写/读：多个段在同一次临界区内作为一条记录整体写入/读出，索引只发布一次。
+ * 非强制模式下总长不足则整体失败（不写/不读任何字节）；强制模式按段顺序尽量处理。
+ * written/nread 返回实际字节数。
+ */
+ret_code_t RingBuffer_WriteV(RingBuffer *rb, const RingBufferConstVec *vec, uint32_t cnt,
+                             uint32_t *written, bool isForceWrite);
+
+ret_code_t RingBuffer_WriteVFromISR(RingBuffer *rb, const RingBufferConstVec *vec, uint32_t cnt,
+                                    uint32_t *written, bool isForceWrite);
+
+ret_code_t RingBuffer_ReadV(RingBuffer *rb, const RingBufferVec *vec, uint32_t cnt,
+                            uint32_t *nread, bool isForceRead);
+
+ret_code_t RingBuffer_ReadVFromISR(RingBuffer *rb, const RingBufferVec *vec, uint32_t cnt,
+                                   uint32_t *nread, bool isForceRead);
+
+/*
+ * 外部写入方（DMA 直写存储区）
+ * PublishWritePos：pos 为外设下一次要写的物理偏移，推进 rear 并返回增量；覆盖未读数据时返回
+ *   RET_E_DATA_OVERFLOW 并计数。PublishRestart：外设从偏移 0 重新开始（出错重启）。
+ * CheckOverrun：消费者发现计数变化后丢弃全部积压并重新同步，返回 true
+ */
+ret_code_t RingBuffer_PublishWritePos(RingBuffer *rb, uint32_t pos, uint32_t *delta);
+
+ret_code_t RingBuffer_PublishWritePosFromISR(RingBuffer *rb, uint32_t pos, uint32_t *delta);
+
+ret_code_t RingBuffer_PublishRestart(RingBuffer *rb);
+
+ret_code_t RingBuffer_PublishRestartFromISR(RingBuffer *rb);
+
+bool RingBuffer_CheckOverrun(RingBuffer *rb);
+
+/*
+ * 阻塞读/写（仅任务上下文，需 RB_FLAG_WAIT 创建，否则返回 RET_E_UNSUPPORTED）
+ * ReadWait：阻塞到已用 >= min 后读出最多 *size 字节，*size 返回实际读出数
+ * WriteWait：阻塞到空闲 >= *size 后整体写入（覆盖模式直接写入）
+ * 等待期间不轮询，由对端的写/读（含 FromISR、零拷贝提交）在满足阈值时唤醒；
+ * 超时返回 RET_E_TIMEOUT 且不读/写任何字节，timeout_ms 可为 0 或 OSAL_WAIT_FOREVER
+ */
+ret_code_t RingBuffer_ReadWait(RingBuffer *rb, uint8_t *add, uint32_t *size, uint32_t min,
+                               uint32_t timeout_ms);
+
+ret_code_t RingBuffer_WriteWait(RingBuffer *rb, const uint8_t *add, uint32_t *size,
+                                uint32_t timeout_ms);
+
+/*
+ * 分隔符查找（消费者侧）：从 front 之后第 from 字节开始，在已用区域内（跨回绕）查找
+ * offset 返回命中位置相对 front 的偏移；未找到返回 RET_E_NOT_FOUND。
+ * 按 32 位字批量比较（SWAR），FindAny 的集合最多 RB_FIND_SET_MAX 个字节。
+ */
+#define RB_FIND_SET_MAX 4u
+
+ret_code_t RingBuffer_FindByte(const RingBuffer *rb, uint8_t byte, uint32_t from,
+                               uint32_t *offset);
+
+ret_code_t RingBuffer_FindByteFromISR(const RingBuffer *rb, uint8_t byte, uint32_t from,
+                                      uint32_t *offset);
+
+ret_code_t RingBuffer_FindAny(const RingBuffer *rb, const uint8_t *set, uint32_t set_len,
+                              uint32_t from, uint32_t *offset);
+
+ret_code_t RingBuffer_FindAnyFromISR(const RingBuffer *rb, const uint8_t *set, uint32_t set_len,
+                                     uint32_t from, uint32_t *offset);
+
+/* 覆盖模式下累计被挤掉的字节数 */
+uint32_t RingBuffer_GetEvicted(const RingBuffer *rb);
+
 /* 丢掉N字节 */
 ret_code_t RingBuffer_Drop(RingBuffer *rb, uint32_t drop, uint32_t *dropped, bool isCompatible);
 
 ret_code_t RingBuffer_DropFromISR(RingBuffer *rb, uint32_t drop, uint32_t *dropped,
                                   bool isCompatible);
 
+#if defined(ENABLE_RINGBUFFER_STATS)
+/*
+ * 运行统计与全局登记表：创建成功的实例按创建顺序挂入登记表，可按名称查找或遍历，
+ * 用现场数据确定各缓冲区大小（高水位远小于 size 说明可以回收 RAM，write_fail/truncated
+ * 非零说明偏小）。同一句柄重复创建不会重复登记。
+ */
+typedef void (*RingBufferVisitor)(const RingBuffer *rb, void *user);
+
+/* 取统计快照（任务上下文） */
+ret_code_t RingBuffer_GetStats(const RingBuffer *rb, RingBufferStats *out);
+
+/* 清零统计，高水位从当前已用重新开始 */
+ret_code_t RingBuffer_ResetStats(RingBuffer *rb);
+
+/* 按名称查找已登记的实例，找不到返回 NULL */
+RingBuffer *RingBuffer_Find(const char *name);
+
+/* 按创建顺序遍历所有已登记的实例 */
+void RingBuffer_ForEach(RingBufferVisitor visitor, void *user);
+
+/* 打印所有实例的统计（printf） */
+void RingBuffer_DumpStats(void);
+#endif
+
 #endif  // RINGBUFFER_H
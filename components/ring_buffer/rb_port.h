@@ -17,6 +17,17 @@ typedef osal_crit_state_t rb_isr_state_t;
 #define RB_ENTER_CRITICAL_FROM_ISR(s)     OSAL_enter_critical_from_isr(&(s))
 #define RB_EXIT_CRITICAL_FROM_ISR(s)      OSAL_exit_critical_from_isr((s))
 
+/* 阻塞读写（RB_FLAG_WAIT）：等待者挂在二值信号量上，由对端在满足阈值时唤醒 */
+#define RB_WAIT_SUPPORTED                 1
+#define RB_WAIT_FOREVER                   OSAL_WAIT_FOREVER
+#define RB_SEM_CREATE(p, name)            OSAL_sem_create((p), (name), 0, 1)
+#define RB_SEM_DELETE(s)                  OSAL_sem_delete((s))
+#define RB_SEM_TAKE(s, ms)                OSAL_sem_take((s), (ms))
+#define RB_SEM_GIVE(s)                    OSAL_sem_give((s))
+#define RB_SEM_GIVE_FROM_ISR(s)           OSAL_sem_give_from_isr((s))
+#define RB_TICK_NOW()                     OSAL_tick_get()
+#define RB_TICK_TO_MS(t)                  OSAL_tick_to_ms((t))
+
 #else  /* 纯裸机：PRIMASK 方案（不依赖 OSAL） */
 
 #include "cmsis_gcc.h"   /* __get_PRIMASK/__set_PRIMASK */
@@ -42,6 +53,55 @@ static inline void rb_primask_restore(uint32_t s) {
 #define RB_ENTER_CRITICAL()               do { __disable_irq(); __DMB(); } while (0)
 #define RB_EXIT_CRITICAL()                do { __DMB(); __enable_irq(); } while (0)
 
+/* 裸机没有可阻塞的等待对象，RB_FLAG_WAIT 不可用 */
+#define RB_WAIT_SUPPORTED                 0
+
+#endif
+
+/* SPSC 无锁模式的索引访问：
+ * - 生产者：先写数据，再以 release 语义发布 rear_index
+ * - 消费者：以 acquire 语义读取 rear_index 后再读数据，读完以 release 语义发布 front_index
+ * Cortex-M 上对齐的 32 位读写天然原子，这里只需保证编译器/总线顺序（GCC 生成 DMB）。
+ * RB_FENCE：阻塞等待时“登记阈值”与“发布索引”之间的全屏障（store->load），避免双方互相看不到而丢唤醒。
+ * RB_CAS：MPSC 模式的无锁认领/提交（Cortex-M3/M4 上为 LDREX/STREX），失败时把当前值写回 *e。
+ */
+#if defined(__GNUC__) || defined(__clang__)
+#define RB_LOAD_ACQUIRE(p)     __atomic_load_n((p), __ATOMIC_ACQUIRE)
+#define RB_STORE_RELEASE(p, v) __atomic_store_n((p), (v), __ATOMIC_RELEASE)
+#define RB_FENCE()             __atomic_thread_fence(__ATOMIC_SEQ_CST)
+#define RB_CAS(p, e, v) \
+    __atomic_compare_exchange_n((p), (e), (v), true, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)
+#else
+#include "cmsis_compiler.h" /* __DMB */
+
+static inline uint32_t rb_load_acquire(const volatile uint32_t *p) {
+    const uint32_t v = *p;
+    __DMB();
+    return v;
+}
+
+static inline void rb_store_release(volatile uint32_t *p, uint32_t v) {
+    __DMB();
+    *p = v;
+}
+
+static inline bool rb_cas(volatile uint32_t *p, uint32_t *e, uint32_t v) {
+    const uint32_t cur = __LDREXW(p);
+    if (cur != *e) {
+        __CLREX();
+        *e = cur;
+        return false;
+    }
+    __DMB();
+    if (__STREXW(v, p) != 0u) return false; /* 被打断：*e 仍是旧值，调用方重试 */
+    __DMB();
+    return true;
+}
+
+#define RB_LOAD_ACQUIRE(p)     rb_load_acquire((p))
+#define RB_STORE_RELEASE(p, v) rb_store_release((p), (v))
+#define RB_FENCE()             __DMB()
+#define RB_CAS(p, e, v)        rb_cas((p), (e), (v))
 #endif
 
 #endif /* SMARTLOCK_RB_PORT_H */
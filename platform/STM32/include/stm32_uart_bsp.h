@@ -18,7 +18,7 @@ typedef struct {
     IRQn_Type dma_tx_irq;        // DMA TX IRQ（可选）
     uint8_t* rx_dma_buf;         // DMA 环形缓冲
     uint32_t rx_dma_len;         // 环形缓冲长度 必须为2的幂 否则出错
-    uint32_t sw_rb_len;          // 软件 RB 长度 默认1024
+    uint32_t sw_rb_len;          // 软件 RB 长度 默认1024；0 = 零拷贝（DMA 缓冲即 RB 存储区）
     uint32_t irq_prio;           // NVIC 优先级
 } stm32_uart_bsp_t;
 
@@ -5,6 +5,7 @@
 #include <stdbool.h>
 #include <stdint.h>
 
+#include "hal_time.h"
 #include "log.h"
 #include "osal.h"
 #include "stm32f4xx.h"
@@ -16,13 +17,23 @@ static bool dwt_inited      = false;
 static bool dwt_available   = false;
 /* 只打印一次失败信息 */
 static bool dwt_fail_logged = false;
+
+/* 超过该间隔没有调用时 CYCCNT 可能已回绕 (168MHz 下约 25.5 s)，改按毫秒计数重新对齐 */
+#define HAL_TIME_US_RESYNC_MS 10000U
+/* us 累加状态：DWT 周期差折算成 us 累加，返回值按 2^32 us 回绕（约 71.6 分钟） */
+static uint32_t us_acc;
+static uint32_t us_rem_cyc;
+static uint32_t us_last_cyc;
+static uint32_t us_last_ms;
+
 /**
  * 初始化 DWT寄存器
  */
 static void dwt_init_once(void) {
     // DWT初始化
     BIT_SET(CoreDebug->DEMCR, 24);  // 使能DWT外设
-    DWT->CYCCNT = 0;
+    /* 起点与毫秒计数对齐：初始化前后 hal_get_cycles() 的读数连续 */
+    DWT->CYCCNT = hal_get_tick_ms() * (SystemCoreClock / 1000U);
     BIT_SET(DWT->CTRL, 0);
     __DSB();
     __ISB();
@@ -37,20 +48,13 @@ uint32_t hal_get_tick_ms(void) {
 }
 
 /**
- * @note 可以回绕 上层应该做好检查（无符号处理）
- * @return 返回当前以 us 为单位的时间
+ * @brief 按需初始化 DWT 并返回是否可用
+ * @return DWT 周期计数可用返回 true
+ * @note  初始化之后只读两个标志；ISR 中不做初始化，避免拉长中断
  */
-uint32_t hal_get_tick_us32(void) {
-    /* 判断系统主频是否正常 */
-    if (SystemCoreClock == 0U) {
-        return hal_get_tick_ms() * 1000U;
-    }
-
-    /* ISR 不做初始化，避免拉长中断 */
+static bool dwt_ready(void) {
     if (!dwt_inited) {
-        if (OSAL_in_isr()) {
-            return hal_get_tick_ms() * 1000U;
-        }
+        if (OSAL_in_isr()) return false;
 
         /* 用可恢复临界区保护一次性初始化 */
         osal_crit_state_t s;
@@ -75,27 +79,81 @@ uint32_t hal_get_tick_us32(void) {
             } else {
                 dwt_available = false;
             }
+            /* 累加起点与毫秒计数对齐 */
+            us_last_ms  = hal_get_tick_ms();
+            us_acc      = us_last_ms * 1000U;
+            us_rem_cyc  = 0;
+            us_last_cyc = DWT->CYCCNT;
 
             dwt_inited = true;
             __DMB(); /* 写入 flags 后的可见性/顺序 */
         }
         OSAL_exit_critical_ex(s);
     }
-    /* 运行失败退化为 hal _get_tick_ms() *1000 */
+    /* 运行失败退化为毫秒计数 */
     if (dwt_available == false) {
         if (!dwt_fail_logged) {
             dwt_fail_logged = true;
-            LOG_E("DWT", "DWT启动失败，降级到 HAL_GetTick()*1000");
+            LOG_E(TIME, "DWT启动失败，降级到 HAL_GetTick()");
         }
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @note 按 2^32 us 回绕，上层应该做好检查（无符号处理）
+ * @return 返回当前以 us 为单位的时间
+ */
+uint32_t hal_get_tick_us32(void) {
+    /* 判断系统主频是否正常 */
+    if (SystemCoreClock == 0U) {
         return hal_get_tick_ms() * 1000U;
     }
-    /* DWT 启动成功才采用该值 */
+    /* DWT 启动成功才采用该值，失败退化为 hal_get_tick_ms() *1000 */
+    if (!dwt_ready()) return hal_get_tick_ms() * 1000U;
     const uint32_t cycles_per_us = SystemCoreClock / 1000000U;
     if (cycles_per_us == 0U) return hal_get_tick_ms() * 1000U;
-    const uint32_t us = (uint32_t)DWT->CYCCNT / cycles_per_us;
+
+    /* 任务与中断都会调用：累加状态在临界区内更新（只有几条指令）；
+     * 高频路径（如日志时间戳）应改用 hal_get_cycles() */
+    osal_crit_state_t s;
+    OSAL_enter_critical_ex(&s);
+    const uint32_t ms  = hal_get_tick_ms();
+    const uint32_t cyc = DWT->CYCCNT;
+    if (ms - us_last_ms > HAL_TIME_US_RESYNC_MS) {
+        /* 间隔太长，周期差不可信：退回毫秒精度对齐，且不倒退 */
+        const uint32_t base = ms * 1000U;
+        if (HAL_TIME_AFTER_EQ(base, us_acc)) us_acc = base;
+        us_rem_cyc = 0;
+    } else {
+        const uint32_t d = cyc - us_last_cyc + us_rem_cyc;
+        us_rem_cyc       = d % cycles_per_us;
+        us_acc += d / cycles_per_us;
+    }
+    us_last_cyc       = cyc;
+    us_last_ms        = ms;
+    const uint32_t us = us_acc;
+    OSAL_exit_critical_ex(s);
     return us;
 }
 
+/**
+ * @return CPU 周期计数（按 2^32 回绕），DWT 不可用时为毫秒计数 * 每毫秒周期数
+ * @note 不进临界区，ISR 和任务中均可调用
+ */
+uint32_t hal_get_cycles(void) {
+    if (SystemCoreClock != 0U && dwt_ready()) return DWT->CYCCNT;
+    return hal_get_tick_ms() * (hal_get_cycles_hz() / 1000U);
+}
+
+/**
+ * @return hal_get_cycles() 的计数频率 (Hz)
+ */
+uint32_t hal_get_cycles_hz(void) {
+    return (SystemCoreClock != 0U) ? SystemCoreClock : 1000000U;
+}
+
 #else
 #include <stdint.h>
 
@@ -107,6 +165,14 @@ uint32_t hal_get_tick_us32(void) {
     return 0U;
 }
 
+uint32_t hal_get_cycles(void) {
+    return 0U;
+}
+
+uint32_t hal_get_cycles_hz(void) {
+    return 1000000U;
+}
+
 void hal_time_delay_ms(uint32_t ms) {
     (void)ms;
 }
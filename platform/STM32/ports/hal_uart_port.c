@@ -21,7 +21,7 @@ struct hal_uart {
     void* cb_user;            /* 用户上下文 */
     hal_uart_id_t id;         /*串口内部id*/
     stm32_uart_bsp_t bsp;     /* 串口映射配置 */
-    RingBuffer rb;            /* 软件 RB：用于上层 read */
+    RingBuffer rb;            /* 软件 RB：用于上层 read（零拷贝模式下存储区即 DMA 缓冲） */
     uint32_t rx_last_pos;     /* 上次处理的 DMA 写指针 */
     volatile uint8_t tx_busy; /* 0/1 */
     uint32_t last_tx_len;     /* 上次DMA的位置 */
@@ -84,6 +84,32 @@ static inline uint32_t dma_pos(const hal_uart_t* u) {
     return pos;
 }
 
+/**
+ * @brief 零拷贝模式：DMA 直接写入 RB 存储区，中断里只发布 DMA 写位置
+ * @param u 串口句柄
+ * @param pos DMA 当前写位置
+ * @note 覆盖未读数据时发 ERROR(overflow)，读侧在 hal_uart_port_read 中重同步
+ */
+static void rx_publish_pos(hal_uart_t* u, const uint32_t pos) {
+    /* cache invalidate：H7/F7 可覆盖 */
+    stm32_uart_dma_rx_invalidate(u->bsp.rx_dma_buf, u->bsp.rx_dma_len);
+
+    uint32_t delta      = 0;
+    const ret_code_t rc = RingBuffer_PublishWritePosFromISR(&u->rb, pos, &delta);
+    u->rx_last_pos      = pos;
+
+    if (delta > 0u) {
+        hal_uart_event_t evt = {.type = HAL_UART_EVT_RX};
+        evt.rx.bytes         = delta;
+        emit_evt(u, &evt);
+    }
+    if (ret_is_errno(rc, RET_ERRNO_DATA_OVERFLOW)) {
+        hal_uart_event_t e = {.type = HAL_UART_EVT_ERROR};
+        e.err.flags        = (uint32_t)RET_ERRNO_DATA_OVERFLOW;
+        emit_evt(u, &e);
+    }
+}
+
 /**
  *
  * @param u 串口句柄
@@ -102,6 +128,12 @@ static void rx_commit_delta(hal_uart_t* u) {
     const uint32_t last = u->rx_last_pos;
     if (pos == last) return;
 
+    /* 零拷贝模式：不搬运数据 */
+    if (u->rb.isExternal) {
+        rx_publish_pos(u, pos);
+        return;
+    }
+
     /* 计算出 当前新的位置 距离上次的位置的 长度  无论是否回环*/
     const uint32_t delta = (pos + len - last) & (len - 1);
     if (delta == 0u) return;
@@ -109,65 +141,27 @@ static void rx_commit_delta(hal_uart_t* u) {
     /* cache invalidate：H7/F7 可覆盖 */
     stm32_uart_dma_rx_invalidate(u->bsp.rx_dma_buf, u->bsp.rx_dma_len);
 
-    /* 先看空间 */
-    const uint32_t remain = RingBuffer_GetRemainSizeFromISR(&u->rb);
-
-    /* 严格模式 */
-    if (!u->isCompatible) {
-        /* 严格：空间不足 -> 全丢 */
-        if (remain < delta) {
-            u->rx_last_pos     = pos;                               /* 更新上次坐标为新的坐标 */
-            hal_uart_event_t e = {.type = HAL_UART_EVT_ERROR};      /* 返回事件类型 错误 + 原因 */
-            e.err.flags        = (uint32_t)RET_ERRNO_DATA_OVERFLOW; /* 错误类型 ：数据溢出*/
-            emit_evt(u, &e);                                        /* 执行事件回调函数 */
-            return;
-        }
-        /* 空间足够，完整写入 */
-        /* 分段写入 判断是否回环*/
-        const uint32_t first = (last + delta <= len) ? delta : (len - last);
-
-        uint32_t w           = first;
-        (void)WriteRingBufferFromISR(&u->rb, &u->bsp.rx_dma_buf[last], &w, 0);
-
-        /* 回环了写入第二段 */
-        if (first < delta) {
-            const uint32_t second = delta - first;
-            uint32_t w2           = second;
-            (void)WriteRingBufferFromISR(&u->rb, &u->bsp.rx_dma_buf[0], &w2,
-                                         /*isForceWrite=*/0);
-        }
-        u->rx_last_pos       = pos;                       /* 更新上次的位置 */
-        hal_uart_event_t evt = {.type = HAL_UART_EVT_RX}; /* 返回事件类型 有接收到新的数据 */
-        evt.rx.bytes         = delta;                     /* 增量长度 */
-        emit_evt(u, &evt);                                /* 执行事件回调函数 */
-        return;
-    }
-
-    /* 兼容模式: 尽力写，丢弃多余 */
-    /* 取容量 和 需要写入的大小  中的较小值 */
-    const uint32_t to_write = (remain < delta) ? remain : delta;
-    /* 计算丢弃了多少字节 */
-    const uint32_t dropped  = delta - to_write;
-
-    if (to_write > 0u) {
-        /* 计算没有回环的第一段 大小 */
-        const uint32_t first_need = (last + to_write <= len) ? to_write : (len - last);
-
-        uint32_t w                = first_need;
-        (void)WriteRingBufferFromISR(&u->rb, &u->bsp.rx_dma_buf[last], &w, 1);
-        /* 判断是否回环 回环就写余下的部分 */
-        if (first_need < to_write) {
-            const uint32_t second_need = to_write - first_need;
-            uint32_t w2                = second_need;
-            (void)WriteRingBufferFromISR(&u->rb, &u->bsp.rx_dma_buf[0], &w2, 1);
-        }
+    /* DMA 区域的两段（回环时第二段从头开始）作为一条记录一次性写入 */
+    const uint32_t first         = (last + delta <= len) ? delta : (len - last);
+    const RingBufferConstVec v[] = {
+        {.ptr = &u->bsp.rx_dma_buf[last], .len = first},
+        {.ptr = &u->bsp.rx_dma_buf[0], .len = delta - first},
+    };
+    uint32_t written = 0;
+
+    /* 严格：空间不足 -> 全丢；兼容：尽力写，丢弃多余 */
+    const ret_code_t rc =
+        RingBuffer_WriteVFromISR(&u->rb, v, (first < delta) ? 2u : 1u, &written, u->isCompatible);
+    u->rx_last_pos = pos; /* 更新上次的位置 */
 
+    if (ret_is_ok(rc) && written > 0u) {
         hal_uart_event_t evt = {.type = HAL_UART_EVT_RX}; /* 返回事件类型 有接收到新的数据 */
-        evt.rx.bytes         = to_write;                  /* 增量长度 */
+        evt.rx.bytes         = written;                   /* 增量长度 */
         emit_evt(u, &evt);                                /* 执行事件回调函数 */
     }
 
-    u->rx_last_pos = pos; /* 更新上次的位置 */
+    /* 计算丢弃了多少字节 */
+    const uint32_t dropped = delta - written;
 
     /* 当丢弃了数据 返回错误 */
     if (dropped > 0u) {
@@ -300,7 +294,7 @@ ret_code_t hal_uart_port_open(hal_uart_id_t id, const hal_uart_cfg_t* cfg, hal_u
 
     /* 参数检查传输的 指针是否有效, DMA长度是否是2的幂次大小 */
     if (!u->bsp.huart || !u->bsp.hdma_rx || !u->bsp.hdma_tx || !u->bsp.rx_dma_buf ||
-        u->bsp.rx_dma_len < 2u || !isPowerOfTwo_Size(u->bsp.rx_dma_len) || u->bsp.sw_rb_len < 2u) {
+        u->bsp.rx_dma_len < 2u || !isPowerOfTwo_Size(u->bsp.rx_dma_len) || u->bsp.sw_rb_len == 1u) {
         return UART_RET(RET_ERRNO_INVALID_ARG);
     }
 
@@ -308,7 +302,14 @@ ret_code_t hal_uart_port_open(hal_uart_id_t id, const hal_uart_cfg_t* cfg, hal_u
     u->isCompatible = (cfg ? cfg->isCompatible : false);
     char name[32]   = {0};
     sprintf(name, "stm32_port_uart_RB%d", id);
-    rc = CreateRingBuffer(&u->rb, name, u->bsp.sw_rb_len);
+    /* 生产者只有 DMA/IDLE 中断，消费者只有 hal_uart_port_read：SPSC 无锁 */
+    if (u->bsp.sw_rb_len == 0u) {
+        /* 零拷贝：DMA 循环缓冲本身就是 RB 存储区，省去中断里的拷贝和一份软件 RB 内存 */
+        rc = CreateRingBufferStatic(&u->rb, name, u->bsp.rx_dma_buf, u->bsp.rx_dma_len,
+                                    RB_FLAG_SPSC);
+    } else {
+        rc = CreateRingBufferEx(&u->rb, name, u->bsp.sw_rb_len, RB_FLAG_SPSC);
+    }
     if (ret_is_err(rc)) return rc;
 
     /* 串口参数配置 */
@@ -382,6 +383,12 @@ ret_code_t hal_uart_port_rx_start(hal_uart_t* h) {
     if (!h) return UART_RET(RET_ERRNO_INVALID_ARG);
     hal_uart_t* u = (hal_uart_t*)h;
 
+    /* 零拷贝模式：DMA 将从偏移 0 重新开始，先把 RB 写位置跳到下一圈起点 */
+    if (u->rb.isExternal && u->rx_last_pos != 0u) {
+        (void)RingBuffer_PublishRestart(&u->rb);
+        u->rx_last_pos = 0;
+    }
+
 #if defined(USE_HAL_UARTEx_ReceiveToIdle_DMA)
     /* DMA + IDLE 方式接收方式 */
     if (HAL_UARTEx_ReceiveToIdle_DMA(u->bsp.huart, u->bsp.rx_dma_buf,
@@ -446,6 +453,12 @@ ret_code_t hal_uart_port_read(hal_uart_t* h, uint8_t* out, uint32_t want, uint32
     if (!h || !out || want == 0u || !nread) return UART_RET(RET_ERRNO_INVALID_ARG);
     hal_uart_t* u       = (hal_uart_t*)h;
 
+    /* 零拷贝模式：DMA 覆盖过未读数据则积压已不可信，丢弃后报告溢出 */
+    if (u->rb.isExternal && RingBuffer_CheckOverrun(&u->rb)) {
+        *nread = 0;
+        return UART_RET(RET_ERRNO_DATA_OVERFLOW);
+    }
+
     uint32_t size       = want;
     const ret_code_t rc = ReadRingBuffer(&u->rb, out, &size, u->isCompatible ? 1 : 0);
 
@@ -0,0 +1,299 @@
+#!/usr/bin/env python3
+"""Decode tokenized log output (LOG_TOKENIZED_ENABLE) back into readable lines.
+
+The dictionary is read from the `.log_dict` section of the firmware ELF of the
+same build; the log ID of a call site is the address of its entry there.
+
+Wire format (see components/log/log.h):
+    0xFF | payload length | varint(ID) | varint(timestamp) | args...
+    ints: zigzag varint, floats: float32 little endian, strings: varint(len) + bytes
+The timestamp is microseconds since boot, wrapping at 2^32; it is extended to
+64 bits in arrival order and printed with the gap to the previous frame.
+Bytes outside frames (hexdump, printf before the scheduler starts) are passed
+through unchanged; 0xFF never appears in UTF-8 text.
+
+Usage:
+    log_decode.py build/SmartLock.elf capture.bin
+    log_decode.py build/SmartLock.elf --serial COM5 --baud 115200
+    log_decode.py build/SmartLock.elf --dump-dict dict.tsv
+"""
+
+import argparse
+import re
+import struct
+import sys
+
+SYNC = 0xFF
+SEP = "\x1f"
+DICT_SECTION = ".log_dict"
+
+COLORS = {"E": "\033[31m", "W": "\033[33m", "I": "\033[32m", "D": "\033[34m"}
+RESET = "\033[0m"
+
+SPEC_RE = re.compile(
+    r"%(?P<flags>[-+ #0]*)(?P<width>\*|\d+)?(?:\.(?P<prec>\*|\d*))?"
+    r"(?P<len>hh|h|ll|l|j|z|t|L|q)?(?P<conv>[diouxXcsfFeEgGaApn%])"
+)
+
+
+class Entry:
+    def __init__(self, level, tag, file, line, fmt):
+        self.level = level
+        self.tag = tag
+        self.file = file.replace("\\", "/").rsplit("/", 1)[-1]
+        self.line = line
+        self.fmt = fmt
+
+
+def load_dict_from_elf(path):
+    """Return {id: Entry} from the .log_dict section (ELF32/ELF64, little endian)."""
+    with open(path, "rb") as f:
+        data = f.read()
+    if data[:4] != b"\x7fELF":
+        raise ValueError(f"{path}: not an ELF file")
+    is64 = data[4] == 2
+    if data[5] != 1:
+        raise ValueError(f"{path}: big-endian ELF is not supported")
+
+    if is64:
+        shoff, = struct.unpack_from("<Q", data, 0x28)
+        shentsize, shnum, shstrndx = struct.unpack_from("<HHH", data, 0x3A)
+        sh_fmt = "<IIQQQQIIQQ"
+    else:
+        shoff, = struct.unpack_from("<I", data, 0x20)
+        shentsize, shnum, shstrndx = struct.unpack_from("<HHH", data, 0x2E)
+        sh_fmt = "<IIIIIIIIII"
+
+    sections = [struct.unpack_from(sh_fmt, data, shoff + i * shentsize) for i in range(shnum)]
+    strtab = sections[shstrndx]
+    str_off = strtab[4]
+
+    def name_of(sh):
+        start = str_off + sh[0]
+        return data[start:data.index(b"\0", start)].decode()
+
+    for sh in sections:
+        if name_of(sh) == DICT_SECTION:
+            addr, offset, size = sh[3], sh[4], sh[5]
+            return parse_dict_blob(data[offset:offset + size], addr)
+    raise ValueError(f"{path}: no {DICT_SECTION} section (built with LOG_TOKENIZED_ENABLE=0?)")
+
+
+def parse_dict_blob(blob, base):
+    entries = {}
+    i = 0
+    while i < len(blob):
+        if blob[i] == 0:
+            i += 1
+            continue
+        end = blob.index(b"\0", i)
+        fields = blob[i:end].decode("utf-8", "replace").split(SEP, 4)
+        if len(fields) == 5:
+            entries[base + i] = Entry(*fields)
+        i = end + 1
+    return entries
+
+
+def load_dict_from_tsv(path):
+    entries = {}
+    with open(path, encoding="utf-8") as f:
+        for row in f:
+            ident, rest = row.rstrip("\n").split("\t", 1)
+            fields = rest.split("\t", 4)
+            fmt = fields[4].encode().decode("unicode_escape").encode("latin-1").decode("utf-8")
+            entries[int(ident, 0)] = Entry(*fields[:4], fmt)
+    return entries
+
+
+def dump_dict(entries, path):
+    with open(path, "w", encoding="utf-8") as f:
+        for ident in sorted(entries):
+            e = entries[ident]
+            fmt = e.fmt.encode("utf-8").decode("latin-1").encode("unicode_escape").decode()
+            f.write(f"0x{ident:x}\t{e.level}\t{e.tag}\t{e.file}\t{e.line}\t{fmt}\n")
+
+
+class Reader:
+    def __init__(self, payload):
+        self.buf = payload
+        self.pos = 0
+
+    def varint(self):
+        value = shift = 0
+        while True:
+            if self.pos >= len(self.buf):
+                raise EOFError
+            b = self.buf[self.pos]
+            self.pos += 1
+            value |= (b & 0x7F) << shift
+            shift += 7
+            if b < 0x80:
+                return value
+
+    def zigzag(self):
+        v = self.varint()
+        return (v >> 1) ^ -(v & 1)
+
+    def float32(self):
+        if self.pos + 4 > len(self.buf):
+            raise EOFError
+        v, = struct.unpack_from("<f", self.buf, self.pos)
+        self.pos += 4
+        return v
+
+    def string(self):
+        n = self.varint()
+        if self.pos + n > len(self.buf):
+            raise EOFError
+        s = self.buf[self.pos:self.pos + n].decode("utf-8", "replace")
+        self.pos += n
+        return s
+
+
+def render(fmt, rd):
+    """Format fmt with the arguments encoded in rd, one conversion at a time."""
+    out = []
+    last = 0
+    dry = False
+    for m in SPEC_RE.finditer(fmt):
+        out.append(fmt[last:m.start()])
+        last = m.end()
+        conv = m.group("conv")
+        if conv == "%":
+            out.append("%")
+            continue
+        if dry:
+            out.append("?")
+            continue
+        try:
+            width, prec = m.group("width"), m.group("prec")
+            if width == "*":
+                width = str(rd.zigzag())
+            if prec == "*":
+                p = rd.zigzag()
+                prec = None if p < 0 else str(p)
+            spec = "%" + m.group("flags") + (width or "") + ("" if prec is None else "." + prec)
+            wide = m.group("len") in ("ll", "j", "q")
+            mask = (1 << 64) - 1 if wide else (1 << 32) - 1
+
+            if conv in "di":
+                out.append((spec + "d") % rd.zigzag())
+            elif conv in "ouxX":
+                out.append((spec + ("d" if conv == "u" else conv)) % (rd.zigzag() & mask))
+            elif conv == "c":
+                out.append((spec + "c") % chr(rd.zigzag() & 0xFF))
+            elif conv == "s":
+                out.append((spec + "s") % rd.string())
+            elif conv == "p":
+                out.append((spec + "s") % ("0x%x" % (rd.zigzag() & mask)))
+            elif conv == "n":
+                rd.zigzag()
+            else:
+                out.append((spec + ("e" if conv in "aA" else conv)) % rd.float32())
+        except EOFError:
+            dry = True
+            out.append("?")
+    out.append(fmt[last:])
+    return "".join(out)
+
+
+class Clock:
+    """Extend 32-bit microsecond stamps to 64 bits, like LogTask does on the target."""
+
+    def __init__(self):
+        self.base = 0
+        self.prev = 0
+
+    def stamp(self, us32):
+        d = (us32 - self.base) & 0xFFFFFFFF
+        if d >= 0x80000000:
+            t = max(self.base - (0x100000000 - d), 0)
+        else:
+            self.base += d
+            t = self.base
+        gap, self.prev = t - self.prev, t
+        return f"{t // 1000000}.{t % 1000000:06d} {gap:+d}"
+
+
+def decode_frame(payload, entries, color, clock):
+    rd = Reader(payload)
+    try:
+        ident = rd.varint()
+        ts = clock.stamp(rd.varint())
+    except EOFError:
+        return f"<short frame {payload.hex()}>\r\n"
+    e = entries.get(ident)
+    if e is None:
+        return f"<unknown id 0x{ident:x} [{ts}] {payload[rd.pos:].hex()}>\r\n"
+    head = COLORS.get(e.level, "") if color else ""
+    tail = RESET if color else ""
+    return f"{head}[{ts}] {e.level}/{e.tag} {e.file}:{e.line}: {render(e.fmt, rd)}{tail}\r\n"
+
+
+def decode_stream(chunks, entries, write, color=True):
+    """Pass text through and replace frames with decoded lines."""
+    buf = bytearray()
+    clock = Clock()
+    for chunk in chunks:
+        buf += chunk
+        while buf:
+            sync = buf.find(SYNC)
+            if sync < 0:
+                write(bytes(buf))
+                buf.clear()
+                break
+            if sync > 0:
+                write(bytes(buf[:sync]))
+                del buf[:sync]
+            if len(buf) < 2 or len(buf) < 2 + buf[1]:
+                break
+            n = buf[1]
+            write(decode_frame(bytes(buf[2:2 + n]), entries, color, clock).encode("utf-8"))
+            del buf[:2 + n]
+    if buf:
+        write(bytes(buf))
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawTextHelpFormatter)
+    ap.add_argument("elf", help="firmware ELF of the same build (or a .tsv from --dump-dict)")
+    ap.add_argument("input", nargs="?", default="-", help="captured log bytes, '-' for stdin")
+    ap.add_argument("--serial", help="read from a serial port instead (needs pyserial)")
+    ap.add_argument("--baud", type=int, default=115200)
+    ap.add_argument("--no-color", action="store_true", help="strip ANSI colors")
+    ap.add_argument("--dump-dict", metavar="TSV", help="write the dictionary and exit")
+    args = ap.parse_args()
+
+    if args.elf.endswith(".tsv"):
+        entries = load_dict_from_tsv(args.elf)
+    else:
+        entries = load_dict_from_elf(args.elf)
+
+    if args.dump_dict:
+        dump_dict(entries, args.dump_dict)
+        print(f"{len(entries)} entries -> {args.dump_dict}")
+        return
+
+    out = sys.stdout.buffer
+
+    def write(b):
+        out.write(b)
+        out.flush()
+
+    if args.serial:
+        import serial  # pyserial
+
+        port = serial.Serial(args.serial, args.baud, timeout=0.1)
+        chunks = iter(lambda: port.read(256), None)
+    else:
+        src = sys.stdin.buffer if args.input == "-" else open(args.input, "rb")
+        chunks = iter(lambda: src.read1(4096) if hasattr(src, "read1") else src.read(4096), b"")
+
+    try:
+        decode_stream(chunks, entries, write, color=not args.no_color)
+    except KeyboardInterrupt:
+        pass
+
+
+if __name__ == "__main__":
+    main()
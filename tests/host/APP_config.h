@@ -0,0 +1,11 @@
+#ifndef SMARTLOCK_HOST_APP_CONFIG_H
+#define SMARTLOCK_HOST_APP_CONFIG_H
+/*
+ * 主机测试配置：代替 Application/Inc/APP_config.h，只开启被测模块需要的功能宏。
+ * OSAL 由 tests/host/osal_host.c 以 pthread 实现，不依赖 CMSIS/FreeRTOS。
+ */
+#define ENABLE_STATIC_ALLOCATION /* 静态内存分配 */
+#define ENABLE_RINGBUFFER_SYSTEM /* 环形缓冲区系统 */
+#define ENABLE_RINGBUFFER_STATS  /* 环形缓冲区运行统计与登记表（与目标板配置一致） */
+
+#endif  // SMARTLOCK_HOST_APP_CONFIG_H
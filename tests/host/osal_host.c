@@ -0,0 +1,132 @@
+#include "APP_config.h"
+#include "osal.h"
+
+#include <pthread.h>
+#include <stdlib.h>
+#include <time.h>
+
+/*
+ * 主机 OSAL 后端（仅实现被测模块用到的子集）
+ * - 临界区：一把全局递归互斥锁。目标板上是关中断，这里用它模拟“同一时刻只有一方在临界区内”，
+ *   所以加锁路径在主机上的开销体现的是争用，而不是关中断的周期数
+ * - 信号量：互斥锁 + 条件变量；记录存活个数并可注入创建失败，供测试检查句柄泄漏（见 test_host.h）
+ * - tick：CLOCK_MONOTONIC 毫秒，1 tick = 1 ms
+ */
+static pthread_mutex_t s_host_crit = PTHREAD_RECURSIVE_MUTEX_INITIALIZER_NP;
+
+typedef struct {
+    pthread_mutex_t lock;
+    pthread_cond_t cond;
+    uint32_t count;
+    uint32_t max;
+} host_sem_t;
+
+static volatile uint32_t s_host_sem_live;     // 已创建未删除的信号量个数
+static volatile uint32_t s_host_sem_fail_at;  // 第几次创建失败（1 起，0 表示不注入）
+
+/* ============================== 内核状态/时间 ============================== */
+osal_tick_t OSAL_tick_get(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (osal_tick_t)((uint64_t)ts.tv_sec * 1000u + (uint64_t)ts.tv_nsec / 1000000u);
+}
+
+uint32_t OSAL_tick_to_ms(const osal_tick_t ticks) { return ticks; }
+
+bool OSAL_in_isr(void) { return false; }
+
+/* ================================= 临界区 ================================= */
+void OSAL_enter_critical(void) { pthread_mutex_lock(&s_host_crit); }
+
+void OSAL_exit_critical(void) { pthread_mutex_unlock(&s_host_crit); }
+
+void OSAL_enter_critical_from_isr(osal_crit_state_t *state) {
+    *state = 0;
+    pthread_mutex_lock(&s_host_crit);
+}
+
+void OSAL_exit_critical_from_isr(const osal_crit_state_t state) {
+    (void)state;
+    pthread_mutex_unlock(&s_host_crit);
+}
+
+/* ================================= 信号量 ================================= */
+ret_code_t OSAL_sem_create(osal_sem_t *out, const char *name, const uint32_t initial_count,
+                           const uint32_t max_count) {
+    (void)name;
+    if (out == NULL || max_count == 0 || initial_count > max_count) return RET_E_INVALID_ARG;
+    if (s_host_sem_fail_at != 0 && --s_host_sem_fail_at == 0) return RET_E_NO_MEM;
+
+    host_sem_t *s = calloc(1, sizeof(*s));
+    if (s == NULL) return RET_E_NO_MEM;
+    pthread_mutex_init(&s->lock, NULL);
+    pthread_cond_init(&s->cond, NULL);
+    s->count = initial_count;
+    s->max   = max_count;
+    *out     = s;
+    __atomic_fetch_add(&s_host_sem_live, 1u, __ATOMIC_RELAXED);
+    return RET_OK;
+}
+
+ret_code_t OSAL_sem_delete(osal_sem_t sem) {
+    host_sem_t *s = sem;
+    if (s == NULL) return RET_E_INVALID_ARG;
+
+    pthread_cond_destroy(&s->cond);
+    pthread_mutex_destroy(&s->lock);
+    free(s);
+    __atomic_fetch_sub(&s_host_sem_live, 1u, __ATOMIC_RELAXED);
+    return RET_OK;
+}
+
+ret_code_t OSAL_sem_take(osal_sem_t sem, const uint32_t timeout_ms) {
+    host_sem_t *s = sem;
+    if (s == NULL) return RET_E_INVALID_ARG;
+
+    struct timespec deadline;
+    clock_gettime(CLOCK_REALTIME, &deadline);
+    deadline.tv_sec += timeout_ms / 1000u;
+    deadline.tv_nsec += (long)(timeout_ms % 1000u) * 1000000L;
+    if (deadline.tv_nsec >= 1000000000L) {
+        deadline.tv_sec++;
+        deadline.tv_nsec -= 1000000000L;
+    }
+
+    pthread_mutex_lock(&s->lock);
+    int err = 0;
+    while (s->count == 0 && err == 0) {
+        if (timeout_ms == OSAL_WAIT_FOREVER)
+            err = pthread_cond_wait(&s->cond, &s->lock);
+        else
+            err = pthread_cond_timedwait(&s->cond, &s->lock, &deadline);
+    }
+    ret_code_t rc = RET_E_TIMEOUT;
+    if (s->count > 0) {
+        s->count--;
+        rc = RET_OK;
+    }
+    pthread_mutex_unlock(&s->lock);
+    return rc;
+}
+
+ret_code_t OSAL_sem_give(osal_sem_t sem) {
+    host_sem_t *s = sem;
+    if (s == NULL) return RET_E_INVALID_ARG;
+
+    ret_code_t rc = RET_E_FAIL;
+    pthread_mutex_lock(&s->lock);
+    if (s->count < s->max) {
+        s->count++;
+        rc = RET_OK;
+        pthread_cond_signal(&s->cond);
+    }
+    pthread_mutex_unlock(&s->lock);
+    return rc;
+}
+
+ret_code_t OSAL_sem_give_from_isr(osal_sem_t sem) { return OSAL_sem_give(sem); }
+
+/* ================================ 测试钩子 ================================ */
+uint32_t osal_host_sem_live(void) { return __atomic_load_n(&s_host_sem_live, __ATOMIC_RELAXED); }
+
+void osal_host_sem_fail_at(const uint32_t nth) { s_host_sem_fail_at = nth; }
@@ -0,0 +1,81 @@
+#ifndef SMARTLOCK_TEST_HOST_H
+#define SMARTLOCK_TEST_HOST_H
+/*
+ * 主机测试公共部分：断言、失败计数、字节序列模式与计时
+ * 每个测试是一个独立可执行文件，main 返回 TEST_RESULT()，非 0 即失败（ctest 判定）
+ */
+#include <sched.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <time.h>
+
+static volatile uint32_t s_test_failures;
+
+/**
+ * @brief 记录一次失败（可在任意线程调用）
+ * @param file 源文件
+ * @param line 行号
+ * @param expr 失败的表达式
+ */
+static inline void test_fail(const char *file, const int line, const char *expr) {
+    __atomic_fetch_add(&s_test_failures, 1u, __ATOMIC_RELAXED);
+    fprintf(stderr, "%s:%d: 检查失败: %s\n", file, line, expr);
+}
+
+/* 有失败时工作线程应尽快退出，避免在坏数据上空转到超时 */
+static inline bool test_failed(void) {
+    return __atomic_load_n(&s_test_failures, __ATOMIC_RELAXED) != 0;
+}
+
+/* 记录失败后继续执行 */
+#define TEST_EXPECT(expr)                                  \
+    do {                                                   \
+        if (!(expr)) test_fail(__FILE__, __LINE__, #expr); \
+    } while (0)
+
+/* 记录失败并从当前（返回 int 的）函数返回 1 */
+#define TEST_ASSERT(expr)                         \
+    do {                                          \
+        if (!(expr)) {                            \
+            test_fail(__FILE__, __LINE__, #expr); \
+            return 1;                             \
+        }                                         \
+    } while (0)
+
+#define TEST_RESULT() (test_failed() ? 1 : 0)
+
+/**
+ * @brief 字节流第 i 个字节的期望值
+ * @note  混入高位，整段错位 256 字节或跨 32 位回绕时也能发现（单纯 (uint8_t)i 做不到）
+ */
+static inline uint8_t test_pattern(const uint32_t i) {
+    return (uint8_t)(i ^ (i >> 8) ^ (i >> 16) ^ (i >> 24));
+}
+
+/* 用 start 开始的模式填充 n 字节 */
+static inline void test_pattern_fill(uint8_t *dst, const uint32_t start, const uint32_t n) {
+    for (uint32_t i = 0; i < n; i++) dst[i] = test_pattern(start + i);
+}
+
+/* 检查 n 字节是否等于 start 开始的模式 */
+static inline bool test_pattern_check(const uint8_t *src, const uint32_t start,
+                                      const uint32_t n) {
+    for (uint32_t i = 0; i < n; i++) {
+        if (src[i] != test_pattern(start + i)) return false;
+    }
+    return true;
+}
+
+/* 主机 OSAL 的测试钩子（tests/host/osal_host.c）：存活信号量个数；让第 nth 次创建失败（0 取消） */
+uint32_t osal_host_sem_live(void);
+void osal_host_sem_fail_at(uint32_t nth);
+
+/* 单调时钟，纳秒 */
+static inline uint64_t test_now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec;
+}
+
+#endif  // SMARTLOCK_TEST_HOST_H
@@ -0,0 +1,121 @@
+/*
+ * 无锁 SPSC 路径与临界区（RB_ENTER_CRITICAL）路径的吞吐对比
+ * 同一份代码分别以 RB_FLAG_SPSC 和 RB_FLAG_NONE 创建，跑两种负载：
+ * - 单线程：同一线程写入再读出，只衡量每次调用的固定开销（无争用）
+ * - 双线程：生产者/消费者各一个线程跑满字节流（有争用）
+ * 主机上的临界区是 pthread 互斥锁（见 tests/host/osal_host.c），数值用于比较两条路径的相对差异，
+ * 不代表目标板上关中断的周期数。用法：bench_rb_lock [总字节数]
+ */
+#include <pthread.h>
+#include <stdlib.h>
+
+#include "MemoryAllocation.h"
+#include "RingBuffer.h"
+#include "test_host.h"
+
+#define BENCH_RB_SIZE       1024u
+#define BENCH_DEFAULT_BYTES 64000000u
+
+typedef struct {
+    RingBuffer *rb;
+    uint32_t total;
+    uint32_t chunk;
+} bench_ctx_t;
+
+static RingBuffer s_rb;
+
+static void *bench_producer(void *arg) {
+    const bench_ctx_t *ctx = arg;
+    uint8_t buf[256] = {0};
+    uint32_t sent    = 0;
+    while (sent < ctx->total) {
+        uint32_t n = (ctx->chunk < ctx->total - sent) ? ctx->chunk : (ctx->total - sent);
+        if (WriteRingBufferFromISR(ctx->rb, buf, &n, 1) != RET_OK || n == 0) {
+            sched_yield();
+            continue;
+        }
+        sent += n;
+    }
+    return NULL;
+}
+
+/**
+ * @brief 双线程吞吐
+ * @return 耗时（纳秒）
+ */
+static uint64_t bench_threaded(RingBuffer *rb, const uint32_t total, const uint32_t chunk) {
+    bench_ctx_t ctx = {.rb = rb, .total = total, .chunk = chunk};
+    uint8_t buf[256];
+    uint32_t got = 0;
+    pthread_t producer;
+
+    const uint64_t t0 = test_now_ns();
+    if (pthread_create(&producer, NULL, bench_producer, &ctx) != 0) return 0;
+    while (got < total) {
+        uint32_t n = chunk;
+        if (ReadRingBuffer(rb, buf, &n, 1) != RET_OK || n == 0) {
+            sched_yield();
+            continue;
+        }
+        got += n;
+    }
+    pthread_join(producer, NULL);
+    return test_now_ns() - t0;
+}
+
+/**
+ * @brief 单线程：写一块读一块
+ * @return 耗时（纳秒）
+ */
+static uint64_t bench_single(RingBuffer *rb, const uint32_t total, const uint32_t chunk) {
+    uint8_t buf[256] = {0};
+    const uint64_t t0 = test_now_ns();
+    for (uint32_t done = 0; done < total; done += chunk) {
+        uint32_t n = chunk;
+        WriteRingBuffer(rb, buf, &n, 0);
+        n = chunk;
+        ReadRingBuffer(rb, buf, &n, 0);
+    }
+    return test_now_ns() - t0;
+}
+
+/**
+ * @brief 对一种负载、一种块大小比较两条路径并打印
+ * @return 0 成功
+ */
+static int bench_compare(const char *name, const bool threaded, const uint32_t total,
+                         const uint32_t chunk) {
+    static const struct {
+        const char *label;
+        uint32_t flags;
+    } modes[] = {{"critical", RB_FLAG_NONE}, {"spsc", RB_FLAG_SPSC}};
+    uint64_t ns[2];
+
+    for (uint32_t i = 0; i < 2u; i++) {
+        static_alloc_reset();
+        TEST_ASSERT(CreateRingBufferEx(&s_rb, modes[i].label, BENCH_RB_SIZE, modes[i].flags) ==
+                    RET_OK);
+        ns[i] = threaded ? bench_threaded(&s_rb, total, chunk) : bench_single(&s_rb, total, chunk);
+        TEST_ASSERT(ns[i] > 0);
+        TEST_ASSERT(RingBuffer_GetUsedSize(&s_rb) == 0);
+    }
+    const double ops = (double)total / chunk;
+    printf("%-8s chunk %3u: critical %7.1f ns/op %8.1f MB/s | spsc %7.1f ns/op %8.1f MB/s"
+           " | x%.2f\n",
+           name, chunk, ns[0] / ops, total * 1e3 / ns[0], ns[1] / ops, total * 1e3 / ns[1],
+           (double)ns[0] / ns[1]);
+    return 0;
+}
+
+int main(const int argc, char **argv) {
+    const uint32_t total = (argc > 1) ? (uint32_t)strtoul(argv[1], NULL, 0) : BENCH_DEFAULT_BYTES;
+    static const uint32_t chunks[] = {4u, 32u, 256u};
+
+    for (uint32_t i = 0; i < sizeof(chunks) / sizeof(chunks[0]); i++) {
+        bench_compare("single", false, total, chunks[i]);
+    }
+    for (uint32_t i = 0; i < sizeof(chunks) / sizeof(chunks[0]); i++) {
+        bench_compare("threaded", true, total, chunks[i]);
+    }
+    return TEST_RESULT();
+}
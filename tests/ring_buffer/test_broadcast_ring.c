@@ -0,0 +1,218 @@
+/*
+ * BroadcastRing 甩开/重同步协议测试
+ * - 固定步骤：逐步构造“慢游标被甩开”的场景，检查 RET_E_DATA_OVERFLOW、overruns/dropped 计数、
+ *   重同步后的位置，以及零拷贝窗口在访问期间被覆盖时 ReadCommit 的返回
+ * - 并发：一个生产者、快慢各两个消费者（拷贝读与零拷贝读各一），生产者定期无视流控强行写入；
+ *   每次读出的数据必须等于游标位置处的字节流，且每个游标 收到 + dropped == 写入总量
+ */
+#include <pthread.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "BroadcastRing.h"
+#include "MemoryAllocation.h"
+#include "test_host.h"
+
+#define BR_STREAM_BYTES 300000u
+#define BR_CHUNK_MAX    23u
+#define BR_READ_MAX     40u
+#define BR_FORCE_EVERY  256u
+
+static BroadcastRing s_br;
+
+/**
+ * @brief 写入 stream 位置开始的 n 字节模式数据
+ */
+static ret_code_t br_write_pattern(BroadcastRing *br, const uint32_t stream, const uint32_t n) {
+    uint8_t buf[64];
+    test_pattern_fill(buf, stream, n);
+    return BroadcastRing_Write(br, buf, n);
+}
+
+/**
+ * @brief 固定步骤的甩开/重同步检查（size = 64）
+ * @return 0 成功
+ */
+static int br_overrun_steps(void) {
+    uint8_t buf[64];
+    uint32_t n = 0;
+    BroadcastCursor *fast;
+    BroadcastCursor *slow;
+
+    static_alloc_reset();
+    TEST_ASSERT(CreateBroadcastRing(&s_br, "br", 100u) == RET_E_INVALID_ARG);
+    TEST_ASSERT(CreateBroadcastRing(&s_br, "br", 64u) == RET_OK);
+    TEST_ASSERT(BroadcastRing_Attach(&s_br, "fast", &fast) == RET_OK);
+    TEST_ASSERT(BroadcastRing_Attach(&s_br, "slow", &slow) == RET_OK);
+
+    /* 1、都跟得上：fast 读完 40，slow 积压 40 */
+    TEST_ASSERT(br_write_pattern(&s_br, 0, 40u) == RET_OK);
+    TEST_ASSERT(BroadcastRing_Read(fast, buf, sizeof(buf), &n) == RET_OK && n == 40u);
+    TEST_ASSERT(test_pattern_check(buf, 0, n));
+    TEST_ASSERT(BroadcastRing_GetRemainSize(&s_br) == 24u);
+
+    /* 2、再写 30：slow 积压 70 > 64 被甩开，生产者不再为它保留空间 */
+    TEST_ASSERT(br_write_pattern(&s_br, 40u, 30u) == RET_OK);
+    TEST_ASSERT(slow->overrun);
+    TEST_ASSERT(!fast->overrun);
+    TEST_ASSERT(BroadcastRing_GetRemainSize(&s_br) == 34u);
+    TEST_ASSERT(BroadcastRing_GetUsedSize(slow) == 0);
+
+    /* 3、slow 读：报告溢出并跳到最新写位置，丢失的字节计入 dropped */
+    TEST_ASSERT(BroadcastRing_Read(slow, buf, sizeof(buf), &n) == RET_E_DATA_OVERFLOW);
+    TEST_ASSERT(n == 0);
+    TEST_ASSERT(!slow->overrun);
+    TEST_ASSERT(slow->pos == 70u);
+    TEST_ASSERT(slow->overruns == 1u && slow->dropped == 70u);
+    TEST_ASSERT(BroadcastRing_Read(slow, buf, sizeof(buf), &n) == RET_E_DATA_NOT_ENOUGH);
+
+    /* 4、重同步后两个游标都从各自位置继续读到正确数据 */
+    TEST_ASSERT(br_write_pattern(&s_br, 70u, 10u) == RET_OK);
+    TEST_ASSERT(BroadcastRing_Read(slow, buf, sizeof(buf), &n) == RET_OK && n == 10u);
+    TEST_ASSERT(test_pattern_check(buf, 70u, n));
+    TEST_ASSERT(BroadcastRing_Read(fast, buf, sizeof(buf), &n) == RET_OK && n == 40u);
+    TEST_ASSERT(test_pattern_check(buf, 40u, n));
+
+    /* 5、零拷贝窗口持有期间被甩开：ReadCommit 报告溢出，窗口内数据作废 */
+    TEST_ASSERT(br_write_pattern(&s_br, 80u, 20u) == RET_OK);
+    RingBufferSpan span;
+    uint32_t granted = 0;
+    TEST_ASSERT(BroadcastRing_ReadReserve(slow, 20u, &span, &granted) == RET_OK);
+    TEST_ASSERT(granted == 20u && span.n1 + span.n2 == 20u);
+    TEST_ASSERT(BroadcastRing_Read(fast, buf, sizeof(buf), &n) == RET_OK && n == 20u);
+    TEST_ASSERT(br_write_pattern(&s_br, 100u, 60u) == RET_OK);
+    TEST_ASSERT(!fast->overrun);
+    TEST_ASSERT(BroadcastRing_ReadCommit(slow, granted) == RET_E_DATA_OVERFLOW);
+    TEST_ASSERT(slow->pos == 160u);
+    TEST_ASSERT(slow->overruns == 2u && slow->dropped == 70u + 80u);
+
+    /* 6、摘除后不再被标记，也不再占用生产者的空间 */
+    BroadcastRing_Detach(slow);
+    TEST_ASSERT(br_write_pattern(&s_br, 160u, 64u) == RET_OK);
+    TEST_ASSERT(!slow->overrun);
+    TEST_ASSERT(fast->overrun);  // fast 还有 60 积压，再写 64 必然被甩开
+
+    /* 7、游标槽上限 */
+    BroadcastCursor *extra;
+    for (uint32_t i = 1; i < BR_CURSOR_MAX; i++) {
+        TEST_ASSERT(BroadcastRing_Attach(&s_br, "extra", &extra) == RET_OK);
+    }
+    TEST_ASSERT(BroadcastRing_Attach(&s_br, "extra", &extra) == RET_E_NO_MEM);
+    printf("broadcast overrun steps OK\n");
+    return 0;
+}
+
+typedef struct {
+    BroadcastCursor *cur;
+    bool slow;         // 每次读完休眠，制造积压
+    bool zero_copy;    // 使用 ReadReserve/ReadCommit
+    uint32_t got;      // 成功读出的字节数
+    uint32_t resyncs;  // 收到 RET_E_DATA_OVERFLOW 的次数
+} br_consumer_t;
+
+static volatile bool s_br_done;
+
+/**
+ * @brief 生产者：按 GetRemainSize 流控，每 BR_FORCE_EVERY 块无视流控强行写入一次（甩开最慢的游标）
+ */
+static void *br_producer(void *arg) {
+    (void)arg;
+    uint32_t sent   = 0;
+    uint32_t chunks = 0;
+    while (sent < BR_STREAM_BYTES && !test_failed()) {
+        uint32_t n = 1u + (chunks % BR_CHUNK_MAX);
+        if (n > BR_STREAM_BYTES - sent) n = BR_STREAM_BYTES - sent;
+        const bool force = (chunks % BR_FORCE_EVERY) == BR_FORCE_EVERY - 1u;
+        if (!force && BroadcastRing_GetRemainSize(&s_br) < n) {
+            sched_yield();
+            continue;
+        }
+        TEST_EXPECT(br_write_pattern(&s_br, sent, n) == RET_OK);
+        sent += n;
+        chunks++;
+    }
+    __atomic_store_n(&s_br_done, true, __ATOMIC_RELEASE);
+    return NULL;
+}
+
+/**
+ * @brief 消费者：游标位置即字节流位置，读出的数据必须与该位置的模式一致
+ */
+static void *br_consumer(void *arg) {
+    br_consumer_t *c = arg;
+    uint8_t buf[BR_READ_MAX];
+
+    while (!test_failed()) {
+        /* 先看结束标志再读：结束后读到空即说明已追到最终写位置 */
+        const bool done    = __atomic_load_n(&s_br_done, __ATOMIC_ACQUIRE);
+        const uint32_t pos = c->cur->pos;
+        uint32_t n         = 0;
+        ret_code_t rc;
+
+        if (c->zero_copy) {
+            RingBufferSpan span;
+            rc = BroadcastRing_ReadReserve(c->cur, sizeof(buf), &span, &n);
+            if (rc == RET_OK) {
+                memcpy(buf, span.p1, span.n1);
+                if (span.n2 > 0) memcpy(buf + span.n1, span.p2, span.n2);
+                if (c->slow) usleep(50);
+                rc = BroadcastRing_ReadCommit(c->cur, n);
+            }
+        } else {
+            rc = BroadcastRing_Read(c->cur, buf, sizeof(buf), &n);
+            if (c->slow && rc == RET_OK) usleep(100);
+        }
+
+        if (rc == RET_OK) {
+            TEST_EXPECT(test_pattern_check(buf, pos, n));
+            c->got += n;
+        } else if (rc == RET_E_DATA_OVERFLOW) {
+            c->resyncs++;
+        } else {
+            TEST_EXPECT(rc == RET_E_DATA_NOT_ENOUGH);
+            if (done) break;
+            sched_yield();
+        }
+    }
+    return NULL;
+}
+
+/**
+ * @brief 并发收发（size = 128）
+ * @return 0 成功
+ */
+static int br_stress(void) {
+    static_alloc_reset();
+    TEST_ASSERT(CreateBroadcastRing(&s_br, "br", 128u) == RET_OK);
+    s_br_done = false;
+
+    br_consumer_t consumers[BR_CURSOR_MAX] = {0};
+    pthread_t threads[BR_CURSOR_MAX + 1u];
+    for (uint32_t i = 0; i < BR_CURSOR_MAX; i++) {
+        TEST_ASSERT(BroadcastRing_Attach(&s_br, "c", &consumers[i].cur) == RET_OK);
+        consumers[i].slow      = (i >= BR_CURSOR_MAX / 2u);
+        consumers[i].zero_copy = (i & 1u) != 0;
+    }
+    for (uint32_t i = 0; i < BR_CURSOR_MAX; i++) {
+        TEST_ASSERT(pthread_create(&threads[i], NULL, br_consumer, &consumers[i]) == 0);
+    }
+    TEST_ASSERT(pthread_create(&threads[BR_CURSOR_MAX], NULL, br_producer, NULL) == 0);
+    for (uint32_t i = 0; i <= BR_CURSOR_MAX; i++) pthread_join(threads[i], NULL);
+
+    for (uint32_t i = 0; i < BR_CURSOR_MAX; i++) {
+        const br_consumer_t *c = &consumers[i];
+        printf("cursor %u (%s%s): got %u resync %u overruns %u dropped %u\n", i,
+               c->slow ? "slow" : "fast", c->zero_copy ? ", zero-copy" : "", c->got, c->resyncs,
+               c->cur->overruns, c->cur->dropped);
+        TEST_EXPECT(c->cur->pos == BR_STREAM_BYTES);
+        TEST_EXPECT(c->got + c->cur->dropped == BR_STREAM_BYTES);
+        TEST_EXPECT(c->resyncs == c->cur->overruns);
+    }
+    return 0;
+}
+
+int main(void) {
+    br_overrun_steps();
+    br_stress();
+    return TEST_RESULT();
+}
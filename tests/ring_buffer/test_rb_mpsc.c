@@ -0,0 +1,150 @@
+/*
+ * RB_FLAG_MPSC 认领/提交测试
+ * 多个生产者线程（任务版与 FromISR 版混用）并发 WriteV 变长记录，一个消费者逐条校验：
+ * - 记录整体可见：读到长度字节后剩余部分必须已经全部就绪
+ * - 每个生产者的序号严格递增、载荷逐字节正确（认领区间互不重叠，按认领顺序发布）
+ * 另外检查创建参数与不支持的接口被拒绝。
+ */
+#include <pthread.h>
+#include <string.h>
+
+#include "MemoryAllocation.h"
+#include "RingBuffer.h"
+#include "test_host.h"
+
+#define MPSC_PRODUCERS   4u
+#define MPSC_RECORDS     100000u
+#define MPSC_HDR_LEN     6u  // len(1) | producer(1) | seq(4)
+#define MPSC_PAYLOAD_MAX 40u
+
+typedef struct {
+    RingBuffer *rb;
+    uint8_t id;
+} mpsc_producer_t;
+
+static RingBuffer s_rb;
+
+/**
+ * @brief 生产者：记录头与载荷分两段 WriteV，写不下整体失败后重试
+ */
+static void *mpsc_producer(void *arg) {
+    const mpsc_producer_t *p = arg;
+    uint8_t hdr[MPSC_HDR_LEN];
+    uint8_t payload[MPSC_PAYLOAD_MAX];
+
+    for (uint32_t seq = 0; seq < MPSC_RECORDS && !test_failed();) {
+        const uint32_t plen = seq % (MPSC_PAYLOAD_MAX + 1u);
+        hdr[0]              = (uint8_t)(MPSC_HDR_LEN + plen);
+        hdr[1]              = p->id;
+        memcpy(&hdr[2], &seq, sizeof(seq));
+        test_pattern_fill(payload, seq * 131u + p->id, plen);
+
+        const RingBufferConstVec vec[2] = {{.ptr = hdr, .len = MPSC_HDR_LEN},
+                                           {.ptr = payload, .len = plen}};
+        uint32_t written                = 0;
+        ret_code_t rc;
+        if (p->id & 1u)
+            rc = RingBuffer_WriteVFromISR(p->rb, vec, 2, &written, false);
+        else
+            rc = RingBuffer_WriteV(p->rb, vec, 2, &written, false);
+        if (rc == RET_OK) {
+            TEST_EXPECT(written == MPSC_HDR_LEN + plen);
+            seq++;
+        } else {
+            TEST_EXPECT(rc == RET_E_NO_MEM);
+            sched_yield();
+        }
+    }
+    return NULL;
+}
+
+/**
+ * @brief 消费者：先读长度字节，再非强制读出记录剩余部分（必须一次成功）
+ */
+static void mpsc_consume(RingBuffer *rb) {
+    uint32_t next[MPSC_PRODUCERS] = {0};
+    uint8_t rec[MPSC_HDR_LEN + MPSC_PAYLOAD_MAX];
+    uint32_t done = 0;
+
+    while (done < MPSC_PRODUCERS * MPSC_RECORDS && !test_failed()) {
+        uint32_t n = 1;
+        if (ReadRingBuffer(rb, rec, &n, 0) != RET_OK) {
+            sched_yield();
+            continue;
+        }
+        uint32_t rest = (uint32_t)rec[0] - 1u;
+        TEST_EXPECT(rec[0] >= MPSC_HDR_LEN && rec[0] <= sizeof(rec));
+        TEST_EXPECT(ReadRingBuffer(rb, &rec[1], &rest, 0) == RET_OK);
+        if (test_failed()) break;
+
+        uint32_t seq;
+        memcpy(&seq, &rec[2], sizeof(seq));
+        const uint8_t id = rec[1];
+        TEST_EXPECT(id < MPSC_PRODUCERS);
+        if (test_failed()) break;
+        TEST_EXPECT(seq == next[id]);
+        TEST_EXPECT(
+            test_pattern_check(&rec[MPSC_HDR_LEN], seq * 131u + id, rec[0] - MPSC_HDR_LEN));
+        next[id] = seq + 1u;
+        done++;
+    }
+}
+
+/**
+ * @brief 跑一轮并发写入
+ * @param size 缓冲区大小（2 的幂）
+ * @return 0 成功
+ */
+static int mpsc_run(const uint32_t size) {
+    static_alloc_reset();
+    TEST_ASSERT(CreateRingBufferEx(&s_rb, "mpsc", size, RB_FLAG_MPSC) == RET_OK);
+
+    mpsc_producer_t producers[MPSC_PRODUCERS];
+    pthread_t threads[MPSC_PRODUCERS];
+    for (uint32_t i = 0; i < MPSC_PRODUCERS; i++) {
+        producers[i].rb = &s_rb;
+        producers[i].id = (uint8_t)i;
+        TEST_ASSERT(pthread_create(&threads[i], NULL, mpsc_producer, &producers[i]) == 0);
+    }
+    mpsc_consume(&s_rb);
+    for (uint32_t i = 0; i < MPSC_PRODUCERS; i++) pthread_join(threads[i], NULL);
+
+    TEST_ASSERT(RingBuffer_GetUsedSize(&s_rb) == 0);
+    TEST_ASSERT((s_rb.mp_state >> 24) == 0);  // 没有残留的未完成写入方
+    printf("mpsc size %4u: %u x %u 条记录 OK\n", size, MPSC_PRODUCERS, MPSC_RECORDS);
+    return 0;
+}
+
+/**
+ * @brief 参数与接口限制
+ * @return 0 成功
+ */
+static int mpsc_limits(void) {
+    static RingBuffer rb;  // 统计开启时实例会挂入全局登记表，不能放在栈上
+    static_alloc_reset();
+    TEST_ASSERT(CreateRingBufferEx(&rb, "x", 100u, RB_FLAG_MPSC) == RET_E_INVALID_ARG);
+    TEST_ASSERT(CreateRingBufferEx(&rb, "x", 64u, RB_FLAG_MPSC | RB_FLAG_SPSC) ==
+                RET_E_INVALID_ARG);
+    TEST_ASSERT(CreateRingBufferEx(&rb, "x", 64u, RB_FLAG_MPSC | RB_FLAG_OVERWRITE) ==
+                RET_E_INVALID_ARG);
+    TEST_ASSERT(CreateRingBufferEx(&rb, "x", 64u, RB_FLAG_MPSC) == RET_OK);
+
+    RingBufferSpan span;
+    uint32_t granted = 0;
+    TEST_ASSERT(RingBuffer_WriteReserve(&rb, 4u, &span, &granted, false) == RET_E_UNSUPPORTED);
+    TEST_ASSERT(RingBuffer_WriteCommit(&rb, 0) == RET_E_UNSUPPORTED);
+
+    /* 非强制写不下时整体失败，一个字节都不发布 */
+    uint8_t data[80] = {0};
+    uint32_t len     = sizeof(data);
+    TEST_ASSERT(WriteRingBuffer(&rb, data, &len, 0) == RET_E_NO_MEM);
+    TEST_ASSERT(RingBuffer_GetUsedSize(&rb) == 0);
+    return 0;
+}
+
+int main(void) {
+    mpsc_limits();
+    mpsc_run(256u);
+    mpsc_run(4096u);
+    return TEST_RESULT();
+}
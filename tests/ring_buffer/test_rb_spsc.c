@@ -0,0 +1,204 @@
+/*
+ * RB_FLAG_SPSC 无锁模式压力测试
+ * 一个生产者线程、一个消费者线程跑满字节流，逐字节校验序列，覆盖：
+ * - 2 的幂 size（索引按 2^32 回绕，含预置到回绕点之前的情况）
+ * - 非 2 的幂 size（镜像索引在 [0, 2*size) 内回绕）
+ * - 拷贝读写与零拷贝 Reserve/Commit 交替使用，窗口跨越末尾时分两段
+ * - 多段 WriteV/ReadV：在每个起始索引上分段写读，段起点跨越末尾与镜像回绕点
+ */
+#include <pthread.h>
+
+#include "MemoryAllocation.h"
+#include "RingBuffer.h"
+#include "test_host.h"
+
+#define SPSC_STREAM_BYTES 2000000u
+#define SPSC_CHUNK_MAX    61u
+
+typedef struct {
+    RingBuffer *rb;
+    uint32_t total;
+} spsc_ctx_t;
+
+static RingBuffer s_rb;
+
+/**
+ * @brief 生产者：奇数次走拷贝写入（非强制，写不下整体失败），偶数次走 WriteReserve/Commit
+ */
+static void *spsc_producer(void *arg) {
+    const spsc_ctx_t *ctx = arg;
+    uint8_t chunk[SPSC_CHUNK_MAX];
+    uint32_t sent = 0;
+    uint32_t k    = 0;
+
+    while (sent < ctx->total && !test_failed()) {
+        uint32_t n = 1u + (k++ % SPSC_CHUNK_MAX);
+        if (n > ctx->total - sent) n = ctx->total - sent;
+
+        if (k & 1u) {
+            test_pattern_fill(chunk, sent, n);
+            uint32_t len        = n;
+            const ret_code_t rc = WriteRingBufferFromISR(ctx->rb, chunk, &len, 0);
+            if (rc == RET_OK) {
+                TEST_EXPECT(len == n);
+                sent += n;
+            } else {
+                TEST_EXPECT(rc == RET_E_NO_MEM);
+                sched_yield();
+            }
+            continue;
+        }
+
+        RingBufferSpan span;
+        uint32_t granted = 0;
+        TEST_EXPECT(RingBuffer_WriteReserve(ctx->rb, n, &span, &granted, true) == RET_OK);
+        if (granted == 0) {
+            sched_yield();
+            continue;
+        }
+        TEST_EXPECT(span.n1 + span.n2 == granted);
+        test_pattern_fill(span.p1, sent, span.n1);
+        if (span.n2 > 0) test_pattern_fill(span.p2, sent + span.n1, span.n2);
+        TEST_EXPECT(RingBuffer_WriteCommit(ctx->rb, granted) == RET_OK);
+        sent += granted;
+    }
+    return NULL;
+}
+
+/**
+ * @brief 消费者：奇数次强制读出（有多少读多少），偶数次走 ReadReserve/Commit
+ */
+static uint32_t spsc_consume(const spsc_ctx_t *ctx) {
+    uint8_t buf[SPSC_CHUNK_MAX + 16u];
+    uint32_t got = 0;
+    uint32_t k   = 0;
+
+    while (got < ctx->total && !test_failed()) {
+        const uint32_t want = 1u + (k++ % sizeof(buf));
+
+        if (k & 1u) {
+            uint32_t n = want;
+            TEST_EXPECT(ReadRingBuffer(ctx->rb, buf, &n, 1) == RET_OK);
+            if (n == 0) {
+                sched_yield();
+                continue;
+            }
+            TEST_EXPECT(test_pattern_check(buf, got, n));
+            got += n;
+            continue;
+        }
+
+        RingBufferSpan span;
+        uint32_t granted = 0;
+        TEST_EXPECT(RingBuffer_ReadReserve(ctx->rb, want, &span, &granted, true) == RET_OK);
+        if (granted == 0) {
+            sched_yield();
+            continue;
+        }
+        TEST_EXPECT(span.n1 + span.n2 == granted);
+        TEST_EXPECT(test_pattern_check(span.p1, got, span.n1));
+        if (span.n2 > 0) TEST_EXPECT(test_pattern_check(span.p2, got + span.n1, span.n2));
+        TEST_EXPECT(RingBuffer_ReadCommit(ctx->rb, granted) == RET_OK);
+        got += granted;
+    }
+    return got;
+}
+
+/**
+ * @brief 跑一轮：创建、（可选）把索引预置到 index_base、并发收发、检查收尾状态
+ * @param size 缓冲区大小
+ * @param index_base 起始索引（仅 2 的幂 size 有意义，用来跨越 2^32 回绕；0 表示不预置）
+ * @return 0 成功
+ */
+static int spsc_run(const uint32_t size, const uint32_t index_base) {
+    static_alloc_reset();
+    TEST_ASSERT(CreateRingBufferEx(&s_rb, "spsc", size, RB_FLAG_SPSC) == RET_OK);
+    TEST_ASSERT(s_rb.isPowerOfTwo_Size == ((size & (size - 1u)) == 0));
+    if (index_base != 0) {
+        /* 空缓冲区下两端索引相等即可，线程启动前设置 */
+        s_rb.rear_index  = index_base;
+        s_rb.front_index = index_base;
+    }
+
+    spsc_ctx_t ctx = {.rb = &s_rb, .total = SPSC_STREAM_BYTES};
+    pthread_t producer;
+    TEST_ASSERT(pthread_create(&producer, NULL, spsc_producer, &ctx) == 0);
+    const uint32_t got = spsc_consume(&ctx);
+    pthread_join(producer, NULL);
+
+    TEST_ASSERT(got == ctx.total);
+    TEST_ASSERT(RingBuffer_GetUsedSize(&s_rb) == 0);
+    TEST_ASSERT(RingBuffer_GetRemainSize(&s_rb) == size);
+    if (index_base != 0) TEST_ASSERT(s_rb.rear_index - index_base == ctx.total);
+    printf("spsc size %4u base 0x%08x: %u 字节 OK\n", size, index_base, got);
+    return 0;
+}
+
+/**
+ * @brief 多段 WriteV/ReadV 扫描：起始索引取遍 [0, 2*size)（镜像）或 2^32 回绕点之前一圈（2 的幂）
+ * @note  每个位置先 WriteV 两段、用单段读取校验，再单段写入、ReadV 分三段读回校验；
+ *        两个方向各自与单段路径对照，段起点算错时读写错位一致也能发现
+ * @param size 缓冲区大小
+ * @return 0 成功
+ */
+static int spsc_vec_sweep(const uint32_t size) {
+    const bool pow2     = (size & (size - 1u)) == 0;
+    const uint32_t span = pow2 ? size : (size << 1);
+    const uint32_t base = pow2 ? (0u - size) : 0u;
+    const uint32_t lim  = (size < 64u) ? size : 64u;
+    uint8_t src[64];
+    uint8_t dst[64];
+
+    static_alloc_reset();
+    TEST_ASSERT(CreateRingBufferEx(&s_rb, "spsc-v", size, RB_FLAG_SPSC) == RET_OK);
+    for (uint32_t k = 0; k < span; k++) {
+        /* 总长与分段点随位置变化，第二段起点会落在末尾之后 */
+        const uint32_t total = 1u + (size / 3u + k) % lim;
+        const uint32_t cut   = (k * 7u) % (total + 1u);
+        s_rb.rear_index      = base + k;
+        s_rb.front_index     = base + k;
+
+        /* 1、WriteV 两段 -> 单段读取 */
+        test_pattern_fill(src, k, total);
+        const RingBufferConstVec wv[2] = {{.ptr = src, .len = cut},
+                                          {.ptr = src + cut, .len = total - cut}};
+        uint32_t n                     = 0;
+        TEST_ASSERT(RingBuffer_WriteV(&s_rb, wv, 2, &n, false) == RET_OK && n == total);
+        n = total;
+        TEST_ASSERT(ReadRingBuffer(&s_rb, dst, &n, 0) == RET_OK && n == total);
+        TEST_ASSERT(test_pattern_check(dst, k, total));
+
+        /* 2、单段写入 -> ReadV 三段 */
+        test_pattern_fill(src, k + total, total);
+        n = total;
+        TEST_ASSERT(WriteRingBuffer(&s_rb, src, &n, 0) == RET_OK && n == total);
+        const uint32_t r0         = total / 3u;
+        const uint32_t r1         = (total - r0) / 2u;
+        const RingBufferVec rv[3] = {{.ptr = dst, .len = r0},
+                                     {.ptr = dst + r0, .len = r1},
+                                     {.ptr = dst + r0 + r1, .len = total - r0 - r1}};
+        TEST_ASSERT(RingBuffer_ReadV(&s_rb, rv, 3, &n, false) == RET_OK && n == total);
+        TEST_ASSERT(test_pattern_check(dst, k + total, total));
+        TEST_ASSERT(RingBuffer_GetUsedSize(&s_rb) == 0);
+    }
+    printf("spsc size %4u: WriteV/ReadV 扫描 %u 个起始索引 OK\n", size, span);
+    return 0;
+}
+
+int main(void) {
+    /* 2 的幂：自然回绕 */
+    spsc_run(64u, 0);
+    spsc_run(4096u, 0);
+    /* 2 的幂：流量中途越过 2^32 */
+    spsc_run(256u, 0xFFFFF000u);
+    /* 非 2 的幂：镜像索引 */
+    spsc_run(3u, 0);
+    spsc_run(100u, 0);
+    spsc_run(1000u, 0);
+    /* 多段读写的段起点（回归：非 2 的幂时段起点曾直接用 index + done，越过镜像范围） */
+    spsc_vec_sweep(64u);
+    spsc_vec_sweep(3u);
+    spsc_vec_sweep(100u);
+    spsc_vec_sweep(1000u);
+    return TEST_RESULT();
+}
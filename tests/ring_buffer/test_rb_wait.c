@@ -0,0 +1,128 @@
+/*
+ * RB_FLAG_WAIT 测试
+ * - 等待信号量的生命周期：重复创建沿用已有信号量、去掉标志时释放、第二个信号量创建失败时
+ *   释放第一个、分配存储区失败时释放，主机 OSAL 的存活信号量个数始终对得上
+ * - 阻塞读写：超时不读写任何字节；另一线程写入/读出后等待方被唤醒
+ */
+#include <pthread.h>
+#include <unistd.h>
+
+#include "MemoryAllocation.h"
+#include "RingBuffer.h"
+#include "osal.h"
+#include "test_host.h"
+
+static RingBuffer s_rb;
+
+/**
+ * @brief 等待信号量的创建、沿用与释放
+ * @return 0 成功
+ */
+static int wait_lifetime(void) {
+    const uint32_t live = osal_host_sem_live();
+
+    /* 1、首次创建两个，同一句柄反复创建不再新建 */
+    static_alloc_reset();
+    TEST_ASSERT(CreateRingBufferEx(&s_rb, "wait", 64u, RB_FLAG_WAIT) == RET_OK);
+    TEST_ASSERT(s_rb.rd_waiter != NULL && s_rb.wr_waiter != NULL);
+    TEST_ASSERT(osal_host_sem_live() == live + 2u);
+    void *const rd = s_rb.rd_waiter;
+    for (uint32_t i = 0; i < 100u; i++) {
+        static_alloc_reset();
+        TEST_ASSERT(CreateRingBufferEx(&s_rb, "wait", 64u, RB_FLAG_WAIT | RB_FLAG_SPSC) == RET_OK);
+    }
+    TEST_ASSERT(s_rb.rd_waiter == rd);
+    TEST_ASSERT(osal_host_sem_live() == live + 2u);
+
+    /* 2、沿用前残留的信号被清掉：重建后立即超时，而不是被旧信号唤醒 */
+    uint8_t buf[8];
+    uint32_t n = sizeof(buf);
+    TEST_ASSERT(OSAL_sem_give(s_rb.rd_waiter) == RET_OK);
+    static_alloc_reset();
+    TEST_ASSERT(CreateRingBufferEx(&s_rb, "wait", 64u, RB_FLAG_WAIT) == RET_OK);
+    TEST_ASSERT(OSAL_sem_take(s_rb.rd_waiter, 0) == RET_E_TIMEOUT);
+
+    /* 3、不带 RB_FLAG_WAIT 重建：释放，阻塞接口不可用 */
+    static_alloc_reset();
+    TEST_ASSERT(CreateRingBufferStatic(&s_rb, "wait", buf, sizeof(buf), RB_FLAG_SPSC) == RET_OK);
+    TEST_ASSERT(s_rb.rd_waiter == NULL && s_rb.wr_waiter == NULL);
+    TEST_ASSERT(osal_host_sem_live() == live);
+    TEST_ASSERT(RingBuffer_ReadWait(&s_rb, buf, &n, 1u, 0) == RET_E_UNSUPPORTED);
+
+    /* 4、第二个信号量创建失败：第一个也释放 */
+    osal_host_sem_fail_at(2u);
+    static_alloc_reset();
+    TEST_ASSERT(CreateRingBufferEx(&s_rb, "wait", 64u, RB_FLAG_WAIT) == RET_E_NO_MEM);
+    osal_host_sem_fail_at(0);
+    TEST_ASSERT(s_rb.rd_waiter == NULL && s_rb.wr_waiter == NULL);
+    TEST_ASSERT(osal_host_sem_live() == live);
+
+    /* 5、存储区分配失败（句柄清零）前释放已有的信号量 */
+    static_alloc_reset();
+    TEST_ASSERT(CreateRingBufferEx(&s_rb, "wait", 64u, RB_FLAG_WAIT) == RET_OK);
+    TEST_ASSERT(osal_host_sem_live() == live + 2u);
+    TEST_ASSERT(CreateRingBufferEx(&s_rb, "wait", 0x7FFFFFFFu, RB_FLAG_WAIT) == RET_E_NO_MEM);
+    TEST_ASSERT(osal_host_sem_live() == live);
+    printf("wait semaphore lifetime OK\n");
+    return 0;
+}
+
+static void *wait_writer(void *arg) {
+    (void)arg;
+    const uint8_t data[4] = {1u, 2u, 3u, 4u};
+    usleep(20000);
+    uint32_t n = sizeof(data);
+    TEST_EXPECT(WriteRingBuffer(&s_rb, data, &n, 0) == RET_OK);
+    return NULL;
+}
+
+static void *wait_reader(void *arg) {
+    (void)arg;
+    uint8_t buf[8];
+    usleep(20000);
+    uint32_t n = sizeof(buf);
+    TEST_EXPECT(ReadRingBuffer(&s_rb, buf, &n, 0) == RET_OK && n == sizeof(buf));
+    return NULL;
+}
+
+/**
+ * @brief 阻塞读写：超时与唤醒（size = 8）
+ * @return 0 成功
+ */
+static int wait_wakeup(void) {
+    uint8_t buf[8] = {0};
+    uint32_t n     = sizeof(buf);
+    pthread_t peer;
+
+    static_alloc_reset();
+    TEST_ASSERT(CreateRingBufferEx(&s_rb, "wait", sizeof(buf), RB_FLAG_WAIT) == RET_OK);
+
+    /* 1、空缓冲区读超时，不读出任何字节 */
+    TEST_ASSERT(RingBuffer_ReadWait(&s_rb, buf, &n, 1u, 10u) == RET_E_TIMEOUT && n == 0);
+
+    /* 2、另一线程写入 4 字节后唤醒 */
+    TEST_ASSERT(pthread_create(&peer, NULL, wait_writer, NULL) == 0);
+    n = sizeof(buf);
+    TEST_ASSERT(RingBuffer_ReadWait(&s_rb, buf, &n, 4u, 2000u) == RET_OK && n == 4u);
+    TEST_ASSERT(buf[0] == 1u && buf[3] == 4u);
+    pthread_join(peer, NULL);
+
+    /* 3、写满后再写超时；另一线程读空后唤醒 */
+    n = sizeof(buf);
+    TEST_ASSERT(WriteRingBuffer(&s_rb, buf, &n, 0) == RET_OK);
+    n = 1u;
+    TEST_ASSERT(RingBuffer_WriteWait(&s_rb, buf, &n, 10u) == RET_E_TIMEOUT);
+    TEST_ASSERT(pthread_create(&peer, NULL, wait_reader, NULL) == 0);
+    n = sizeof(buf);
+    TEST_ASSERT(RingBuffer_WriteWait(&s_rb, buf, &n, 2000u) == RET_OK && n == sizeof(buf));
+    pthread_join(peer, NULL);
+    TEST_ASSERT(RingBuffer_GetUsedSize(&s_rb) == sizeof(buf));
+    printf("wait wakeup OK\n");
+    return 0;
+}
+
+int main(void) {
+    wait_lifetime();
+    wait_wakeup();
+    return TEST_RESULT();
+}
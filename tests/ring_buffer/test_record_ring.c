@@ -0,0 +1,206 @@
+/*
+ * RecordRing 测试
+ * - 固定步骤：分次追加/提交/放弃、Peek、整条读出（含接收区不足）、跳过、跨越末尾的零拷贝访问
+ * - 覆盖模式：写满时按整条记录挤掉最旧记录，剩下的记录连续、完整，计数与写入总数对得上
+ * - 并发：一个生产者线程分多次 Append 组装变长记录，一个消费者线程整条读出；
+ *   挂起记录在 Commit 前不可见，读到的每条记录长度与内容都必须完整
+ */
+#include <pthread.h>
+#include <string.h>
+
+#include "MemoryAllocation.h"
+#include "RecordRing.h"
+#include "test_host.h"
+
+#define RR_TEST_RECORDS  200000u
+#define RR_TEST_PAYLOAD  90u  // 负载最大长度
+#define RR_TEST_PIECES   3u   // 生产者每条记录最多分几次 Append
+
+static RecordRing s_rr;
+
+/* 第 seq 条记录的负载长度与内容起点 */
+static inline uint32_t rr_len(const uint32_t seq) { return seq % (RR_TEST_PAYLOAD + 1u); }
+static inline uint32_t rr_start(const uint32_t seq) { return seq * 977u; }
+
+/**
+ * @brief 固定步骤（size = 32，记录头 2 字节）
+ * @return 0 成功
+ */
+static int rr_steps(void) {
+    uint8_t src[32];
+    uint8_t dst[32];
+    uint32_t len = 0;
+
+    static_alloc_reset();
+    TEST_ASSERT(CreateRecordRing(&s_rr, "rr", RR_HDR_SIZE) == RET_E_INVALID_ARG);
+    TEST_ASSERT(CreateRecordRing(&s_rr, "rr", 32u) == RET_OK);
+    TEST_ASSERT(RecordRing_Peek(&s_rr, &len) == RET_E_DATA_NOT_ENOUGH);
+
+    /* 1、分三次追加：提交前消费者看不到 */
+    test_pattern_fill(src, 0, 12u);
+    TEST_ASSERT(RecordRing_Append(&s_rr, src, 5u) == RET_OK);
+    TEST_ASSERT(RecordRing_Append(&s_rr, src + 5, 4u) == RET_OK);
+    TEST_ASSERT(RecordRing_Append(&s_rr, src + 9, 3u) == RET_OK);
+    TEST_ASSERT(RecordRing_GetUsedSize(&s_rr) == 0);
+    TEST_ASSERT(RecordRing_Write(&s_rr, src, 1u) == RET_E_BUSY);
+    TEST_ASSERT(RecordRing_Commit(&s_rr) == RET_OK);
+    TEST_ASSERT(RecordRing_GetUsedSize(&s_rr) == RR_HDR_SIZE + 12u);
+    TEST_ASSERT(RecordRing_Peek(&s_rr, &len) == RET_OK && len == 12u);
+
+    /* 2、放弃的挂起记录不占空间；0 长度记录也是一条记录 */
+    TEST_ASSERT(RecordRing_Append(&s_rr, src, 8u) == RET_OK);
+    RecordRing_Abort(&s_rr);
+    TEST_ASSERT(RecordRing_Commit(&s_rr) == RET_OK);
+    TEST_ASSERT(RecordRing_GetUsedSize(&s_rr) == RR_HDR_SIZE * 2u + 12u);
+
+    /* 3、写不下时整体失败，挂起记录不变 */
+    TEST_ASSERT(RecordRing_Append(&s_rr, src, 32u) == RET_E_NO_MEM);
+    TEST_ASSERT(RecordRing_Write(&s_rr, src, 17u) == RET_E_NO_MEM);
+
+    /* 4、整条读出；接收区不足时截断拷贝但整条消费 */
+    TEST_ASSERT(RecordRing_Read(&s_rr, dst, 5u, &len) == RET_E_DATA_OVERFLOW && len == 12u);
+    TEST_ASSERT(test_pattern_check(dst, 0, 5u));
+    TEST_ASSERT(RecordRing_Read(&s_rr, dst, sizeof(dst), &len) == RET_OK && len == 0);
+    TEST_ASSERT(RecordRing_Read(&s_rr, dst, sizeof(dst), &len) == RET_E_DATA_NOT_ENOUGH);
+
+    /* 5、front/rear 停在 16：下一条 2+20 字节跨越末尾，零拷贝窗口分两段 */
+    test_pattern_fill(src, 100u, 20u);
+    TEST_ASSERT(RecordRing_Write(&s_rr, src, 20u) == RET_OK);
+    RingBufferSpan span;
+    TEST_ASSERT(RecordRing_ReadReserve(&s_rr, &span) == RET_OK);
+    TEST_ASSERT(span.n1 + span.n2 == 20u && span.n2 > 0);
+    TEST_ASSERT(test_pattern_check(span.p1, 100u, span.n1));
+    TEST_ASSERT(test_pattern_check(span.p2, 100u + span.n1, span.n2));
+    TEST_ASSERT(RecordRing_Skip(&s_rr) == RET_OK);
+    TEST_ASSERT(RecordRing_GetUsedSize(&s_rr) == 0);
+    TEST_ASSERT(RecordRing_Skip(&s_rr) == RET_E_DATA_NOT_ENOUGH);
+    printf("record ring steps OK\n");
+    return 0;
+}
+
+/**
+ * @brief 覆盖模式（size = 64）：变长记录持续写入，读出的必须是最新的若干条完整记录
+ * @return 0 成功
+ */
+static int rr_overwrite(void) {
+    uint8_t src[64];
+    uint8_t dst[64];
+    uint32_t len     = 0;
+    uint32_t records = 0;
+    uint32_t bytes   = 0;
+
+    static_alloc_reset();
+    TEST_ASSERT(CreateRecordRingEx(&s_rr, "rr-ow", 64u, RB_FLAG_OVERWRITE | RB_FLAG_SPSC) ==
+                RET_E_INVALID_ARG);
+    TEST_ASSERT(CreateRecordRingEx(&s_rr, "rr-ow", 64u, RB_FLAG_OVERWRITE) == RET_OK);
+
+    /* 1、写入 1000 条 0~20 字节的记录，写入永不失败 */
+    const uint32_t total = 1000u;
+    uint32_t written     = 0;
+    for (uint32_t seq = 0; seq < total; seq++) {
+        const uint32_t n = seq % 21u;
+        test_pattern_fill(src, rr_start(seq), n);
+        TEST_ASSERT(RecordRing_Write(&s_rr, src, n) == RET_OK);
+        written += RR_HDR_SIZE + n;
+    }
+    RecordRing_GetEvicted(&s_rr, &records, &bytes);
+    TEST_ASSERT(bytes + RecordRing_GetUsedSize(&s_rr) == written);
+
+    /* 2、剩下的是 [total - kept, total) 连续的完整记录 */
+    const uint32_t kept = total - records;
+    TEST_ASSERT(kept > 0);
+    for (uint32_t seq = total - kept; seq < total; seq++) {
+        TEST_ASSERT(RecordRing_Read(&s_rr, dst, sizeof(dst), &len) == RET_OK);
+        TEST_ASSERT(len == seq % 21u);
+        TEST_ASSERT(test_pattern_check(dst, rr_start(seq), len));
+    }
+    TEST_ASSERT(RecordRing_Read(&s_rr, dst, sizeof(dst), &len) == RET_E_DATA_NOT_ENOUGH);
+
+    /* 3、分次追加时也按整条挤掉：3 条 2+20 中第 3 条已挤掉第 1 条，再追加 30 字节又挤掉 1 条 */
+    for (uint32_t seq = 0; seq < 3u; seq++) {
+        test_pattern_fill(src, seq, 20u);
+        TEST_ASSERT(RecordRing_Write(&s_rr, src, 20u) == RET_OK);
+    }
+    test_pattern_fill(src, 500u, 30u);
+    TEST_ASSERT(RecordRing_Append(&s_rr, src, 10u) == RET_OK);
+    TEST_ASSERT(RecordRing_Append(&s_rr, src + 10, 20u) == RET_OK);
+    TEST_ASSERT(RecordRing_Commit(&s_rr) == RET_OK);
+    TEST_ASSERT(RecordRing_Read(&s_rr, dst, sizeof(dst), &len) == RET_OK && len == 20u);
+    TEST_ASSERT(test_pattern_check(dst, 2u, len));
+    TEST_ASSERT(RecordRing_Read(&s_rr, dst, sizeof(dst), &len) == RET_OK && len == 30u);
+    TEST_ASSERT(test_pattern_check(dst, 500u, len));
+
+    /* 4、整个环都装不下的记录直接失败，不挤掉已有记录 */
+    TEST_ASSERT(RecordRing_Write(&s_rr, src, 20u) == RET_OK);
+    RecordRing_GetEvicted(&s_rr, &records, NULL);
+    TEST_ASSERT(RecordRing_Write(&s_rr, src, 63u) == RET_E_NO_MEM);
+    RecordRing_Abort(&s_rr);
+    RecordRing_GetEvicted(&s_rr, &bytes, NULL);
+    TEST_ASSERT(bytes == records);
+    TEST_ASSERT(RecordRing_Peek(&s_rr, &len) == RET_OK && len == 20u);
+    printf("record ring overwrite OK\n");
+    return 0;
+}
+
+/**
+ * @brief 生产者：每条记录分 1~RR_TEST_PIECES 次追加，写不下则重试当前片段
+ */
+static void *rr_producer(void *arg) {
+    (void)arg;
+    uint8_t payload[RR_TEST_PAYLOAD];
+
+    for (uint32_t seq = 0; seq < RR_TEST_RECORDS && !test_failed(); seq++) {
+        const uint32_t len    = rr_len(seq);
+        const uint32_t pieces = 1u + seq % RR_TEST_PIECES;
+        test_pattern_fill(payload, rr_start(seq), len);
+
+        uint32_t off = 0;
+        for (uint32_t p = 0; p < pieces && !test_failed(); p++) {
+            const uint32_t n = (p + 1u == pieces) ? len - off : len / pieces;
+            while (RecordRing_Append(&s_rr, payload + off, n) != RET_OK && !test_failed()) {
+                sched_yield();
+            }
+            off += n;
+        }
+        while (RecordRing_Commit(&s_rr) != RET_OK && !test_failed()) sched_yield();
+    }
+    return NULL;
+}
+
+/**
+ * @brief 并发收发（size 取 2 的幂与非 2 的幂各一）
+ * @param size 底层缓冲区大小
+ * @return 0 成功
+ */
+static int rr_stress(const uint32_t size) {
+    static_alloc_reset();
+    TEST_ASSERT(CreateRecordRing(&s_rr, "rr", size) == RET_OK);
+
+    pthread_t producer;
+    TEST_ASSERT(pthread_create(&producer, NULL, rr_producer, NULL) == 0);
+    uint8_t buf[RR_TEST_PAYLOAD];
+    for (uint32_t seq = 0; seq < RR_TEST_RECORDS && !test_failed();) {
+        uint32_t len        = 0;
+        const ret_code_t rc = RecordRing_Read(&s_rr, buf, sizeof(buf), &len);
+        if (rc == RET_E_DATA_NOT_ENOUGH) {
+            sched_yield();
+            continue;
+        }
+        TEST_EXPECT(rc == RET_OK);
+        TEST_EXPECT(len == rr_len(seq));
+        TEST_EXPECT(test_pattern_check(buf, rr_start(seq), len));
+        seq++;
+    }
+    pthread_join(producer, NULL);
+    TEST_ASSERT(RecordRing_GetUsedSize(&s_rr) == 0);
+    printf("record ring size %4u: %u 条记录 OK\n", size, RR_TEST_RECORDS);
+    return 0;
+}
+
+int main(void) {
+    rr_steps();
+    rr_overwrite();
+    rr_stress(256u);
+    rr_stress(200u);
+    return TEST_RESULT();
+}